@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <stdlib.h>
+
+#include <rtl/algorithm.hpp>
+
+#include "bench.hpp"
+
+// Compares copy_n and fill_n, which copy and fill the ranges of trivially copyable types in bulk,
+// with the element loops they used before, on byte, int and float ranges from the size of L1 to
+// the size that doesn't fit any cache. The ints are filled with zero, which is a memset, and the
+// floats with a value of different bytes, which is spread by memcpy.
+namespace
+{
+// NOTE: The library is built for size, where the loops are neither vectorized nor replaced by
+// the calls of memcpy and memset, so the benchmark keeps them as they are too
+#define RTL_BENCH_PLAIN_LOOP                                                                       \
+    __attribute__( ( noinline,                                                                     \
+                     optimize( "no-tree-vectorize", "no-tree-loop-distribute-patterns" ) ) )
+
+    template<typename T>
+    RTL_BENCH_PLAIN_LOOP T* loop_copy_n( const T* src, rtl::size_t count, T* dst )
+    {
+        for ( rtl::size_t i = 0; i < count; ++i )
+            *dst++ = *src++;
+
+        return dst;
+    }
+
+    template<typename T>
+    RTL_BENCH_PLAIN_LOOP T* loop_fill_n( T* first, rtl::size_t count, const T& value )
+    {
+        for ( rtl::size_t i = 0; i < count; ++i )
+            *first++ = value;
+
+        return first;
+    }
+
+#undef RTL_BENCH_PLAIN_LOOP
+
+    // NOTE: Every size is copied and filled this many bytes over in a run
+    constexpr rtl::size_t bytes_per_run = 64 << 20;
+
+    bool g_failed = false;
+
+    // NOTE: In gigabytes per second
+    struct result
+    {
+        double copy;
+        double loop_copy;
+        double fill;
+        double loop_fill;
+    };
+
+    template<typename Function>
+    [[nodiscard]] double throughput( Function&& fn )
+    {
+        return 1 / bench::measure( bytes_per_run, fn );
+    }
+
+    template<typename T>
+    [[nodiscard]] result run( rtl::size_t bytes, T value )
+    {
+        const rtl::size_t count = bytes / sizeof( T );
+        const rtl::size_t repeats = bytes_per_run / bytes;
+
+        T* src = static_cast<T*>( malloc( bytes ) );
+        T* dst = static_cast<T*>( malloc( bytes ) );
+
+        for ( rtl::size_t i = 0; i < count; ++i )
+            src[i] = static_cast<T>( i );
+
+        result speed;
+
+        speed.copy = throughput(
+            [&]()
+            {
+                for ( rtl::size_t r = 0; r < repeats; ++r )
+                    rtl::copy_n( src, count, dst );
+            } );
+
+        g_failed |= dst[count - 1] != src[count - 1];
+
+        speed.loop_copy = throughput(
+            [&]()
+            {
+                for ( rtl::size_t r = 0; r < repeats; ++r )
+                    loop_copy_n( src, count, dst );
+            } );
+
+        speed.fill = throughput(
+            [&]()
+            {
+                for ( rtl::size_t r = 0; r < repeats; ++r )
+                    rtl::fill_n( dst, count, value );
+            } );
+
+        g_failed |= dst[0] != value || dst[count - 1] != value;
+
+        speed.loop_fill = throughput(
+            [&]()
+            {
+                for ( rtl::size_t r = 0; r < repeats; ++r )
+                    loop_fill_n( dst, count, value );
+            } );
+
+        free( src );
+        free( dst );
+
+        return speed;
+    }
+
+    template<typename T>
+    void print( const char* name, T value )
+    {
+        constexpr rtl::size_t sizes[] = { 16 << 10, 1 << 20, 32 << 20 };
+
+        for ( rtl::size_t size : sizes )
+        {
+            const result speed = run( size, value );
+
+            printf( "%-8s %8zu %10.2f %10.2f %10.2f %10.2f\n",
+                    name,
+                    size >> 10,
+                    speed.copy,
+                    speed.loop_copy,
+                    speed.fill,
+                    speed.loop_fill );
+        }
+    }
+} // namespace
+
+int main()
+{
+    printf( "%-8s %8s %10s %10s %10s %10s\n", "GB/s", "KB", "copy_n", "loop", "fill_n", "loop" );
+
+    print<rtl::uint8_t>( "byte", 0x5A );
+    print<int>( "int", 0 );
+    print<float>( "float", 0.5f );
+
+    if ( g_failed )
+        printf( "FAILED: the ranges are copied or filled wrong\n" );
+
+    return g_failed;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <pthread.h>
+
+#include <rtl/atomic.hpp>
+
+#include "bench.hpp"
+
+// Hammers the same variables with every kind of the read-modify-write operations from several
+// threads and measures the cost of a round of them. A lost update shows in the totals, a torn
+// 64-bit access in the halves of \wide, which are always equal. Exits with a non-zero code if
+// any check fails, so it runs as a test too.
+namespace
+{
+    constexpr int iterations = 200000;
+
+    struct contention
+    {
+        rtl::atomic<int>           counter;
+        rtl::atomic<int>           cas_counter;
+        rtl::atomic<rtl::uint64_t> wide;
+        rtl::atomic<int>           lock;
+        rtl::atomic<int>           torn;
+        int                        guarded{ 0 };
+
+        static void* proc( void* context )
+        {
+            contention& self = *static_cast<contention*>( context );
+
+            for ( int i = 0; i < iterations; ++i )
+            {
+                self.counter.fetch_add( 1, rtl::memory_order_relaxed );
+
+                int expected = self.cas_counter.load( rtl::memory_order_relaxed );
+                while ( !self.cas_counter.compare_exchange_weak( expected, expected + 1 ) )
+                {
+                }
+
+                self.wide.fetch_add( 0x100000001ull );
+
+                const rtl::uint64_t seen = self.wide.load( rtl::memory_order_acquire );
+                if ( ( seen >> 32 ) != ( seen & 0xffffffffu ) )
+                    self.torn.fetch_add( 1, rtl::memory_order_relaxed );
+
+                // NOTE: The plain counter is only consistent if the acquire and the release of
+                // the lock order the accesses
+                while ( self.lock.exchange( 1, rtl::memory_order_acquire ) != 0 )
+                    rtl::cpu_relax();
+
+                ++self.guarded;
+                self.lock.store( 0, rtl::memory_order_release );
+            }
+
+            return nullptr;
+        }
+    };
+
+    constexpr int max_threads = 8;
+
+    // NOTE: Returns the number of the failed checks
+    int run( int thread_count, double& ns_per_round )
+    {
+        contention shared;
+        pthread_t  threads[max_threads];
+
+        const double start = bench::now_seconds();
+
+        for ( int i = 0; i < thread_count; ++i )
+            pthread_create( &threads[i], nullptr, &contention::proc, &shared );
+
+        for ( int i = 0; i < thread_count; ++i )
+            pthread_join( threads[i], nullptr );
+
+        const int total = thread_count * iterations;
+
+        ns_per_round = ( bench::now_seconds() - start ) * 1e9 / total;
+
+        int failures = 0;
+
+        failures += shared.counter != total;
+        failures += shared.cas_counter != total;
+        failures += shared.wide != 0x100000001ull * static_cast<rtl::uint64_t>( total );
+        failures += shared.torn != 0;
+        failures += shared.guarded != total;
+
+        return failures;
+    }
+} // namespace
+
+int main()
+{
+    printf( "%-8s %14s %8s\n", "threads", "ns per round", "failed" );
+
+    int failures = 0;
+
+    for ( int thread_count = 1; thread_count <= max_threads; thread_count *= 2 )
+    {
+        double    ns_per_round = 0;
+        const int failed = run( thread_count, ns_per_round );
+
+        printf( "%-8d %14.1f %8d\n", thread_count, ns_per_round, failed );
+        failures += failed;
+    }
+
+    return failures != 0;
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <stdio.h>
+#include <time.h>
+
+#include <rtl/int.hpp>
+
+namespace bench
+{
+    [[nodiscard]] inline double now_seconds()
+    {
+        timespec ts;
+        clock_gettime( CLOCK_MONOTONIC, &ts );
+        return static_cast<double>( ts.tv_sec ) + static_cast<double>( ts.tv_nsec ) * 1e-9;
+    }
+
+    // Xorshift generator, so the workloads are the same for every allocator
+    class random final
+    {
+    public:
+        [[nodiscard]] rtl::uint32_t next()
+        {
+            m_state ^= m_state << 13;
+            m_state ^= m_state >> 17;
+            m_state ^= m_state << 5;
+            return m_state;
+        }
+
+    private:
+        rtl::uint32_t m_state{ 0x9e3779b9u };
+    };
+
+    // Best of several runs of \fn, in nanoseconds per one of \operations
+    template<typename Function>
+    [[nodiscard]] double measure( rtl::size_t operations, Function&& fn )
+    {
+        constexpr int runs = 5;
+
+        double best = 0;
+
+        for ( int run = 0; run < runs; ++run )
+        {
+            const double start = now_seconds();
+            fn();
+            const double elapsed = now_seconds() - start;
+
+            if ( run == 0 || elapsed < best )
+                best = elapsed;
+        }
+
+        return best * 1e9 / static_cast<double>( operations );
+    }
+} // namespace bench
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <rtl/flat_hash_map.hpp>
+#include <rtl/string.hpp>
+
+#include "bench.hpp"
+
+// Compares flat_hash_map with std::unordered_map on the inserts into an empty map, on the
+// lookups of the present keys and on the lookups of the absent ones. Integer keys go from the
+// sizes that fit L1 to the ones that don't fit any cache, string keys are the names of resources.
+namespace
+{
+    // NOTE: The lookups add up the values, so the compiler can't drop them
+    volatile rtl::size_t g_sink;
+
+    struct result
+    {
+        double insert;
+        double hit;
+        double miss;
+    };
+
+    template<typename Map, typename Key, typename Lookup>
+    [[nodiscard]] result run( const std::vector<Key>&    keys,
+                              const std::vector<Lookup>& hits,
+                              const std::vector<Lookup>& misses )
+    {
+        result times;
+
+        times.insert = bench::measure( keys.size(),
+                                       [&]()
+                                       {
+                                           Map map;
+
+                                           for ( rtl::size_t i = 0; i < keys.size(); ++i )
+                                               map[keys[i]] = i;
+
+                                           g_sink = map.size();
+                                       } );
+
+        Map map;
+        for ( rtl::size_t i = 0; i < keys.size(); ++i )
+            map[keys[i]] = i;
+
+        times.hit = bench::measure( hits.size(),
+                                    [&]()
+                                    {
+                                        rtl::size_t sum = 0;
+
+                                        for ( const Lookup& key : hits )
+                                            sum += map.find( key )->second;
+
+                                        g_sink = sum;
+                                    } );
+
+        times.miss = bench::measure( misses.size(),
+                                     [&]()
+                                     {
+                                         rtl::size_t found = 0;
+
+                                         for ( const Lookup& key : misses )
+                                             found += map.find( key ) != map.end();
+
+                                         g_sink = found;
+                                     } );
+
+        return times;
+    }
+
+    void print( const char* name, const result& flat, const result& std )
+    {
+        printf( "%-20s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                name,
+                flat.insert,
+                std.insert,
+                flat.hit,
+                std.hit,
+                flat.miss,
+                std.miss );
+    }
+
+    // NOTE: The hits are the keys in a shuffled order, the misses are other random keys
+    void integer_keys( rtl::size_t count )
+    {
+        bench::random rng;
+
+        std::vector<rtl::uint64_t> keys( count );
+        for ( rtl::uint64_t& key : keys )
+            key = ( static_cast<rtl::uint64_t>( rng.next() ) << 32 | rng.next() ) | 1;
+
+        std::vector<rtl::uint64_t> hits = keys;
+        for ( rtl::size_t i = count - 1; i > 0; --i )
+            rtl::swap( hits[i], hits[rng.next() % ( i + 1 )] );
+
+        std::vector<rtl::uint64_t> misses( count );
+        for ( rtl::uint64_t& key : misses )
+            key = static_cast<rtl::uint64_t>( rng.next() ) << 32 | ( rng.next() & ~1u );
+
+        char name[32];
+        snprintf( name, sizeof( name ), "u64 x %zu", count );
+
+        print( name,
+               run<rtl::flat_hash_map<rtl::uint64_t, rtl::size_t>>( keys, hits, misses ),
+               run<std::unordered_map<rtl::uint64_t, rtl::size_t>>( keys, hits, misses ) );
+    }
+
+    // NOTE: The flat map looks the strings up by views, the standard one by strings, as the
+    // heterogeneous lookup of std::unordered_map needs C++20. The hits are shuffled as well, the
+    // nodes of the standard map are allocated in the order of the keys.
+    void string_keys( rtl::size_t count )
+    {
+        bench::random rng;
+
+        std::vector<std::string> names( count );
+        std::vector<std::string> absent( count );
+
+        for ( rtl::size_t i = 0; i < count; ++i )
+        {
+            char name[64];
+
+            snprintf( name, sizeof( name ), "textures/level%zu/diffuse_%zu.png", i % 16, i );
+            names[i] = name;
+
+            snprintf( name, sizeof( name ), "textures/level%zu/normal_%zu.png", i % 16, i );
+            absent[i] = name;
+        }
+
+        std::vector<std::string> std_hits = names;
+        for ( rtl::size_t i = count - 1; i > 0; --i )
+            std::swap( std_hits[i], std_hits[rng.next() % ( i + 1 )] );
+
+        std::vector<rtl::string>      keys;
+        std::vector<rtl::string_view> hits;
+        std::vector<rtl::string_view> misses;
+
+        for ( rtl::size_t i = 0; i < count; ++i )
+        {
+            keys.emplace_back( rtl::string_view( names[i].data(), names[i].size() ) );
+            hits.emplace_back( std_hits[i].data(), std_hits[i].size() );
+            misses.emplace_back( absent[i].data(), absent[i].size() );
+        }
+
+        char name[32];
+        snprintf( name, sizeof( name ), "string x %zu", count );
+
+        print( name,
+               run<rtl::flat_hash_map<rtl::string, rtl::size_t>>( keys, hits, misses ),
+               run<std::unordered_map<std::string, rtl::size_t>>( names, std_hits, absent ) );
+    }
+} // namespace
+
+int main()
+{
+    printf( "%-20s %10s %10s %10s %10s %10s %10s\n",
+            "keys, ns per op",
+            "insert",
+            "std",
+            "hit",
+            "std",
+            "miss",
+            "std" );
+
+    constexpr rtl::size_t sizes[] = { 1024, 65536, 1048576 };
+
+    for ( rtl::size_t size : sizes )
+        integer_keys( size );
+
+    string_keys( 65536 );
+
+    return 0;
+}
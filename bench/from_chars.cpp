@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include <charconv>
+#include <vector>
+
+#include <rtl/charconv.hpp>
+
+#include "bench.hpp"
+
+// Compares from_chars with strtoll and strtod of the C library and with std::from_chars on 10 MB
+// of numbers, one per line, as a level or a config file is loaded: integers, decimals with six
+// digits of the fraction, doubles with all the 17 digits and fixed point coordinates. The values
+// parsed by the library are checked against the C library.
+namespace
+{
+    constexpr rtl::size_t text_size = 10 << 20;
+
+    using fixed = rtl::fix<int, 16>;
+
+    // NOTE: The values are summed up, so the compiler can't drop the parsing
+    volatile double g_sink;
+
+    bool g_failed = false;
+
+    // NOTE: The C library needs the null character after the text, it is not parsed
+    template<typename Function>
+    [[nodiscard]] std::vector<char> make_text( Function&& print )
+    {
+        std::vector<char> text;
+        bench::random     rng;
+
+        while ( text.size() < text_size )
+        {
+            char      line[64];
+            const int length = print( line, rng );
+
+            text.insert( text.end(), line, line + length );
+        }
+
+        text.push_back( 0 );
+        return text;
+    }
+
+    [[nodiscard]] double to_double( long long value )
+    {
+        return static_cast<double>( value );
+    }
+
+    [[nodiscard]] double to_double( double value )
+    {
+        return value;
+    }
+
+    [[nodiscard]] double to_double( fixed value )
+    {
+        return static_cast<float>( value );
+    }
+
+    // NOTE: \parse takes the line and its end and returns the end of the number, the newline is
+    // skipped after it
+    template<typename T, typename Parse>
+    [[nodiscard]] double run( const std::vector<char>& text, Parse&& parse )
+    {
+        const double ns_per_byte = bench::measure(
+            text.size(),
+            [&]()
+            {
+                const char* end = text.data() + text.size() - 1;
+                double      sum = 0;
+
+                for ( const char* ptr = text.data(); ptr < end; )
+                {
+                    T value{};
+                    ptr = parse( ptr, end, value ) + 1;
+                    sum += to_double( value );
+                }
+
+                g_sink = sum;
+            } );
+
+        return 1e3 / ns_per_byte;
+    }
+
+    template<typename T, typename Reference>
+    void check( const std::vector<char>& text, Reference&& reference )
+    {
+        const char* end = text.data() + text.size() - 1;
+
+        for ( const char* ptr = text.data(); ptr < end; )
+        {
+            T          value{};
+            const auto result = rtl::from_chars( ptr, end, value );
+
+            char*   reference_end = nullptr;
+            const T expected = reference( ptr, &reference_end );
+
+            if ( result.ec != rtl::errc::ok || result.ptr != reference_end || value != expected )
+            {
+                printf( "%.*s is parsed wrong\n", static_cast<int>( reference_end - ptr ), ptr );
+
+                g_failed = true;
+                return;
+            }
+
+            ptr = result.ptr + 1;
+        }
+    }
+
+    void print( const char* name, double rtl, double libc, double std )
+    {
+        printf( "%-20s %10.0f %10.0f %10.0f\n", name, rtl, libc, std );
+    }
+} // namespace
+
+int main()
+{
+    printf( "%-20s %10s %10s %10s\n", "MB/s", "rtl", "strto*", "std" );
+
+    {
+        std::vector<char> text = make_text(
+            []( char* line, bench::random& rng )
+            {
+                const long long value = static_cast<int>( rng.next() ) >> ( rng.next() % 32 );
+                return snprintf( line, 64, "%lld\n", value );
+            } );
+
+        check<long long>( text,
+                          []( const char* ptr, char** end ) { return strtoll( ptr, end, 10 ); } );
+
+        print( "integers",
+               run<long long>( text,
+                               []( const char* ptr, const char* end, long long& value )
+                               { return rtl::from_chars( ptr, end, value ).ptr; } ),
+               run<long long>( text,
+                               []( const char* ptr, const char*, long long& value )
+                               {
+                                   char* end = nullptr;
+                                   value = strtoll( ptr, &end, 10 );
+                                   return end;
+                               } ),
+               run<long long>( text,
+                               []( const char* ptr, const char* end, long long& value )
+                               { return std::from_chars( ptr, end, value ).ptr; } ) );
+    }
+
+    const auto rtl_double = []( const char* ptr, const char* end, double& value )
+    { return rtl::from_chars( ptr, end, value ).ptr; };
+
+    const auto libc_double = []( const char* ptr, const char*, double& value )
+    {
+        char* end = nullptr;
+        value = strtod( ptr, &end );
+        return end;
+    };
+
+    const auto std_double = []( const char* ptr, const char* end, double& value )
+    { return std::from_chars( ptr, end, value ).ptr; };
+
+    const auto reference_double = []( const char* ptr, char** end ) { return strtod( ptr, end ); };
+
+    {
+        std::vector<char> text = make_text(
+            []( char* line, bench::random& rng )
+            {
+                const double value = static_cast<double>( static_cast<int>( rng.next() ) ) / 1e6;
+                return snprintf( line, 64, "%.6f\n", value );
+            } );
+
+        check<double>( text, reference_double );
+
+        print( "decimals, %.6f",
+               run<double>( text, rtl_double ),
+               run<double>( text, libc_double ),
+               run<double>( text, std_double ) );
+    }
+
+    {
+        // NOTE: Random bit patterns, without the infinities and the NaNs
+        std::vector<char> text = make_text(
+            []( char* line, bench::random& rng )
+            {
+                rtl::uint64_t bits = 0;
+                double        value = 0;
+
+                do
+                {
+                    bits = static_cast<rtl::uint64_t>( rng.next() ) << 32 | rng.next();
+                    memcpy( &value, &bits, sizeof( value ) );
+                } while ( ( bits >> 52 & 0x7FF ) == 0x7FF );
+
+                return snprintf( line, 64, "%.17g\n", value );
+            } );
+
+        check<double>( text, reference_double );
+
+        print( "doubles, %.17g",
+               run<double>( text, rtl_double ),
+               run<double>( text, libc_double ),
+               run<double>( text, std_double ) );
+    }
+
+    {
+        // NOTE: Without the library the fixed point numbers are parsed as doubles and converted.
+        // There is nothing to compare the values with, only the errors are checked.
+        std::vector<char> text = make_text(
+            []( char* line, bench::random& rng )
+            {
+                const double value = static_cast<double>( static_cast<int>( rng.next() ) ) / 1e5;
+                return snprintf( line, 64, "%.4f\n", value );
+            } );
+
+        const char* end = text.data() + text.size() - 1;
+
+        for ( const char* ptr = text.data(); ptr < end; )
+        {
+            fixed      value{};
+            const auto result = rtl::from_chars( ptr, end, value );
+
+            g_failed |= result.ec != rtl::errc::ok;
+            ptr = result.ptr + 1;
+        }
+
+        print( "fix 16.16, %.4f",
+               run<fixed>( text,
+                           []( const char* ptr, const char* end, fixed& value )
+                           { return rtl::from_chars( ptr, end, value ).ptr; } ),
+               run<fixed>( text,
+                           []( const char* ptr, const char*, fixed& value )
+                           {
+                               char* end = nullptr;
+                               value = fixed( static_cast<float>( strtod( ptr, &end ) ) );
+                               return end;
+                           } ),
+               run<fixed>( text,
+                           []( const char* ptr, const char* end, fixed& value )
+                           {
+                               double parsed = 0;
+                               const char* next = std::from_chars( ptr, end, parsed ).ptr;
+                               value = fixed( static_cast<float>( parsed ) );
+                               return next;
+                           } ) );
+    }
+
+    if ( g_failed )
+        printf( "FAILED: the values differ from the ones of the C library\n" );
+
+    return g_failed;
+}
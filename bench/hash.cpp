@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#define RTL_IMPLEMENTATION
+
+#include <functional>
+#include <string_view>
+
+#include <rtl/hash.hpp>
+#include <rtl/sys/impl/cpu.hpp>
+#include <rtl/sys/impl/hash.hpp>
+
+#include "bench.hpp"
+
+// Measures the throughput of the hashes on the keys of the hash tables and on the buffers of the
+// resources, with std::hash of the C++ library as the reference. CRC32C is measured with the
+// instruction and with the table, whichever the CPU picks at runtime. The results are checked
+// against the known values and against each other.
+namespace
+{
+    using hash_function = rtl::uint64_t ( * )( const char*, rtl::size_t );
+
+    rtl::uint64_t fnv1a( const char* data, rtl::size_t size )
+    {
+        return rtl::fnv1a_64( data, size );
+    }
+
+    rtl::uint64_t wyhash( const char* data, rtl::size_t size )
+    {
+        return rtl::wyhash( data, size );
+    }
+
+    rtl::uint64_t xxhash64( const char* data, rtl::size_t size )
+    {
+        return rtl::xxhash64( data, size );
+    }
+
+    rtl::uint64_t crc32c( const char* data, rtl::size_t size )
+    {
+        return rtl::crc32c( data, size );
+    }
+
+    rtl::uint64_t crc32c_table( const char* data, rtl::size_t size )
+    {
+        return ~rtl::impl::crc::crc32c_software(
+            ~0u, reinterpret_cast<const rtl::uint8_t*>( data ), size );
+    }
+
+    rtl::uint64_t std_hash( const char* data, rtl::size_t size )
+    {
+        return std::hash<std::string_view>()( std::string_view( data, size ) );
+    }
+
+    // NOTE: The functions are called through the volatile pointers, so the compiler can't hoist
+    // the hashing out of the loop
+    struct hash
+    {
+        const char*            name;
+        hash_function volatile function;
+    };
+
+    hash g_hashes[] = {
+        { "fnv1a_64", fnv1a },   { "wyhash", wyhash },          { "xxhash64", xxhash64 },
+        { "crc32c", crc32c },    { "crc32c table", crc32c_table }, { "std::hash", std_hash },
+    };
+
+    constexpr rtl::size_t max_size = 1 << 20;
+    constexpr rtl::size_t bytes_per_run = 64 << 20;
+
+    char g_data[max_size];
+
+    volatile rtl::uint64_t g_sink;
+
+    [[nodiscard]] double throughput( hash_function volatile& function, rtl::size_t size )
+    {
+        const rtl::size_t repeats = bytes_per_run / size;
+
+        const double ns_per_byte = bench::measure( bytes_per_run,
+                                                   [&]()
+                                                   {
+                                                       rtl::uint64_t sum = 0;
+
+                                                       for ( rtl::size_t r = 0; r < repeats; ++r )
+                                                           sum += function( g_data, size );
+
+                                                       g_sink = sum;
+                                                   } );
+
+        return 1 / ns_per_byte;
+    }
+
+    // NOTE: Returns the number of the failed checks
+    [[nodiscard]] int check()
+    {
+        int failures = 0;
+
+        const char digits[] = "123456789";
+
+        failures += rtl::crc32c( digits, 9 ) != 0xE3069283u;
+        failures += crc32c_table( digits, 9 ) != 0xE3069283u;
+        failures += rtl::fnv1a_64( "a", 1 ) != 0xAF63DC4C8601EC8Cull;
+        failures += rtl::xxhash64( "", 0 ) != 0xEF46DB3751D8E999ull;
+
+        // NOTE: The instruction splits the long buffers into streams, the table does not
+        failures += crc32c( g_data, max_size ) != crc32c_table( g_data, max_size );
+
+        // NOTE: The streaming hasher gets the buffer in the pieces of odd sizes
+        rtl::xxhash64_state state;
+        for ( rtl::size_t offset = 0, piece = 1; offset < max_size; offset += piece, piece += 7 )
+            state.update( g_data + offset, rtl::min( piece, max_size - offset ) );
+
+        failures += state.digest() != rtl::xxhash64( g_data, max_size );
+
+        return failures;
+    }
+} // namespace
+
+int main()
+{
+    rtl::impl::g_cpu.init();
+
+    bench::random rng;
+    for ( char& byte : g_data )
+        byte = static_cast<char>( rng.next() );
+
+    const int failures = check();
+
+    constexpr rtl::size_t sizes[] = { 16, 64, 4096, max_size };
+
+    printf( "SSE4.2: %s\n", rtl::impl::g_cpu.sse42() ? "yes" : "no" );
+    printf( "%-14s %10s %10s %10s %10s\n", "GB/s", "16 B", "64 B", "4 KB", "1 MB" );
+
+    for ( hash& entry : g_hashes )
+    {
+        printf( "%-14s", entry.name );
+
+        for ( rtl::size_t size : sizes )
+            printf( " %10.2f", throughput( entry.function, size ) );
+
+        printf( "\n" );
+    }
+
+    if ( failures != 0 )
+        printf( "FAILED: %d of the checks\n", failures );
+
+    return failures != 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#define RTL_IMPLEMENTATION
+
+#include <stdlib.h>
+
+#include <rtl/sys/impl/heap_pools.hpp>
+
+#include "bench.hpp"
+
+// Compares the size-class pools with the C library allocator on the same workloads. The pools
+// fall back to the C library for the large blocks, the way impl::heap does with HeapAlloc.
+namespace
+{
+    rtl::impl::heap_pools g_pools;
+
+    struct pools_allocator
+    {
+        static void* allocate( rtl::size_t size )
+        {
+            void* result = g_pools.allocate( size );
+            return result ? result : ::malloc( size );
+        }
+
+        static void free( void* ptr )
+        {
+            if ( !g_pools.free( ptr ) )
+                ::free( ptr );
+        }
+    };
+
+    struct libc_allocator
+    {
+        static void* allocate( rtl::size_t size )
+        {
+            return ::malloc( size );
+        }
+
+        static void free( void* ptr )
+        {
+            ::free( ptr );
+        }
+    };
+
+    // NOTE: Mostly small sizes, as the objects of a typical frame
+    [[nodiscard]] rtl::size_t random_size( bench::random& rng )
+    {
+        const rtl::uint32_t r = rng.next();
+        return ( r & 7 ) != 0 ? 8 + ( r >> 8 ) % 248 : 256 + ( r >> 8 ) % 3840;
+    }
+
+    // Keeps a window of live blocks and replaces a random one at every step
+    template<typename Allocator>
+    double churn( rtl::size_t steps )
+    {
+        constexpr rtl::size_t window = 4096;
+        static void*          blocks[window];
+
+        return bench::measure( steps,
+                               [&]()
+                               {
+                                   bench::random rng;
+
+                                   for ( void*& block : blocks )
+                                       block = Allocator::allocate( random_size( rng ) );
+
+                                   for ( rtl::size_t i = 0; i < steps; ++i )
+                                   {
+                                       void*& block = blocks[rng.next() % window];
+                                       Allocator::free( block );
+
+                                       block = Allocator::allocate( random_size( rng ) );
+                                       *static_cast<char*>( block ) = 1;
+                                   }
+
+                                   for ( void* block : blocks )
+                                       Allocator::free( block );
+                               } );
+    }
+
+    constexpr rtl::size_t batch_count = 32768;
+
+    // Allocates many blocks of one size, then frees them all, as a container of nodes does
+    template<typename Allocator>
+    double batch( rtl::size_t size )
+    {
+        static void* blocks[batch_count];
+
+        return bench::measure( batch_count,
+                               [&]()
+                               {
+                                   for ( void*& block : blocks )
+                                       block = Allocator::allocate( size );
+
+                                   for ( void* block : blocks )
+                                       Allocator::free( block );
+                               } );
+    }
+} // namespace
+
+int main()
+{
+    g_pools.init();
+
+    printf( "%-24s %12s %12s\n", "workload, ns per op", "pools", "libc" );
+
+    constexpr rtl::size_t steps = 2000000;
+    printf( "%-24s %12.1f %12.1f\n",
+            "churn 8..4096 B",
+            churn<pools_allocator>( steps ),
+            churn<libc_allocator>( steps ) );
+
+    // NOTE: The largest batch takes half of the pools reservation, so nothing falls back
+    constexpr rtl::size_t sizes[] = { 16, 48, 256, 1024 };
+
+    for ( rtl::size_t size : sizes )
+    {
+        char name[32];
+        snprintf( name, sizeof( name ), "batch %zu B", size );
+
+        printf( "%-24s %12.1f %12.1f\n",
+                name,
+                batch<pools_allocator>( size ),
+                batch<libc_allocator>( size ) );
+    }
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#define RTL_IMPLEMENTATION
+
+#include <rtl/sys/impl/jobs.hpp>
+
+#include "bench.hpp"
+
+// Measures how parallel_for scales from one thread to a thread per logical CPU, on a loop of
+// heavy items and on a loop of light ones, where the cost of taking a subrange shows up.
+namespace
+{
+    constexpr rtl::size_t heavy_count = 4096;
+    constexpr rtl::size_t light_count = 1 << 22;
+
+    rtl::uint32_t g_heavy[heavy_count];
+    rtl::uint32_t g_light[light_count];
+
+    // NOTE: The results are summed up and printed, so the compiler can't drop the loops
+    [[nodiscard]] rtl::uint32_t checksum()
+    {
+        rtl::uint32_t sum = 0;
+
+        for ( rtl::uint32_t value : g_heavy )
+            sum += value;
+
+        for ( rtl::uint32_t value : g_light )
+            sum += value;
+
+        return sum;
+    }
+
+    // NOTE: A few microseconds of integer work per item, as a row of a fractal or a filter
+    [[nodiscard]] rtl::uint32_t heavy_item( rtl::size_t index )
+    {
+        rtl::uint32_t state = static_cast<rtl::uint32_t>( index ) | 1;
+
+        for ( int i = 0; i < 2000; ++i )
+        {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+        }
+
+        return state;
+    }
+
+    [[nodiscard]] double heavy_loop( rtl::size_t grain )
+    {
+        return bench::measure( heavy_count,
+                               [&]()
+                               {
+                                   rtl::jobs::parallel_for(
+                                       0,
+                                       heavy_count,
+                                       grain,
+                                       []( rtl::size_t first, rtl::size_t last )
+                                       {
+                                           for ( rtl::size_t i = first; i < last; ++i )
+                                               g_heavy[i] = heavy_item( i );
+                                       } );
+                               } );
+    }
+
+    [[nodiscard]] double light_loop( rtl::size_t grain )
+    {
+        return bench::measure( light_count,
+                               [&]()
+                               {
+                                   rtl::jobs::parallel_for(
+                                       0,
+                                       light_count,
+                                       grain,
+                                       []( rtl::size_t first, rtl::size_t last )
+                                       {
+                                           for ( rtl::size_t i = first; i < last; ++i )
+                                               g_light[i] = static_cast<rtl::uint32_t>( i ) * 3 + 1;
+                                       } );
+                               } );
+    }
+} // namespace
+
+int main()
+{
+    const rtl::size_t max_threads = rtl::impl::jobs::os::cpu_count();
+
+    printf( "%-8s %14s %8s %14s %8s %14s %8s\n",
+            "threads",
+            "heavy ns/item",
+            "speedup",
+            "light g=1024",
+            "speedup",
+            "light g=64",
+            "speedup" );
+
+    rtl::uint32_t sum = 0;
+    double        heavy_base = 0;
+    double        coarse_base = 0;
+    double        fine_base = 0;
+
+    // NOTE: The last row is a thread per logical CPU, whatever their number
+    for ( rtl::size_t threads = 1;; threads = rtl::min( threads * 2, max_threads ) )
+    {
+        rtl::impl::jobs::g_scheduler.init( threads );
+
+        const double heavy = heavy_loop( 4 );
+        const double coarse = light_loop( 1024 );
+        const double fine = light_loop( 64 );
+
+        rtl::impl::jobs::g_scheduler.shutdown();
+
+        sum += checksum();
+
+        if ( threads == 1 )
+        {
+            heavy_base = heavy;
+            coarse_base = coarse;
+            fine_base = fine;
+        }
+
+        printf( "%-8zu %14.1f %8.2f %14.3f %8.2f %14.3f %8.2f\n",
+                threads,
+                heavy,
+                heavy_base / heavy,
+                coarse,
+                coarse_base / coarse,
+                fine,
+                fine_base / fine );
+
+        if ( threads == max_threads )
+            break;
+    }
+
+    printf( "checksum %08x\n", sum );
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#define RTL_IMPLEMENTATION
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <rtl/sys/impl/mem.hpp>
+
+#include "bench.hpp"
+
+// Compares the memset, memcpy and memmove of the runtime with the ones of the C library, from
+// the sizes that fit the registers to the ones that don't fit any cache.
+namespace
+{
+    using fill_function = void* (*)( void*, int, rtl::size_t );
+    using copy_function = void* (*)( void*, const void*, rtl::size_t );
+
+    void* rtl_memset( void* dest, int ch, rtl::size_t count )
+    {
+        rtl::impl::mem::fill(
+            static_cast<rtl::uint8_t*>( dest ), static_cast<rtl::uint8_t>( ch ), count );
+        return dest;
+    }
+
+    void* rtl_memcpy( void* dest, const void* src, rtl::size_t count )
+    {
+        rtl::impl::mem::copy(
+            static_cast<rtl::uint8_t*>( dest ), static_cast<const rtl::uint8_t*>( src ), count );
+        return dest;
+    }
+
+    void* rtl_memmove( void* dest, const void* src, rtl::size_t count )
+    {
+        rtl::impl::mem::move(
+            static_cast<rtl::uint8_t*>( dest ), static_cast<const rtl::uint8_t*>( src ), count );
+        return dest;
+    }
+
+    // NOTE: Both sides are called through the volatile pointers, so they pay the same call and
+    // the compiler can't inline or drop the calls
+    fill_function volatile g_rtl_memset = rtl_memset;
+    fill_function volatile g_libc_memset = ::memset;
+    copy_function volatile g_rtl_memcpy = rtl_memcpy;
+    copy_function volatile g_libc_memcpy = ::memcpy;
+    copy_function volatile g_rtl_memmove = rtl_memmove;
+    copy_function volatile g_libc_memmove = ::memmove;
+
+    constexpr rtl::size_t max_size = 64 * 1024 * 1024;
+
+    // NOTE: Small sizes are repeated until about 64 MB are processed, the largest ones at least
+    // four times
+    [[nodiscard]] rtl::size_t iterations( rtl::size_t size )
+    {
+        const rtl::size_t count = max_size / size;
+        return count < 4 ? 4 : ( count > 4000000 ? 4000000 : count );
+    }
+
+    // NOTE: Gigabytes per second
+    [[nodiscard]] double throughput( rtl::size_t size, double nanoseconds )
+    {
+        return static_cast<double>( size ) / nanoseconds;
+    }
+
+    [[nodiscard]] double fill( fill_function volatile& fn, rtl::uint8_t* dst, rtl::size_t size )
+    {
+        const rtl::size_t count = iterations( size );
+
+        return throughput( size,
+                           bench::measure( count,
+                                           [&]()
+                                           {
+                                               for ( rtl::size_t i = 0; i < count; ++i )
+                                                   fn( dst, static_cast<int>( i ), size );
+                                           } ) );
+    }
+
+    [[nodiscard]] double copy( copy_function volatile& fn,
+                               rtl::uint8_t*            dst,
+                               const rtl::uint8_t*      src,
+                               rtl::size_t              size )
+    {
+        const rtl::size_t count = iterations( size );
+
+        return throughput( size,
+                           bench::measure( count,
+                                           [&]()
+                                           {
+                                               for ( rtl::size_t i = 0; i < count; ++i )
+                                                   fn( dst, src, size );
+                                           } ) );
+    }
+} // namespace
+
+int main()
+{
+    rtl::impl::g_cpu.init();
+
+    // NOTE: The memmove destination overlaps the source, so it is copied backwards
+    constexpr rtl::size_t overlap_shift = 40;
+    constexpr rtl::size_t alignment = 64;
+
+    // NOTE: aligned_alloc takes only the multiples of the alignment
+    constexpr rtl::size_t dst_size
+        = ( max_size + overlap_shift + alignment - 1 ) & ~( alignment - 1 );
+
+    rtl::uint8_t* const src = static_cast<rtl::uint8_t*>( ::aligned_alloc( alignment, max_size ) );
+    rtl::uint8_t* const dst = static_cast<rtl::uint8_t*>( ::aligned_alloc( alignment, dst_size ) );
+
+    ::memset( src, 1, max_size );
+    ::memset( dst, 2, dst_size );
+
+    printf( "ERMSB: %s\n", rtl::impl::g_cpu.erms() ? "yes" : "no" );
+    printf( "%-10s %8s %8s %8s %8s %8s %8s\n", "GB/s", "memset", "", "memcpy", "", "memmove", "" );
+    printf(
+        "%-10s %8s %8s %8s %8s %8s %8s\n", "size", "rtl", "libc", "rtl", "libc", "rtl", "libc" );
+
+    for ( rtl::size_t size = 8; size <= max_size; size *= 2 )
+    {
+        char label[16];
+
+        if ( size >= 1024 * 1024 )
+            snprintf( label, sizeof( label ), "%zu MB", size / ( 1024 * 1024 ) );
+        else if ( size >= 1024 )
+            snprintf( label, sizeof( label ), "%zu KB", size / 1024 );
+        else
+            snprintf( label, sizeof( label ), "%zu B", size );
+
+        printf( "%-10s %8.2f %8.2f %8.2f %8.2f %8.2f %8.2f\n",
+                label,
+                fill( g_rtl_memset, dst, size ),
+                fill( g_libc_memset, dst, size ),
+                copy( g_rtl_memcpy, dst, src, size ),
+                copy( g_libc_memcpy, dst, src, size ),
+                copy( g_rtl_memmove, dst + overlap_shift, dst, size ),
+                copy( g_libc_memmove, dst + overlap_shift, dst, size ) );
+    }
+
+    ::free( dst );
+    ::free( src );
+
+    return 0;
+}
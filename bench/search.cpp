@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#define RTL_IMPLEMENTATION
+
+#include <string.h>
+
+#include <string_view>
+
+#include <rtl/sys/impl/search.hpp>
+
+#include "bench.hpp"
+
+// Compares the search of rtl::string_view with the one of std::string_view and with memmem of
+// the C library on an OpenGL extension string of 10 KB, the way the application looks up the
+// extensions it needs.
+namespace
+{
+    using search_function = rtl::size_t ( * )( const char*, rtl::size_t, const char*, rtl::size_t );
+
+    rtl::size_t rtl_find( const char* str, rtl::size_t size, const char* what, rtl::size_t length )
+    {
+        return rtl::string_view( str, size ).find( rtl::string_view( what, length ) );
+    }
+
+    rtl::size_t rtl_rfind( const char* str, rtl::size_t size, const char* what, rtl::size_t length )
+    {
+        return rtl::string_view( str, size ).rfind( rtl::string_view( what, length ) );
+    }
+
+    rtl::size_t rtl_find_char( const char* str, rtl::size_t size, const char* what, rtl::size_t )
+    {
+        return rtl::string_view( str, size ).find( what[0] );
+    }
+
+    rtl::size_t rtl_find_first_of( const char* str,
+                                   rtl::size_t size,
+                                   const char* what,
+                                   rtl::size_t length )
+    {
+        return rtl::string_view( str, size ).find_first_of( rtl::string_view( what, length ) );
+    }
+
+    rtl::size_t std_find( const char* str, rtl::size_t size, const char* what, rtl::size_t length )
+    {
+        return std::string_view( str, size ).find( std::string_view( what, length ) );
+    }
+
+    rtl::size_t std_rfind( const char* str, rtl::size_t size, const char* what, rtl::size_t length )
+    {
+        return std::string_view( str, size ).rfind( std::string_view( what, length ) );
+    }
+
+    rtl::size_t std_find_char( const char* str, rtl::size_t size, const char* what, rtl::size_t )
+    {
+        return std::string_view( str, size ).find( what[0] );
+    }
+
+    rtl::size_t std_find_first_of( const char* str,
+                                   rtl::size_t size,
+                                   const char* what,
+                                   rtl::size_t length )
+    {
+        return std::string_view( str, size ).find_first_of( std::string_view( what, length ) );
+    }
+
+    rtl::size_t libc_find( const char* str, rtl::size_t size, const char* what, rtl::size_t length )
+    {
+        const void* found = memmem( str, size, what, length );
+        return found ? static_cast<rtl::size_t>( static_cast<const char*>( found ) - str )
+                     : rtl::size_t( -1 );
+    }
+
+    // NOTE: The functions are called through the volatile pointers, so the compiler can't hoist
+    // the search out of the loop
+    search_function volatile g_rtl_find = rtl_find;
+    search_function volatile g_rtl_rfind = rtl_rfind;
+    search_function volatile g_rtl_find_char = rtl_find_char;
+    search_function volatile g_rtl_find_first_of = rtl_find_first_of;
+    search_function volatile g_std_find = std_find;
+    search_function volatile g_std_rfind = std_rfind;
+    search_function volatile g_std_find_char = std_find_char;
+    search_function volatile g_std_find_first_of = std_find_first_of;
+    search_function volatile g_libc_find = libc_find;
+
+    constexpr rtl::size_t text_size = 10 * 1024;
+
+    char        g_text[text_size + 64];
+    rtl::size_t g_text_size = 0;
+
+    void append( const char* str )
+    {
+        const rtl::size_t length = strlen( str );
+
+        memcpy( g_text + g_text_size, str, length );
+        g_text_size += length;
+        g_text[g_text_size++] = ' ';
+    }
+
+    // NOTE: Names of the extensions repeat the same prefixes and words, as the real ones do.
+    // The one the application looks for is the last.
+    void make_text()
+    {
+        const char* prefixes[] = { "GL_ARB_", "GL_EXT_", "GL_NV_", "GL_AMD_", "WGL_ARB_" };
+        const char* words[] = { "texture", "shader", "buffer", "framebuffer", "vertex", "program",
+                                "sync",    "query",  "swap",   "compression", "float",  "object" };
+
+        append( "GL_VERSION_1_1" );
+
+        bench::random rng;
+
+        while ( g_text_size < text_size - 64 )
+        {
+            char name[64];
+            snprintf( name,
+                      sizeof( name ),
+                      "%s%s_%s%u",
+                      prefixes[rng.next() % 5],
+                      words[rng.next() % 12],
+                      words[rng.next() % 12],
+                      rng.next() % 100 );
+
+            append( name );
+        }
+
+        append( "WGL_EXT_swap_control" );
+    }
+
+    constexpr int repeats = 20000;
+
+    [[nodiscard]] double run( search_function volatile& fn, const char* what, rtl::size_t expected )
+    {
+        const rtl::size_t length = strlen( what );
+
+        if ( fn( g_text, g_text_size, what, length ) != expected )
+        {
+            printf( "wrong result for \"%s\"\n", what );
+            return 0;
+        }
+
+        return bench::measure( repeats,
+                               [&]()
+                               {
+                                   for ( int i = 0; i < repeats; ++i )
+                                       static_cast<void>( fn( g_text, g_text_size, what, length ) );
+                               } );
+    }
+
+    void print( const char*               name,
+                search_function volatile& rtl_fn,
+                search_function volatile& std_fn,
+                search_function volatile* libc_fn,
+                const char*               what,
+                rtl::size_t               expected )
+    {
+        const double rtl_time = run( rtl_fn, what, expected );
+        const double std_time = run( std_fn, what, expected );
+
+        if ( libc_fn )
+        {
+            printf( "%-28s %10.1f %10.1f %10.1f\n",
+                    name,
+                    rtl_time,
+                    std_time,
+                    run( *libc_fn, what, expected ) );
+        }
+        else
+        {
+            printf( "%-28s %10.1f %10.1f %10s\n", name, rtl_time, std_time, "-" );
+        }
+    }
+} // namespace
+
+int main()
+{
+    make_text();
+
+    const rtl::size_t npos = rtl::size_t( -1 );
+    const rtl::size_t last = g_text_size - 21;
+
+    printf( "%zu bytes of extension names\n", g_text_size );
+    printf( "%-28s %10s %10s %10s\n", "search, ns", "rtl", "std", "memmem" );
+
+    print( "find, the last one",
+           g_rtl_find,
+           g_std_find,
+           &g_libc_find,
+           "WGL_EXT_swap_control",
+           last );
+    print( "find, absent", g_rtl_find, g_std_find, &g_libc_find, "GL_KHR_debug_output", npos );
+    print( "find, absent, 40 chars",
+           g_rtl_find,
+           g_std_find,
+           &g_libc_find,
+           "GL_ARB_texture_compression_bptc_float_00",
+           npos );
+    print( "rfind, the first one", g_rtl_rfind, g_std_rfind, nullptr, "GL_VERSION_1_1", 0 );
+    print( "find char, absent", g_rtl_find_char, g_std_find_char, nullptr, "\n", npos );
+    print( "find_first_of, absent",
+           g_rtl_find_first_of,
+           g_std_find_first_of,
+           nullptr,
+           "\t\n",
+           npos );
+
+    return 0;
+}
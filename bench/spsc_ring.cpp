@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <pthread.h>
+#include <sched.h>
+
+#include <rtl/spsc_ring.hpp>
+
+#include "bench.hpp"
+
+// Measures the throughput of the rings between a producer and a consumer thread, element by
+// element, in batches and in variable-size records, and the latency of a hop between two threads.
+// The consumer checks the order of the data, the program exits with a non-zero code if it is
+// broken.
+namespace
+{
+    // NOTE: Spins first, then gives the core away, so the benchmark also runs on a single core
+    class backoff final
+    {
+    public:
+        void wait()
+        {
+            if ( ++m_spins < 1024 )
+            {
+                rtl::cpu_relax();
+            }
+            else
+            {
+                sched_yield();
+                m_spins = 0;
+            }
+        }
+
+    private:
+        unsigned m_spins{ 0 };
+    };
+
+    template<typename Function>
+    [[nodiscard]] pthread_t start_thread( Function& fn )
+    {
+        pthread_t thread;
+        pthread_create(
+            &thread,
+            nullptr,
+            []( void* context ) -> void*
+            {
+                ( *static_cast<Function*>( context ) )();
+                return nullptr;
+            },
+            &fn );
+
+        return thread;
+    }
+
+    constexpr rtl::size_t element_count = 1 << 24;
+    constexpr rtl::size_t batch_size = 64;
+
+    using element_ring = rtl::spsc_ring<rtl::uint64_t, 4096>;
+
+    element_ring g_ring;
+    bool         g_failed = false;
+
+    // Producer and consumer move one element at a time
+    [[nodiscard]] double single_elements()
+    {
+        return bench::measure( element_count,
+                               []()
+                               {
+                                   auto consumer = []()
+                                   {
+                                       backoff       pause;
+                                       rtl::uint64_t value = 0;
+
+                                       for ( rtl::uint64_t i = 0; i < element_count; ++i )
+                                       {
+                                           while ( !g_ring.try_pop( value ) )
+                                               pause.wait();
+
+                                           g_failed |= value != i;
+                                       }
+                                   };
+
+                                   const pthread_t thread = start_thread( consumer );
+
+                                   backoff pause;
+
+                                   for ( rtl::uint64_t i = 0; i < element_count; ++i )
+                                   {
+                                       while ( !g_ring.try_push( i ) )
+                                           pause.wait();
+                                   }
+
+                                   pthread_join( thread, nullptr );
+                               } );
+    }
+
+    // Producer and consumer move the elements in batches through push_n and pop_n
+    [[nodiscard]] double batches()
+    {
+        return bench::measure( element_count,
+                               []()
+                               {
+                                   auto consumer = []()
+                                   {
+                                       backoff       pause;
+                                       rtl::uint64_t values[batch_size];
+
+                                       for ( rtl::uint64_t next = 0; next < element_count; )
+                                       {
+                                           const rtl::size_t count
+                                               = g_ring.pop_n( values, batch_size );
+
+                                           if ( count == 0 )
+                                               pause.wait();
+
+                                           for ( rtl::size_t i = 0; i < count; ++i )
+                                               g_failed |= values[i] != next++;
+                                       }
+                                   };
+
+                                   const pthread_t thread = start_thread( consumer );
+
+                                   backoff       pause;
+                                   rtl::uint64_t values[batch_size];
+
+                                   for ( rtl::uint64_t next = 0; next < element_count; )
+                                   {
+                                       for ( rtl::size_t i = 0; i < batch_size; ++i )
+                                           values[i] = next + i;
+
+                                       const rtl::size_t count
+                                           = g_ring.push_n( values, batch_size );
+
+                                       if ( count == 0 )
+                                           pause.wait();
+
+                                       next += count;
+                                   }
+
+                                   pthread_join( thread, nullptr );
+                               } );
+    }
+
+    constexpr rtl::size_t record_count = 1 << 22;
+
+    rtl::spsc_byte_ring<65536> g_byte_ring;
+
+    // NOTE: Records of 8 to 120 bytes, as the lines of a log or the events of input. The first
+    // byte of a record is its number, the size follows from it.
+    [[nodiscard]] rtl::size_t record_size( rtl::size_t index )
+    {
+        return 8 + ( index * 7 ) % 113;
+    }
+
+    [[nodiscard]] double records( rtl::size_t& bytes )
+    {
+        bytes = 0;
+        for ( rtl::size_t i = 0; i < record_count; ++i )
+            bytes += record_size( i );
+
+        return bench::measure( record_count,
+                               []()
+                               {
+                                   auto consumer = []()
+                                   {
+                                       backoff pause;
+
+                                       for ( rtl::size_t i = 0; i < record_count; ++i )
+                                       {
+                                           rtl::span<const rtl::uint8_t> record;
+
+                                           while ( ( record = g_byte_ring.front() ).data()
+                                                   == nullptr )
+                                               pause.wait();
+
+                                           g_failed |= record.size() != record_size( i )
+                                                       || record[0]
+                                                              != static_cast<rtl::uint8_t>( i );
+
+                                           g_byte_ring.pop();
+                                       }
+                                   };
+
+                                   const pthread_t thread = start_thread( consumer );
+
+                                   backoff pause;
+
+                                   for ( rtl::size_t i = 0; i < record_count; ++i )
+                                   {
+                                       rtl::span<rtl::uint8_t> record;
+
+                                       while ( ( record = g_byte_ring.begin_write(
+                                                     record_size( i ) ) )
+                                                   .data()
+                                               == nullptr )
+                                           pause.wait();
+
+                                       record[0] = static_cast<rtl::uint8_t>( i );
+                                       g_byte_ring.commit_write();
+                                   }
+
+                                   pthread_join( thread, nullptr );
+                               } );
+    }
+
+    constexpr rtl::size_t round_trips = 20000;
+
+    rtl::spsc_ring<rtl::uint64_t, 2> g_ping;
+    rtl::spsc_ring<rtl::uint64_t, 2> g_pong;
+
+    // The second thread sends every value back, the half of a round trip is the latency of a hop
+    [[nodiscard]] double hop_latency()
+    {
+        return bench::measure( round_trips * 2,
+                               []()
+                               {
+                                   auto echo = []()
+                                   {
+                                       backoff       pause;
+                                       rtl::uint64_t value = 0;
+
+                                       for ( rtl::size_t i = 0; i < round_trips; ++i )
+                                       {
+                                           while ( !g_ping.try_pop( value ) )
+                                               pause.wait();
+
+                                           while ( !g_pong.try_push( value ) )
+                                               pause.wait();
+                                       }
+                                   };
+
+                                   const pthread_t thread = start_thread( echo );
+
+                                   backoff       pause;
+                                   rtl::uint64_t value = 0;
+
+                                   for ( rtl::uint64_t i = 0; i < round_trips; ++i )
+                                   {
+                                       while ( !g_ping.try_push( i ) )
+                                           pause.wait();
+
+                                       while ( !g_pong.try_pop( value ) )
+                                           pause.wait();
+
+                                       g_failed |= value != i;
+                                   }
+
+                                   pthread_join( thread, nullptr );
+                               } );
+    }
+} // namespace
+
+int main()
+{
+    printf( "%-24s %12s %12s\n", "workload", "ns per item", "M items/s" );
+
+    const double single = single_elements();
+    printf( "%-24s %12.2f %12.1f\n", "try_push/try_pop", single, 1e3 / single );
+
+    const double batch = batches();
+    printf( "%-24s %12.2f %12.1f\n", "push_n/pop_n by 64", batch, 1e3 / batch );
+
+    rtl::size_t  bytes = 0;
+    const double record = records( bytes );
+    printf( "%-24s %12.2f %12.1f %8.0f MB/s\n",
+            "records 8..120 B",
+            record,
+            1e3 / record,
+            static_cast<double>( bytes ) / ( record * record_count * 1e-3 ) );
+
+    const double hop = hop_latency();
+    printf( "%-24s %12.1f\n", "hop latency", hop );
+
+    if ( g_failed )
+        printf( "FAILED: the data came out of order\n" );
+
+    return g_failed;
+}
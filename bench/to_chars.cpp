@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <string.h>
+
+#include <charconv>
+#include <vector>
+
+#include <rtl/charconv.hpp>
+
+#include "bench.hpp"
+
+// Compares to_chars with snprintf of the C library and with std::to_chars on the numbers the
+// application prints: small counters, random 32-bit and 64-bit integers, frame times and random
+// doubles. The output of the library is checked against std::to_chars, which is the shortest
+// round-trip one too.
+namespace
+{
+    constexpr rtl::size_t count = 1 << 16;
+
+    // NOTE: The lengths are summed up, so the compiler can't drop the formatting
+    volatile rtl::size_t g_sink;
+
+    bool g_failed = false;
+
+    template<typename T>
+    [[nodiscard]] double run_rtl( const std::vector<T>& values )
+    {
+        return bench::measure( values.size(),
+                               [&]()
+                               {
+                                   char        buffer[32];
+                                   rtl::size_t length = 0;
+
+                                   for ( T value : values )
+                                       length += static_cast<rtl::size_t>(
+                                           rtl::to_chars( buffer, buffer + sizeof( buffer ), value )
+                                               .ptr
+                                           - buffer );
+
+                                   g_sink = length;
+                               } );
+    }
+
+    template<typename T>
+    [[nodiscard]] double run_std( const std::vector<T>& values )
+    {
+        return bench::measure( values.size(),
+                               [&]()
+                               {
+                                   char        buffer[32];
+                                   rtl::size_t length = 0;
+
+                                   for ( T value : values )
+                                       length += static_cast<rtl::size_t>(
+                                           std::to_chars( buffer, buffer + sizeof( buffer ), value )
+                                               .ptr
+                                           - buffer );
+
+                                   g_sink = length;
+                               } );
+    }
+
+    // NOTE: %.17g round-trips any double, but is not the shortest, %.2f is enough for the frame
+    // times
+    template<typename T>
+    [[nodiscard]] double run_snprintf( const std::vector<T>& values, const char* format )
+    {
+        return bench::measure( values.size(),
+                               [&]()
+                               {
+                                   char        buffer[32];
+                                   rtl::size_t length = 0;
+
+                                   for ( T value : values )
+                                       length += static_cast<rtl::size_t>(
+                                           snprintf( buffer, sizeof( buffer ), format, value ) );
+
+                                   g_sink = length;
+                               } );
+    }
+
+    // NOTE: The fixed notation of a large double pads the shortest digits with zeros, where
+    // std::to_chars prints the exact expansion, so the output is checked to be as long and to
+    // parse back to the same value instead of being compared character by character
+    template<typename T>
+    void check( const std::vector<T>& values )
+    {
+        for ( T value : values )
+        {
+            char rtl_buffer[32];
+            char std_buffer[32];
+
+            const char* rtl_end = rtl::to_chars( rtl_buffer, rtl_buffer + 32, value ).ptr;
+            const char* std_end = std::to_chars( std_buffer, std_buffer + 32, value ).ptr;
+
+            T parsed{};
+            std::from_chars( rtl_buffer, rtl_end, parsed );
+
+            if ( rtl_end - rtl_buffer != std_end - std_buffer || parsed != value )
+            {
+                printf( "%.*s differs from %.*s\n",
+                        static_cast<int>( rtl_end - rtl_buffer ),
+                        rtl_buffer,
+                        static_cast<int>( std_end - std_buffer ),
+                        std_buffer );
+
+                g_failed = true;
+                return;
+            }
+        }
+    }
+
+    template<typename T>
+    void print( const char* name, const std::vector<T>& values, const char* format )
+    {
+        check( values );
+
+        printf( "%-20s %10.1f %10.1f %10.1f\n",
+                name,
+                run_rtl( values ),
+                run_snprintf( values, format ),
+                run_std( values ) );
+    }
+} // namespace
+
+int main()
+{
+    bench::random rng;
+
+    std::vector<int>                counters( count );
+    std::vector<int>                integers( count );
+    std::vector<unsigned long long> wide( count );
+    std::vector<double>             frame_times( count );
+    std::vector<double>             doubles;
+
+    for ( rtl::size_t i = 0; i < count; ++i )
+    {
+        counters[i] = static_cast<int>( rng.next() % 10000 );
+        integers[i] = static_cast<int>( rng.next() );
+        wide[i] = static_cast<unsigned long long>( rng.next() ) << 32 | rng.next();
+
+        // NOTE: Milliseconds with two decimals, as the OSD shows them
+        frame_times[i] = static_cast<double>( rng.next() % 5000 ) / 100;
+    }
+
+    // NOTE: Random bit patterns, without the infinities and the NaNs
+    while ( doubles.size() < count )
+    {
+        const rtl::uint64_t bits = static_cast<rtl::uint64_t>( rng.next() ) << 32 | rng.next();
+
+        double value;
+        memcpy( &value, &bits, sizeof( value ) );
+
+        if ( ( bits >> 52 & 0x7FF ) != 0x7FF )
+            doubles.push_back( value );
+    }
+
+    printf( "%-20s %10s %10s %10s\n", "ns per number", "rtl", "snprintf", "std" );
+
+    print( "int, 0..9999", counters, "%d" );
+    print( "int, random", integers, "%d" );
+    print( "uint64, random", wide, "%llu" );
+    print( "double, frame time", frame_times, "%.2f" );
+    print( "double, random", doubles, "%.17g" );
+
+    if ( g_failed )
+        printf( "FAILED: the output is not the shortest round-trip one\n" );
+
+    return g_failed;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <iconv.h>
+#include <string.h>
+
+#include <vector>
+
+#include <rtl/utf.hpp>
+
+#include "bench.hpp"
+
+// Compares the transcoder with iconv of the C library on a megabyte of ASCII paths, of Latin text
+// with a few accented letters, of Cyrillic text and of CJK text. Both directions are measured, and
+// utf16_length, which the callers run first to allocate the output once. The speed is in MB of
+// UTF-8 per second.
+namespace
+{
+    constexpr rtl::size_t text_size = 1 << 20;
+
+    // NOTE: The words are picked at random until the text is long enough
+    [[nodiscard]] std::vector<char> make_text( const char* const* words, rtl::size_t count )
+    {
+        std::vector<char> text;
+        bench::random     rng;
+
+        while ( text.size() < text_size )
+        {
+            const char* word = words[rng.next() % count];
+            text.insert( text.end(), word, word + strlen( word ) );
+        }
+
+        return text;
+    }
+
+    struct result
+    {
+        double to_utf16;
+        double iconv_to_utf16;
+        double to_utf8;
+        double iconv_to_utf8;
+        double length;
+    };
+
+    // NOTE: Returns false if iconv fails or does not fill the output exactly
+    [[nodiscard]] bool
+    convert( iconv_t cd, const void* in, rtl::size_t in_size, void* out, rtl::size_t out_size )
+    {
+        char*       in_ptr = static_cast<char*>( const_cast<void*>( in ) );
+        char*       out_ptr = static_cast<char*>( out );
+        rtl::size_t in_left = in_size;
+        rtl::size_t out_left = out_size;
+
+        const rtl::size_t converted = iconv( cd, &in_ptr, &in_left, &out_ptr, &out_left );
+
+        return converted != static_cast<rtl::size_t>( -1 ) && in_left == 0 && out_left == 0;
+    }
+
+    [[nodiscard]] double megabytes_per_second( double ns_per_byte )
+    {
+        return 1e3 / ns_per_byte;
+    }
+
+    bool g_failed = false;
+
+    [[nodiscard]] result run( const std::vector<char>& text )
+    {
+        const char* first = text.data();
+        const char* last = text.data() + text.size();
+
+        const rtl::size_t units = rtl::utf16_length( first, last ).length;
+        const rtl::size_t wide_bytes = units * sizeof( char16_t );
+
+        std::vector<char16_t> wide( units );
+        std::vector<char16_t> wide_iconv( units );
+        std::vector<char>     narrow( text.size() );
+
+        iconv_t to_utf16 = iconv_open( "UTF-16LE", "UTF-8" );
+        iconv_t to_utf8 = iconv_open( "UTF-8", "UTF-16LE" );
+
+        result times;
+
+        times.length = bench::measure( text.size(),
+                                       [&]()
+                                       {
+                                           g_failed |= rtl::utf16_length( first, last ).length
+                                                       != units;
+                                       } );
+
+        times.to_utf16 = bench::measure(
+            text.size(),
+            [&]()
+            {
+                g_failed |= rtl::utf8_to_utf16( first, last, wide.data(), wide.data() + units ).ec
+                            != rtl::errc::ok;
+            } );
+
+        times.iconv_to_utf16 = bench::measure(
+            text.size(),
+            [&]()
+            {
+                g_failed |= !convert( to_utf16, first, text.size(), wide_iconv.data(), wide_bytes );
+            } );
+
+        g_failed |= wide != wide_iconv;
+
+        times.to_utf8 = bench::measure(
+            text.size(),
+            [&]()
+            {
+                g_failed |= rtl::utf16_to_utf8( wide.data(),
+                                                wide.data() + units,
+                                                narrow.data(),
+                                                narrow.data() + narrow.size() )
+                                .ec
+                            != rtl::errc::ok;
+            } );
+
+        g_failed |= narrow != text;
+
+        times.iconv_to_utf8 = bench::measure(
+            text.size(),
+            [&]()
+            {
+                g_failed
+                    |= !convert( to_utf8, wide.data(), wide_bytes, narrow.data(), narrow.size() );
+            } );
+
+        g_failed |= narrow != text;
+
+        iconv_close( to_utf16 );
+        iconv_close( to_utf8 );
+
+        return times;
+    }
+
+    void print( const char* name, const std::vector<char>& text )
+    {
+        const result times = run( text );
+
+        printf( "%-10s %10.0f %10.0f %10.0f %10.0f %10.0f\n",
+                name,
+                megabytes_per_second( times.to_utf16 ),
+                megabytes_per_second( times.iconv_to_utf16 ),
+                megabytes_per_second( times.to_utf8 ),
+                megabytes_per_second( times.iconv_to_utf8 ),
+                megabytes_per_second( times.length ) );
+    }
+} // namespace
+
+int main()
+{
+    const char* paths[] = { "C:/Users/Public/Documents/",
+                            "shaders/fractal.cl ",
+                            "textures/level01/diffuse.png ",
+                            "OpenCL kernel compiled in 12 ms\n" };
+
+    const char* latin[] = { "caf\xC3\xA9 ", "na\xC3\xAFve ", "r\xC3\xA9sum\xC3\xA9 ",
+                            "the ",         "frame ",        "rendered ",
+                            "in ",          "time ",         "Stra\xC3\x9F" "e " };
+
+    const char* cyrillic[] = { "\xD0\xBA\xD0\xB0\xD0\xB4\xD1\x80 ",
+                               "\xD0\xB2\xD1\x80\xD0\xB5\xD0\xBC\xD1\x8F ",
+                               "\xD1\x84\xD0\xB0\xD0\xB9\xD0\xBB ",
+                               "\xD1\x82\xD0\xB5\xD0\xBA\xD1\x81\xD1\x82"
+                               "\xD1\x83\xD1\x80\xD0\xB0 " };
+
+    const char* cjk[] = { "\xE6\x96\x87\xE5\xAD\x97", "\xE7\x94\xBB\xE9\x9D\xA2",
+                          "\xE6\x99\x82\xE9\x96\x93", "\xE8\xA8\xAD\xE5\xAE\x9A",
+                          "\xF0\x9F\x98\x80",         ", " };
+
+    printf( "%-10s %10s %10s %10s %10s %10s\n",
+            "MB/s",
+            "to utf16",
+            "iconv",
+            "to utf8",
+            "iconv",
+            "length" );
+
+    print( "paths", make_text( paths, sizeof( paths ) / sizeof( paths[0] ) ) );
+    print( "latin", make_text( latin, sizeof( latin ) / sizeof( latin[0] ) ) );
+    print( "cyrillic", make_text( cyrillic, sizeof( cyrillic ) / sizeof( cyrillic[0] ) ) );
+    print( "cjk", make_text( cjk, sizeof( cjk ) / sizeof( cjk[0] ) ) );
+
+    if ( g_failed )
+        printf( "FAILED: the output differs from iconv\n" );
+
+    return g_failed;
+}
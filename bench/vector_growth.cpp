@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#include <malloc.h>
+#include <stdlib.h>
+
+#include <rtl/algorithm.hpp>
+#include <rtl/vector.hpp>
+
+#include "bench.hpp"
+
+// Compares the growth of rtl::vector, which constructs only the live elements and relocates the
+// trivially copyable ones with memcpy, with the previous growth path. That one took the new
+// capacity from the zero-filling operator new[], default-constructed all of it and move-assigned
+// the old elements over.
+namespace
+{
+    struct particle
+    {
+        float         position[3]{};
+        float         velocity[3]{};
+        rtl::uint32_t color{ 0xffffffffu };
+        float         life{ 1.f };
+    };
+
+    struct vertex
+    {
+        float position[3]{};
+        float normal[3]{ 0.f, 0.f, 1.f };
+        float uv[2]{};
+    };
+
+    template<typename T>
+    class legacy_vector final
+    {
+    public:
+        legacy_vector()
+            : m_data( allocate( default_capacity ) )
+        {
+        }
+
+        ~legacy_vector()
+        {
+            release( m_data, m_capacity );
+        }
+
+        legacy_vector( const legacy_vector& ) = delete;
+        legacy_vector& operator=( const legacy_vector& ) = delete;
+
+        void push_back( T&& element )
+        {
+            if ( m_size + 1 > m_capacity )
+                grow( m_capacity * 2 );
+
+            m_data[m_size++] = rtl::move( element );
+        }
+
+        void resize( rtl::size_t size )
+        {
+            if ( size > m_capacity )
+                grow( size );
+
+            m_size = size;
+        }
+
+        [[nodiscard]] const T& operator[]( rtl::size_t index ) const
+        {
+            return m_data[index];
+        }
+
+    private:
+        static constexpr rtl::size_t default_capacity = 8;
+
+        // NOTE: The same work as the zero-filling operator new[] followed by new T[count]
+        [[nodiscard]] static T* allocate( rtl::size_t count )
+        {
+            T* data = static_cast<T*>( ::calloc( count, sizeof( T ) ) );
+
+            for ( rtl::size_t i = 0; i < count; ++i )
+                ::new ( static_cast<void*>( data + i ) ) T();
+
+            return data;
+        }
+
+        static void release( T* data, rtl::size_t count )
+        {
+            for ( rtl::size_t i = 0; i < count; ++i )
+                data[i].~T();
+
+            ::free( data );
+        }
+
+        void grow( rtl::size_t capacity )
+        {
+            T* data = allocate( capacity );
+
+            for ( rtl::size_t i = 0; i < m_size; ++i )
+                data[i] = rtl::move( m_data[i] );
+
+            release( m_data, m_capacity );
+
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        rtl::size_t m_size{ 0 };
+        rtl::size_t m_capacity{ default_capacity };
+        T*          m_data{ nullptr };
+    };
+
+    constexpr rtl::size_t element_count = 100000;
+    constexpr int         repeats = 20;
+
+    // NOTE: Reads an element back, so the compiler can't drop the filling
+    template<typename Vector>
+    void touch( const Vector& v, rtl::size_t index, volatile float& sink )
+    {
+        sink = sink + reinterpret_cast<const float*>( &v[index] )[0];
+    }
+
+    template<typename Vector, typename T>
+    double push_back()
+    {
+        volatile float sink = 0;
+
+        return bench::measure( element_count * repeats,
+                               [&]()
+                               {
+                                   for ( int r = 0; r < repeats; ++r )
+                                   {
+                                       Vector v;
+
+                                       for ( rtl::size_t i = 0; i < element_count; ++i )
+                                       {
+                                           T element;
+                                           element.position[0] = static_cast<float>( i );
+                                           v.push_back( rtl::move( element ) );
+                                       }
+
+                                       touch( v, element_count / 2, sink );
+                                   }
+                               } );
+    }
+
+    template<typename Vector>
+    double resize()
+    {
+        volatile float sink = 0;
+
+        return bench::measure( element_count * repeats,
+                               [&]()
+                               {
+                                   for ( int r = 0; r < repeats; ++r )
+                                   {
+                                       Vector v;
+                                       v.resize( element_count );
+                                       touch( v, element_count - 1, sink );
+                                   }
+                               } );
+    }
+
+    template<typename T>
+    void report( const char* name )
+    {
+        char label[48];
+
+        snprintf( label, sizeof( label ), "push_back %s", name );
+        printf( "%-24s %12.2f %12.2f\n",
+                label,
+                push_back<rtl::vector<T>, T>(),
+                push_back<legacy_vector<T>, T>() );
+
+        snprintf( label, sizeof( label ), "resize %s", name );
+        printf( "%-24s %12.2f %12.2f\n",
+                label,
+                resize<rtl::vector<T>>(),
+                resize<legacy_vector<T>>() );
+    }
+} // namespace
+
+int main()
+{
+    // NOTE: The blocks are recycled from the heap, as they are in a running app. Otherwise glibc
+    // maps the large ones afresh every time, page faults dominate the time and calloc gets the
+    // zeroes for free.
+    mallopt( M_MMAP_THRESHOLD, 32 * 1024 * 1024 );
+    mallopt( M_TRIM_THRESHOLD, 256 * 1024 * 1024 );
+
+    printf( "%-24s %12s %12s\n", "100k elements, ns per", "rtl::vector", "legacy" );
+
+    report<particle>( "particle" );
+    report<vertex>( "vertex" );
+
+    return 0;
+}
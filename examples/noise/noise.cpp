@@ -12,6 +12,7 @@
 
 #include <rtl/random.hpp>
 #include <rtl/sys/application.hpp>
+#include <rtl/sys/jobs.hpp>
 
 using rtl::Application;
 using rtl::random;
@@ -26,7 +27,7 @@ void main()
         []( const Application::Environment&, Application::Params& params )
         {
             params.window = { 640, 480 };
-            params.audio = { 48000, 24000 };
+            params.audio = { 48000, 24000, 1 };
             return true;
         },
         []( const Application::Environment&, [[maybe_unused]] const Application::Input& input )
@@ -39,23 +40,38 @@ void main()
             if ( input.keys.pressed[Keys::escape] )
                 return Application::Action::close;
 
-            auto* line = input.screen.pixels_buffer_pointer;
+            // NOTE: The generator is not thread-safe, so every row gets its own xorshift state
+            // seeded from it
+            const rtl::uint32_t seed = g_random.rand();
 
-            for ( int i = 0; i < input.screen.height; ++i )
-            {
-                auto* pixel = line;
-
-                for ( int k = 0; k < input.screen.width; ++k )
+            rtl::jobs::parallel_for(
+                0,
+                static_cast<rtl::size_t>( input.screen.height ),
+                16,
+                [&input, seed]( rtl::size_t first, rtl::size_t last )
                 {
-                    const rtl::uint8_t pix = g_random.rand() & 0xff;
+                    for ( rtl::size_t row = first; row < last; ++row )
+                    {
+                        auto* pixel = input.screen.pixels_buffer_pointer
+                                      + row * input.screen.pixels_buffer_pitch;
 
-                    *pixel++ = pix;
-                    *pixel++ = pix;
-                    *pixel++ = pix;
-                }
+                        rtl::uint32_t state
+                            = ( seed ^ ( static_cast<rtl::uint32_t>( row ) * 0x9e3779b9u ) ) | 1;
 
-                line += input.screen.pixels_buffer_pitch;
-            }
+                        for ( int k = 0; k < input.screen.width; ++k )
+                        {
+                            state ^= state << 13;
+                            state ^= state >> 17;
+                            state ^= state << 5;
+
+                            const rtl::uint8_t pix = state & 0xff;
+
+                            *pixel++ = pix;
+                            *pixel++ = pix;
+                            *pixel++ = pix;
+                        }
+                    }
+                } );
 
             auto* samples = input.audio.output_frame_pointer;
 
@@ -10,6 +10,9 @@
  */
 #pragma once
 
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/type_traits.hpp>
 #include <rtl/utility.hpp>
 
 namespace rtl
@@ -46,9 +49,76 @@ namespace rtl
         return val < T( 0 ) ? -val : val;
     }
 
+    namespace impl
+    {
+        // NOTE: Assigning the elements of a pointer range of the same trivially copyable type is
+        // the same as copying its bytes
+        template<typename Source, typename Destination>
+        constexpr bool is_bitwise_copyable = false;
+
+        template<typename T, typename U>
+        constexpr bool is_bitwise_copyable<T*, U*>
+            = is_same<typename remove_cv<T>::type, U>::value && !is_volatile<T>::value
+              && is_trivially_copyable<U>::value;
+
+        template<typename Destination, typename Value>
+        constexpr bool is_bitwise_fillable = false;
+
+        template<typename T, typename Value>
+        constexpr bool is_bitwise_fillable<T*, Value>
+            = is_same<T, typename remove_cv<Value>::type>::value && is_trivially_copyable<T>::value;
+
+        template<typename T>
+        T* copy_bytes( const T* src, size_t count, T* dst )
+        {
+            // NOTE: memmove keeps the semantics of the element loop for the ranges that overlap
+            // with \dst below \src
+            memmove( dst, src, count * sizeof( T ) );
+            return dst + count;
+        }
+
+        template<typename T>
+        T* fill_bytes( T* first, size_t count, const T& value )
+        {
+            if ( count == 0 )
+                return first;
+
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>( &value );
+
+            bool repeated = true;
+            for ( size_t i = 1; i < sizeof( T ); ++i )
+                repeated = repeated && bytes[i] == bytes[0];
+
+            if ( repeated )
+            {
+                memset( first, bytes[0], count * sizeof( T ) );
+                return first + count;
+            }
+
+            // NOTE: Any other pattern is spread by doubling the filled part, so most of the
+            // work is done by the bulk memcpy
+            first[0] = value;
+
+            for ( size_t filled = 1; filled < count; )
+            {
+                const size_t chunk = filled < count - filled ? filled : count - filled;
+                memcpy( first + filled, first, chunk * sizeof( T ) );
+                filled += chunk;
+            }
+
+            return first + count;
+        }
+    } // namespace impl
+
     template<typename InputIterator, typename Size, typename OutputIterator>
     constexpr OutputIterator copy_n( InputIterator src, Size count, OutputIterator dst )
     {
+        if constexpr ( impl::is_bitwise_copyable<InputIterator, OutputIterator> )
+        {
+            if ( !rtl::is_constant_evaluated() )
+                return count > 0 ? impl::copy_bytes( src, static_cast<size_t>( count ), dst ) : dst;
+        }
+
         for ( Size i = 0; i < count; ++i )
             *dst++ = *src++;
 
@@ -58,6 +128,12 @@ namespace rtl
     template<typename InputIterator, typename Size, typename OutputIterator>
     constexpr OutputIterator move_n( InputIterator src, Size count, OutputIterator dst )
     {
+        if constexpr ( impl::is_bitwise_copyable<InputIterator, OutputIterator> )
+        {
+            if ( !rtl::is_constant_evaluated() )
+                return count > 0 ? impl::copy_bytes( src, static_cast<size_t>( count ), dst ) : dst;
+        }
+
         for ( Size i = 0; i < count; ++i )
             *dst++ = rtl::move( *src++ );
 
@@ -67,6 +143,13 @@ namespace rtl
     template<typename Iterator, typename Size, typename Value>
     constexpr Iterator fill_n( Iterator first, Size count, const Value& value )
     {
+        if constexpr ( impl::is_bitwise_fillable<Iterator, Value> )
+        {
+            if ( !rtl::is_constant_evaluated() )
+                return count > 0 ? impl::fill_bytes( first, static_cast<size_t>( count ), value )
+                                 : first;
+        }
+
         for ( Size i = 0; i < count; ++i )
             *first++ = value;
 
@@ -76,6 +159,15 @@ namespace rtl
     template<typename Iterator, typename Value>
     constexpr void fill( Iterator first, Iterator last, const Value& value )
     {
+        if constexpr ( impl::is_bitwise_fillable<Iterator, Value> )
+        {
+            if ( !rtl::is_constant_evaluated() )
+            {
+                impl::fill_bytes( first, static_cast<size_t>( last - first ), value );
+                return;
+            }
+        }
+
         for ( ; first != last; ++first )
             *first = value;
     }
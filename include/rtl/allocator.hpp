@@ -11,11 +11,107 @@
 #pragma once
 
 #include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/type_traits.hpp>
 
 namespace rtl
 {
+    // Stateless allocator on top of the global operator new and operator delete.
+    template<typename T>
+    class allocator final
+    {
+    public:
+        using value_type = T;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = allocator<U>;
+        };
+
+        constexpr allocator() = default;
+
+        template<typename U>
+        constexpr allocator( const allocator<U>& )
+        {
+        }
+
+        [[nodiscard]] T* allocate( size_t n ) const
+        {
+            if constexpr ( alignof( T ) > __STDCPP_DEFAULT_NEW_ALIGNMENT__ )
+                return static_cast<T*>(
+                    ::operator new( n * sizeof( T ), std::align_val_t( alignof( T ) ) ) );
+            else
+                return static_cast<T*>( ::operator new( n * sizeof( T ) ) );
+        }
+
+        void deallocate( T* p, size_t ) const
+        {
+            if constexpr ( alignof( T ) > __STDCPP_DEFAULT_NEW_ALIGNMENT__ )
+                ::operator delete( p, std::align_val_t( alignof( T ) ) );
+            else
+                ::operator delete( p );
+        }
+
+        [[nodiscard]] constexpr bool operator==( const allocator& ) const
+        {
+            return true;
+        }
+
+        [[nodiscard]] constexpr bool operator!=( const allocator& ) const
+        {
+            return false;
+        }
+    };
+
     namespace allocators
     {
+        // Stateless allocator that aligns memory to \Alignment bytes (e.g. for SIMD loads or to
+        // keep the buffer on its own cache lines).
+        template<typename T, size_t Alignment>
+        class aligned final
+        {
+        public:
+            using value_type = T;
+
+            static_assert( ( Alignment & ( Alignment - 1 ) ) == 0, "alignment must be power of 2" );
+            static_assert( Alignment >= alignof( T ), "alignment is weaker than the type's one" );
+
+            template<typename U>
+            struct rebind
+            {
+                using other = aligned<U, Alignment>;
+            };
+
+            constexpr aligned() = default;
+
+            template<typename U>
+            constexpr aligned( const aligned<U, Alignment>& )
+            {
+            }
+
+            [[nodiscard]] T* allocate( size_t n ) const
+            {
+                return static_cast<T*>(
+                    ::operator new( n * sizeof( T ), std::align_val_t( Alignment ) ) );
+            }
+
+            void deallocate( T* p, size_t ) const
+            {
+                ::operator delete( p, std::align_val_t( Alignment ) );
+            }
+
+            [[nodiscard]] constexpr bool operator==( const aligned& ) const
+            {
+                return true;
+            }
+
+            [[nodiscard]] constexpr bool operator!=( const aligned& ) const
+            {
+                return false;
+            }
+        };
+
         template<typename T, int Size>
         class grow_only final
         {
@@ -34,15 +130,278 @@ namespace rtl
                 return m_buffer + offset;
             }
 
+            // NOTE: Only the most recent allocation is actually returned to the buffer
+            constexpr void deallocate( T* p, size_t n )
+            {
+                if ( p && p + n == m_buffer + m_size )
+                    m_size -= n;
+            }
+
             constexpr void reset()
             {
                 m_size = 0;
             }
 
         private:
+            grow_only( const grow_only& ) = delete;
+            grow_only& operator=( const grow_only& ) = delete;
+
             T      m_buffer[Size];
-            size_t m_size;
+            size_t m_size{ 0 };
+        };
+
+        // Monotonic arena: like \grow_only, but its size is not fixed at compile time. Memory is
+        // taken from the global operator new in chained blocks and is released all at once by
+        // \reset. If the last cycle spilled over several blocks, \reset replaces them by a
+        // single block of the total size, so a steady workload stops touching the heap.
+        class monotonic_buffer final
+        {
+        public:
+            static constexpr size_t default_block_size = 64 * 1024;
+            static constexpr size_t default_alignment = alignof( double );
+
+            constexpr monotonic_buffer() = default;
+
+            constexpr explicit monotonic_buffer( size_t block_size )
+                : m_block_size( block_size )
+            {
+            }
+
+            ~monotonic_buffer()
+            {
+                release();
+            }
+
+            [[nodiscard]] void* allocate( size_t size, size_t alignment = default_alignment )
+            {
+                if ( void* p = allocate_from_head( size, alignment ) )
+                    return p;
+
+                const size_t min_size = size + alignment;
+                const size_t block_size
+                    = min_size > m_block_size ? min_size
+                      : m_block_size          ? m_block_size
+                                              : default_block_size;
+
+                push_block( block_size );
+                return allocate_from_head( size, alignment );
+            }
+
+            // NOTE: Makes all memory allocated since the previous call available again
+            void reset()
+            {
+                if ( m_head && m_head->next )
+                {
+                    const size_t total_size = m_total_size;
+
+                    release();
+                    push_block( total_size );
+                }
+
+                m_offset = 0;
+            }
+
+            // NOTE: Returns all blocks to the heap
+            void release()
+            {
+                while ( m_head )
+                {
+                    block* next = m_head->next;
+                    ::operator delete( m_head );
+                    m_head = next;
+                }
+
+                m_offset = 0;
+                m_total_size = 0;
+            }
+
+            // NOTE: Total size of the blocks owned by the arena
+            [[nodiscard]] constexpr size_t capacity() const
+            {
+                return m_total_size;
+            }
+
+        private:
+            monotonic_buffer( const monotonic_buffer& ) = delete;
+            monotonic_buffer& operator=( const monotonic_buffer& ) = delete;
+
+            struct block
+            {
+                block* next;
+                size_t size;
+            };
+
+            [[nodiscard]] void* allocate_from_head( size_t size, size_t alignment )
+            {
+                if ( !m_head )
+                    return nullptr;
+
+                const size_t base = reinterpret_cast<size_t>( m_head + 1 );
+                const size_t aligned = ( base + m_offset + alignment - 1 ) & ~( alignment - 1 );
+                const size_t offset = aligned - base;
+
+                if ( offset > m_head->size || size > m_head->size - offset )
+                    return nullptr;
+
+                m_offset = offset + size;
+                return reinterpret_cast<void*>( aligned );
+            }
+
+            void push_block( size_t size )
+            {
+                block* b = static_cast<block*>( ::operator new( sizeof( block ) + size ) );
+                b->next = m_head;
+                b->size = size;
+
+                m_head = b;
+                m_offset = 0;
+                m_total_size += size;
+            }
+
+            block* m_head{ nullptr };
+            size_t m_offset{ 0 };
+            size_t m_total_size{ 0 };
+            size_t m_block_size{ 0 };
+        };
+
+        // Typed handle to \monotonic_buffer for the containers. Deallocation does nothing, memory
+        // is reclaimed by \monotonic_buffer::reset.
+        template<typename T>
+        class monotonic final
+        {
+        public:
+            using value_type = T;
+
+            template<typename U>
+            struct rebind
+            {
+                using other = monotonic<U>;
+            };
+
+            constexpr explicit monotonic( monotonic_buffer& buffer )
+                : m_buffer( &buffer )
+            {
+            }
+
+            template<typename U>
+            constexpr monotonic( const monotonic<U>& other )
+                : m_buffer( other.buffer() )
+            {
+            }
+
+            [[nodiscard]] T* allocate( size_t n ) const
+            {
+                return static_cast<T*>( m_buffer->allocate( n * sizeof( T ), alignof( T ) ) );
+            }
+
+            constexpr void deallocate( T*, size_t ) const
+            {
+            }
+
+            [[nodiscard]] constexpr monotonic_buffer* buffer() const
+            {
+                return m_buffer;
+            }
+
+            [[nodiscard]] constexpr bool operator==( const monotonic& rhs ) const
+            {
+                return m_buffer == rhs.m_buffer;
+            }
+
+            [[nodiscard]] constexpr bool operator!=( const monotonic& rhs ) const
+            {
+                return m_buffer != rhs.m_buffer;
+            }
+
+        private:
+            monotonic_buffer* m_buffer;
+        };
+
+        // Copyable handle to an allocator that can't be copied itself (e.g. \grow_only arena).
+        // Containers keep a copy of their allocator, so they should refer to arenas through it.
+        template<typename Allocator>
+        class reference final
+        {
+        public:
+            using value_type = typename Allocator::value_type;
+
+            constexpr explicit reference( Allocator& allocator )
+                : m_allocator( &allocator )
+            {
+            }
+
+            [[nodiscard]] constexpr value_type* allocate( size_t n ) const
+            {
+                return m_allocator->allocate( n );
+            }
+
+            constexpr void deallocate( value_type* p, size_t n ) const
+            {
+                m_allocator->deallocate( p, n );
+            }
+
+            [[nodiscard]] constexpr bool operator==( const reference& rhs ) const
+            {
+                return m_allocator == rhs.m_allocator;
+            }
+
+            [[nodiscard]] constexpr bool operator!=( const reference& rhs ) const
+            {
+                return m_allocator != rhs.m_allocator;
+            }
+
+        private:
+            Allocator* m_allocator;
         };
     } // namespace allocators
 
+    namespace impl
+    {
+        // Base class of allocator-aware containers that keeps a copy of the allocator.
+        // Stateless allocators take no space due to the empty base optimization.
+        template<typename Allocator, bool Stateless = is_empty<Allocator>::value>
+        class allocator_holder
+        {
+        protected:
+            constexpr allocator_holder() = default;
+
+            constexpr explicit allocator_holder( const Allocator& )
+            {
+            }
+
+            [[nodiscard]] constexpr Allocator allocator_ref() const
+            {
+                return Allocator();
+            }
+
+            constexpr void replace_allocator( const allocator_holder& )
+            {
+            }
+        };
+
+        template<typename Allocator>
+        class allocator_holder<Allocator, false>
+        {
+        protected:
+            constexpr allocator_holder() = default;
+
+            constexpr explicit allocator_holder( const Allocator& allocator )
+                : m_allocator( allocator )
+            {
+            }
+
+            [[nodiscard]] constexpr Allocator& allocator_ref() const
+            {
+                return m_allocator;
+            }
+
+            constexpr void replace_allocator( const allocator_holder& other )
+            {
+                m_allocator = other.m_allocator;
+            }
+
+        private:
+            mutable Allocator m_allocator;
+        };
+    } // namespace impl
 } // namespace rtl
@@ -0,0 +1,531 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/int.hpp>
+#include <rtl/type_traits.hpp>
+
+#if defined( _MSC_VER )
+    #include <intrin.h>
+#endif
+
+namespace rtl
+{
+    // NOTE: The values are the same as of the __ATOMIC_* constants of GCC and Clang
+    enum class memory_order : int
+    {
+        relaxed,
+        consume,
+        acquire,
+        release,
+        acq_rel,
+        seq_cst
+    };
+
+    constexpr memory_order memory_order_relaxed = memory_order::relaxed;
+    constexpr memory_order memory_order_consume = memory_order::consume;
+    constexpr memory_order memory_order_acquire = memory_order::acquire;
+    constexpr memory_order memory_order_release = memory_order::release;
+    constexpr memory_order memory_order_acq_rel = memory_order::acq_rel;
+    constexpr memory_order memory_order_seq_cst = memory_order::seq_cst;
+
+    namespace impl
+    {
+        namespace atomics
+        {
+            // NOTE: The order of a failed compare exchange can not be stronger than the order of
+            // a load
+            [[nodiscard]] constexpr memory_order failure_order( memory_order order )
+            {
+                if ( order == memory_order::acq_rel )
+                    return memory_order::acquire;
+
+                if ( order == memory_order::release )
+                    return memory_order::relaxed;
+
+                return order;
+            }
+
+            // Unit of \fetch_add: pointers move by elements, integers by one
+            template<typename T>
+            struct step
+            {
+                static constexpr T value = 1;
+            };
+
+            template<typename T>
+            struct step<T*>
+            {
+                static constexpr ptrdiff_t value = sizeof( T );
+            };
+
+#if defined( _MSC_VER )
+            // NOTE: Every interlocked intrinsic is a full barrier, and aligned loads and stores
+            // are atomic by themselves. x86 and x64 don't reorder loads with loads and stores with
+            // stores, so there the acquire and release orders only have to keep the compiler from
+            // reordering. ARM64 reorders them, so it needs the DMB instruction.
+            inline void barrier()
+            {
+    #if defined( _M_IX86 ) || defined( _M_X64 )
+                _ReadWriteBarrier();
+    #elif defined( _M_ARM64 )
+                __dmb( _ARM64_BARRIER_ISH );
+    #else
+        #error "rtl::atomic supports only x86, x64 and ARM64 with MSVC"
+    #endif
+            }
+
+            template<size_t Size>
+            struct interlocked;
+
+            template<>
+            struct interlocked<1>
+            {
+                using type = char;
+
+                static type load( const volatile type* ptr )
+                {
+                    return __iso_volatile_load8( reinterpret_cast<const volatile __int8*>( ptr ) );
+                }
+
+                static void store( volatile type* ptr, type value )
+                {
+                    __iso_volatile_store8( reinterpret_cast<volatile __int8*>( ptr ), value );
+                }
+
+                static type exchange( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchange8( ptr, value );
+                }
+
+                static type compare_exchange( volatile type* ptr, type desired, type expected )
+                {
+                    return _InterlockedCompareExchange8( ptr, desired, expected );
+                }
+
+                static type fetch_add( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchangeAdd8( ptr, value );
+                }
+            };
+
+            template<>
+            struct interlocked<2>
+            {
+                using type = short;
+
+                static type load( const volatile type* ptr )
+                {
+                    return __iso_volatile_load16( ptr );
+                }
+
+                static void store( volatile type* ptr, type value )
+                {
+                    __iso_volatile_store16( ptr, value );
+                }
+
+                static type exchange( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchange16( ptr, value );
+                }
+
+                static type compare_exchange( volatile type* ptr, type desired, type expected )
+                {
+                    return _InterlockedCompareExchange16( ptr, desired, expected );
+                }
+
+                static type fetch_add( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchangeAdd16( ptr, value );
+                }
+            };
+
+            template<>
+            struct interlocked<4>
+            {
+                using type = long;
+
+                static type load( const volatile type* ptr )
+                {
+                    return __iso_volatile_load32( reinterpret_cast<const volatile int*>( ptr ) );
+                }
+
+                static void store( volatile type* ptr, type value )
+                {
+                    __iso_volatile_store32( reinterpret_cast<volatile int*>( ptr ), value );
+                }
+
+                static type exchange( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchange( ptr, value );
+                }
+
+                static type compare_exchange( volatile type* ptr, type desired, type expected )
+                {
+                    return _InterlockedCompareExchange( ptr, desired, expected );
+                }
+
+                static type fetch_add( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchangeAdd( ptr, value );
+                }
+            };
+
+            template<>
+            struct interlocked<8>
+            {
+                using type = __int64;
+
+                // NOTE: The compiler loads and stores 64-bit volatile values with the single
+                // SSE2 or x87 instruction on x86
+                static type load( const volatile type* ptr )
+                {
+                    return __iso_volatile_load64( ptr );
+                }
+
+                static void store( volatile type* ptr, type value )
+                {
+                    __iso_volatile_store64( ptr, value );
+                }
+
+                static type compare_exchange( volatile type* ptr, type desired, type expected )
+                {
+                    return _InterlockedCompareExchange64( ptr, desired, expected );
+                }
+
+    #if defined( _M_X64 ) || defined( _M_ARM64 )
+                static type exchange( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchange64( ptr, value );
+                }
+
+                static type fetch_add( volatile type* ptr, type value )
+                {
+                    return _InterlockedExchangeAdd64( ptr, value );
+                }
+    #else
+                // NOTE: There are no 64-bit exchange and add intrinsics on x86, CMPXCHG8B loops
+                // do the same
+                static type exchange( volatile type* ptr, type value )
+                {
+                    type current = load( ptr );
+
+                    for ( ;; )
+                    {
+                        const type previous = compare_exchange( ptr, value, current );
+                        if ( previous == current )
+                            return previous;
+
+                        current = previous;
+                    }
+                }
+
+                static type fetch_add( volatile type* ptr, type value )
+                {
+                    type current = load( ptr );
+
+                    for ( ;; )
+                    {
+                        const type previous = compare_exchange( ptr, current + value, current );
+                        if ( previous == current )
+                            return previous;
+
+                        current = previous;
+                    }
+                }
+    #endif
+            };
+
+            template<typename T>
+            using native = typename interlocked<sizeof( T )>::type;
+
+            template<typename T>
+            [[nodiscard]] native<T> to_native( T value )
+            {
+                if constexpr ( is_pointer<T>::value )
+                    return reinterpret_cast<native<T>>( value );
+                else
+                    return static_cast<native<T>>( value );
+            }
+
+            template<typename T>
+            [[nodiscard]] T from_native( native<T> value )
+            {
+                if constexpr ( is_pointer<T>::value )
+                    return reinterpret_cast<T>( value );
+                else
+                    return static_cast<T>( value );
+            }
+#endif
+        } // namespace atomics
+    }     // namespace impl
+
+    // Atomic integer or pointer. Unlike std::atomic, objects of other types are not supported,
+    // so all operations are lock-free.
+    template<typename T>
+    class atomic final
+    {
+        static_assert( ( is_integral<T>::value || is_pointer<T>::value )
+                           && !is_same<typename remove_cv<T>::type, bool>::value,
+                       "Only integers and pointers are supported" );
+
+        static_assert( sizeof( T ) == 1 || sizeof( T ) == 2 || sizeof( T ) == 4
+                       || sizeof( T ) == 8 );
+
+    public:
+        using value_type = T;
+        using difference_type = typename conditional<is_pointer<T>::value, ptrdiff_t, T>::type;
+
+        static constexpr bool is_always_lock_free = true;
+
+        constexpr atomic()
+            : m_value()
+        {
+        }
+
+        // cppcheck-suppress noExplicitConstructor
+        constexpr atomic( T value )
+            : m_value( value )
+        {
+        }
+
+        atomic( const atomic& ) = delete;
+        atomic& operator=( const atomic& ) = delete;
+
+        [[nodiscard]] T load( memory_order order = memory_order::seq_cst ) const
+        {
+#if defined( _MSC_VER )
+            const T value = impl::atomics::from_native<T>( ops::load( native_ptr() ) );
+
+            if ( order != memory_order::relaxed )
+                impl::atomics::barrier();
+
+            return value;
+#else
+            return __atomic_load_n( &m_value, static_cast<int>( order ) );
+#endif
+        }
+
+        void store( T value, memory_order order = memory_order::seq_cst )
+        {
+#if defined( _MSC_VER )
+            // NOTE: The CPU may move a load above an earlier store, only an interlocked
+            // instruction keeps the sequential consistency
+            if ( order == memory_order::seq_cst )
+            {
+                exchange( value );
+                return;
+            }
+
+            if ( order != memory_order::relaxed )
+                impl::atomics::barrier();
+
+            ops::store( native_ptr(), impl::atomics::to_native( value ) );
+#else
+            __atomic_store_n( &m_value, value, static_cast<int>( order ) );
+#endif
+        }
+
+        T exchange( T value, memory_order order = memory_order::seq_cst )
+        {
+#if defined( _MSC_VER )
+            static_cast<void>( order );
+            return impl::atomics::from_native<T>(
+                ops::exchange( native_ptr(), impl::atomics::to_native( value ) ) );
+#else
+            return __atomic_exchange_n( &m_value, value, static_cast<int>( order ) );
+#endif
+        }
+
+        // NOTE: If the value is not \expected, writes the current value to \expected
+        bool compare_exchange_strong( T&           expected,
+                                      T            desired,
+                                      memory_order success,
+                                      memory_order failure )
+        {
+#if defined( _MSC_VER )
+            static_cast<void>( success );
+            static_cast<void>( failure );
+
+            const auto native_expected = impl::atomics::to_native( expected );
+            const auto previous = ops::compare_exchange(
+                native_ptr(), impl::atomics::to_native( desired ), native_expected );
+
+            if ( previous == native_expected )
+                return true;
+
+            expected = impl::atomics::from_native<T>( previous );
+            return false;
+#else
+            return __atomic_compare_exchange_n( &m_value,
+                                                &expected,
+                                                desired,
+                                                false,
+                                                static_cast<int>( success ),
+                                                static_cast<int>( failure ) );
+#endif
+        }
+
+        bool compare_exchange_strong( T&           expected,
+                                      T            desired,
+                                      memory_order order = memory_order::seq_cst )
+        {
+            return compare_exchange_strong(
+                expected, desired, order, impl::atomics::failure_order( order ) );
+        }
+
+        // NOTE: Can fail spuriously on LL/SC machines, so it is meant for the retry loops. The
+        // same as the strong one on x86.
+        bool compare_exchange_weak( T&           expected,
+                                    T            desired,
+                                    memory_order success,
+                                    memory_order failure )
+        {
+#if defined( _MSC_VER )
+            return compare_exchange_strong( expected, desired, success, failure );
+#else
+            return __atomic_compare_exchange_n( &m_value,
+                                                &expected,
+                                                desired,
+                                                true,
+                                                static_cast<int>( success ),
+                                                static_cast<int>( failure ) );
+#endif
+        }
+
+        bool compare_exchange_weak( T&           expected,
+                                    T            desired,
+                                    memory_order order = memory_order::seq_cst )
+        {
+            return compare_exchange_weak(
+                expected, desired, order, impl::atomics::failure_order( order ) );
+        }
+
+        // NOTE: Integers wrap around, pointers move by \value elements. Returns the previous
+        // value.
+        T fetch_add( difference_type value, memory_order order = memory_order::seq_cst )
+        {
+            using unsigned_type = typename make_unsigned<difference_type>::type;
+
+            // NOTE: The arithmetic is done on the unsigned type to wrap the signed values around
+            // without the undefined behavior
+            const auto delta = static_cast<difference_type>(
+                static_cast<unsigned_type>( value )
+                * static_cast<unsigned_type>( impl::atomics::step<T>::value ) );
+
+#if defined( _MSC_VER )
+            static_cast<void>( order );
+            return impl::atomics::from_native<T>( ops::fetch_add(
+                native_ptr(), static_cast<impl::atomics::native<T>>( delta ) ) );
+#else
+            return __atomic_fetch_add( &m_value, delta, static_cast<int>( order ) );
+#endif
+        }
+
+        T fetch_sub( difference_type value, memory_order order = memory_order::seq_cst )
+        {
+            using unsigned_type = typename make_unsigned<difference_type>::type;
+
+            return fetch_add(
+                static_cast<difference_type>( 0u - static_cast<unsigned_type>( value ) ), order );
+        }
+
+        operator T() const
+        {
+            return load();
+        }
+
+        T operator=( T value )
+        {
+            store( value );
+            return value;
+        }
+
+        T operator++()
+        {
+            return static_cast<T>( fetch_add( 1 ) + 1 );
+        }
+
+        T operator++( int )
+        {
+            return fetch_add( 1 );
+        }
+
+        T operator--()
+        {
+            return static_cast<T>( fetch_sub( 1 ) - 1 );
+        }
+
+        T operator--( int )
+        {
+            return fetch_sub( 1 );
+        }
+
+        T operator+=( difference_type value )
+        {
+            return static_cast<T>( fetch_add( value ) + value );
+        }
+
+        T operator-=( difference_type value )
+        {
+            return static_cast<T>( fetch_sub( value ) - value );
+        }
+
+    private:
+#if defined( _MSC_VER )
+        using ops = impl::atomics::interlocked<sizeof( T )>;
+
+        volatile typename ops::type* native_ptr() const
+        {
+            return reinterpret_cast<volatile typename ops::type*>(
+                const_cast<typename remove_cv<T>::type*>( &m_value ) );
+        }
+#endif
+
+        // NOTE: 64-bit values are only 4-byte aligned inside the structures on x86, which
+        // breaks the atomicity of their loads and stores
+        alignas( sizeof( T ) ) T m_value;
+    };
+
+    inline void atomic_thread_fence( memory_order order )
+    {
+#if defined( _MSC_VER )
+        if ( order == memory_order::seq_cst )
+        {
+            // NOTE: An interlocked instruction on the stack is a full barrier, on x86 it is
+            // cheaper than MFENCE
+            volatile long guard = 0;
+            _InterlockedIncrement( &guard );
+        }
+        else if ( order != memory_order::relaxed )
+        {
+            impl::atomics::barrier();
+        }
+#else
+        __atomic_thread_fence( static_cast<int>( order ) );
+#endif
+    }
+
+    // Hint to the CPU that the thread is spinning on a shared value: saves power and frees the
+    // core resources for the sibling hyper-thread
+    inline void cpu_relax()
+    {
+#if defined( _M_IX86 ) || defined( _M_X64 )
+        _mm_pause();
+#elif defined( _M_ARM64 )
+        __yield();
+#elif defined( __i386__ ) || defined( __x86_64__ )
+        __builtin_ia32_pause();
+#elif defined( __aarch64__ )
+        __asm__ __volatile__( "yield" );
+#endif
+    }
+} // namespace rtl
@@ -0,0 +1,2188 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/fix.hpp>
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/string.hpp>
+#include <rtl/type_traits.hpp>
+
+namespace rtl
+{
+    enum class errc
+    {
+        ok = 0,
+        invalid_argument = 22,
+        result_out_of_range = 34,
+        value_too_large = 132
+    };
+
+    enum class chars_format
+    {
+        scientific = 1,
+        fixed = 2
+    };
+
+    // NOTE: Unlike std::to_chars_result, the pointer type follows the output buffer, so the same
+    // functions can format directly into a wide string.
+    template<typename Char>
+    struct basic_to_chars_result
+    {
+        Char* ptr;
+        errc  ec;
+    };
+
+    using to_chars_result = basic_to_chars_result<char>;
+
+    template<typename Char>
+    struct basic_from_chars_result
+    {
+        const Char* ptr;
+        errc        ec;
+    };
+
+    using from_chars_result = basic_from_chars_result<char>;
+
+    namespace impl
+    {
+        namespace charconv
+        {
+            constexpr char digit_pairs[201] = "00010203040506070809"
+                                              "10111213141516171819"
+                                              "20212223242526272829"
+                                              "30313233343536373839"
+                                              "40414243444546474849"
+                                              "50515253545556575859"
+                                              "60616263646566676869"
+                                              "70717273747576777879"
+                                              "80818283848586878889"
+                                              "90919293949596979899";
+
+            constexpr char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+            [[nodiscard]] constexpr unsigned count_digits( uint32_t value )
+            {
+                for ( unsigned count = 1;; count += 4, value /= 10000 )
+                {
+                    if ( value < 10 )
+                        return count;
+                    if ( value < 100 )
+                        return count + 1;
+                    if ( value < 1000 )
+                        return count + 2;
+                    if ( value < 10000 )
+                        return count + 3;
+                }
+            }
+
+            // NOTE: The 128-bit products are assembled from 32-bit halves, because there is no
+            // 64x64 multiplication instruction on x86. The compilers with a 128-bit integer type
+            // on the 64-bit targets do it in one instruction.
+            constexpr uint64_t umul128( uint64_t a, uint64_t b, uint64_t* high )
+            {
+#if defined( __SIZEOF_INT128__ )
+                const unsigned __int128 product = static_cast<unsigned __int128>( a ) * b;
+
+                *high = static_cast<uint64_t>( product >> 64 );
+                return static_cast<uint64_t>( product );
+#else
+                const uint32_t a_lo = static_cast<uint32_t>( a );
+                const uint32_t a_hi = static_cast<uint32_t>( a >> 32 );
+                const uint32_t b_lo = static_cast<uint32_t>( b );
+                const uint32_t b_hi = static_cast<uint32_t>( b >> 32 );
+
+                const uint64_t b00 = static_cast<uint64_t>( a_lo ) * b_lo;
+                const uint64_t b01 = static_cast<uint64_t>( a_lo ) * b_hi;
+                const uint64_t b10 = static_cast<uint64_t>( a_hi ) * b_lo;
+                const uint64_t b11 = static_cast<uint64_t>( a_hi ) * b_hi;
+
+                const uint64_t mid1 = b10 + ( b00 >> 32 );
+                const uint64_t mid2 = b01 + static_cast<uint32_t>( mid1 );
+
+                *high = b11 + ( mid1 >> 32 ) + ( mid2 >> 32 );
+                return ( mid2 << 32 ) | static_cast<uint32_t>( b00 );
+#endif
+            }
+
+            [[nodiscard]] constexpr uint64_t umulh( uint64_t a, uint64_t b )
+            {
+                uint64_t high = 0;
+                umul128( a, b, &high );
+                return high;
+            }
+
+            // NOTE: Division by constants via multiplication keeps the 64-bit paths away from the
+            // slow (and CRT provided) 64-bit division helpers on x86.
+            [[nodiscard]] constexpr uint64_t div5( uint64_t x )
+            {
+                return umulh( x, 0xCCCCCCCCCCCCCCCDu ) >> 2;
+            }
+
+            [[nodiscard]] constexpr uint64_t div10( uint64_t x )
+            {
+                return umulh( x, 0xCCCCCCCCCCCCCCCDu ) >> 3;
+            }
+
+            [[nodiscard]] constexpr uint64_t div100( uint64_t x )
+            {
+                return umulh( x >> 2, 0x28F5C28F5C28F5C3u ) >> 2;
+            }
+
+            [[nodiscard]] constexpr uint64_t div1e8( uint64_t x )
+            {
+                return umulh( x, 0xABCC77118461CEFDu ) >> 26;
+            }
+
+            // Writes \value backwards, so that the last digit ends up right before \last.
+            template<typename Char>
+            constexpr void write_digits( Char* last, uint32_t value )
+            {
+                while ( value >= 100 )
+                {
+                    const unsigned pair = ( value % 100 ) * 2;
+                    value /= 100;
+
+                    *--last = static_cast<Char>( digit_pairs[pair + 1] );
+                    *--last = static_cast<Char>( digit_pairs[pair] );
+                }
+
+                if ( value >= 10 )
+                {
+                    *--last = static_cast<Char>( digit_pairs[value * 2 + 1] );
+                    *--last = static_cast<Char>( digit_pairs[value * 2] );
+                }
+                else
+                {
+                    *--last = static_cast<Char>( '0' + value );
+                }
+            }
+
+            // Writes exactly 8 digits of \value (zero padded) backwards, right before \last.
+            template<typename Char>
+            constexpr void write_digits8( Char* last, uint32_t value )
+            {
+                for ( int i = 0; i < 4; ++i )
+                {
+                    const unsigned pair = ( value % 100 ) * 2;
+                    value /= 100;
+
+                    *--last = static_cast<Char>( digit_pairs[pair + 1] );
+                    *--last = static_cast<Char>( digit_pairs[pair] );
+                }
+            }
+
+            // NOTE: The value is split into at most three 32-bit parts, up to 8 decimal digits
+            // each, so that all the digit arithmetic is 32-bit.
+            template<typename Char>
+            [[nodiscard]] constexpr basic_to_chars_result<Char> to_chars_decimal( Char*    first,
+                                                                                  Char*    last,
+                                                                                  uint64_t value )
+            {
+                if ( value <= 0xFFFFFFFFu )
+                {
+                    const uint32_t value32 = static_cast<uint32_t>( value );
+                    const unsigned length = count_digits( value32 );
+
+                    if ( last - first < static_cast<ptrdiff_t>( length ) )
+                        return { last, errc::value_too_large };
+
+                    write_digits( first + length, value32 );
+                    return { first + length, errc::ok };
+                }
+
+                uint64_t       high = div1e8( value );
+                const uint32_t low = static_cast<uint32_t>( value - high * 100000000u );
+
+                if ( high <= 0xFFFFFFFFu )
+                {
+                    const uint32_t high32 = static_cast<uint32_t>( high );
+                    const unsigned length = count_digits( high32 ) + 8;
+
+                    if ( last - first < static_cast<ptrdiff_t>( length ) )
+                        return { last, errc::value_too_large };
+
+                    write_digits8( first + length, low );
+                    write_digits( first + length - 8, high32 );
+                    return { first + length, errc::ok };
+                }
+
+                const uint32_t top = static_cast<uint32_t>( div1e8( high ) );
+                const uint32_t mid = static_cast<uint32_t>( high - top * 100000000ull );
+                const unsigned length = count_digits( top ) + 16;
+
+                if ( last - first < static_cast<ptrdiff_t>( length ) )
+                    return { last, errc::value_too_large };
+
+                write_digits8( first + length, low );
+                write_digits8( first + length - 8, mid );
+                write_digits( first + length - 16, top );
+                return { first + length, errc::ok };
+            }
+
+            template<typename Char, typename U>
+            [[nodiscard]] constexpr basic_to_chars_result<Char>
+            to_chars_unsigned( Char* first, Char* last, U value, unsigned base )
+            {
+                if ( base == 10 )
+                    return to_chars_decimal( first, last, value );
+
+                unsigned length = 0;
+                for ( U rest = value; rest; rest /= base )
+                    ++length;
+
+                if ( length == 0 )
+                    length = 1;
+
+                if ( last - first < static_cast<ptrdiff_t>( length ) )
+                    return { last, errc::value_too_large };
+
+                Char* ptr = first + length;
+                do
+                {
+                    *--ptr = static_cast<Char>( digits[value % base] );
+                    value /= base;
+                } while ( value );
+
+                return { first + length, errc::ok };
+            }
+
+            // Ryu: the shortest decimal representation that round-trips to the same binary
+            // value [Ulf Adams, Ryu: Fast Float-to-String Conversion, PLDI 2018].
+            //
+            // NOTE: The compact variant of the tables is used: powers of 5 are computed from
+            // every 26th entry and a small correction table instead of ~10 KB of full tables.
+            namespace ryu
+            {
+                constexpr int pow5_inv_bitcount = 125;
+                constexpr int pow5_bitcount = 125;
+                constexpr int float_pow5_inv_bitcount = pow5_inv_bitcount - 64;
+                constexpr int float_pow5_bitcount = pow5_bitcount - 64;
+                constexpr int pow5_table_size = 26;
+
+                constexpr uint64_t pow5_table[pow5_table_size] = {
+                1u, 5u, 25u, 125u, 625u, 3125u, 15625u, 78125u, 390625u, 1953125u, 9765625u,
+                48828125u, 244140625u, 1220703125u, 6103515625u, 30517578125u, 152587890625u,
+                762939453125u, 3814697265625u, 19073486328125u, 95367431640625u, 476837158203125u,
+                2384185791015625u, 11920928955078125u, 59604644775390625u, 298023223876953125u,
+                };
+
+                constexpr uint64_t pow5_split2[13][2] = {
+                { 0u, 1152921504606846976u },
+                { 0u, 1490116119384765625u },
+                { 1032610780636961552u, 1925929944387235853u },
+                { 7910200175544436838u, 1244603055572228341u },
+                { 16941905809032713930u, 1608611746708759036u },
+                { 13024893955298202172u, 2079081953128979843u },
+                { 6607496772837067824u, 1343575221513417750u },
+                { 17332926989895652603u, 1736530273035216783u },
+                { 13037379183483547984u, 2244412773384604712u },
+                { 1605989338741628675u, 1450417759929778918u },
+                { 9630225068416591280u, 1874621017369538693u },
+                { 665883850346957067u, 1211445438634777304u },
+                { 14931890668723713708u, 1565756531257009982u },
+                };
+
+                constexpr uint32_t pow5_offsets[21] = {
+                0u, 0u, 0u, 0u, 1073741824u, 1500076437u, 1431590229u, 1448432917u, 1091896580u,
+                1079333904u, 1146442053u, 1146111296u, 1163220304u, 1073758208u, 2521039936u,
+                1431721317u, 1413824581u, 1075134801u, 1431671125u, 1363170645u, 261u,
+                };
+
+                constexpr uint64_t pow5_inv_split2[15][2] = {
+                { 1u, 2305843009213693952u },
+                { 5955668970331000884u, 1784059615882449851u },
+                { 8982663654677661702u, 1380349269358112757u },
+                { 7286864317269821294u, 2135987035920910082u },
+                { 7005857020398200553u, 1652639921975621497u },
+                { 17965325103354776697u, 1278668206209430417u },
+                { 8928596168509315048u, 1978643211784836272u },
+                { 10075671573058298858u, 1530901034580419511u },
+                { 597001226353042382u, 1184477304306571148u },
+                { 1527430471115325346u, 1832889850782397517u },
+                { 12533209867169019542u, 1418129833677084982u },
+                { 5577825024675947042u, 2194449627517475473u },
+                { 11006974540203867551u, 1697873161311732311u },
+                { 10313493231639821582u, 1313665730009899186u },
+                { 12701016819766672773u, 2032799256770390445u },
+                };
+
+                constexpr uint32_t pow5_inv_offsets[22] = {
+                1414808916u, 67458373u, 268701696u, 4195348u, 1073807360u, 1091917141u, 1108u,
+                65604u, 1073741824u, 1140850753u, 1346716752u, 1431634004u, 1365595476u,
+                1073758208u, 16777217u, 66816u, 1364284433u, 89478484u, 1346442496u, 1074003968u,
+                84148496u, 0u,
+                };
+
+                // Returns ceil(log2(5^e)), or 1 if e == 0. Valid for 0 <= e <= 3528.
+                [[nodiscard]] constexpr int pow5bits( int e )
+                {
+                    return static_cast<int>( ( static_cast<uint32_t>( e ) * 1217359 ) >> 19 ) + 1;
+                }
+
+                // Returns floor(log10(2^e)). Valid for 0 <= e <= 1650.
+                [[nodiscard]] constexpr int log10_pow2( int e )
+                {
+                    return static_cast<int>( ( static_cast<uint32_t>( e ) * 78913 ) >> 18 );
+                }
+
+                // Returns floor(log10(5^e)). Valid for 0 <= e <= 2620.
+                [[nodiscard]] constexpr int log10_pow5( int e )
+                {
+                    return static_cast<int>( ( static_cast<uint32_t>( e ) * 732923 ) >> 20 );
+                }
+
+                // NOTE: 0 < dist < 64
+                [[nodiscard]] constexpr uint64_t shiftright128( uint64_t lo, uint64_t hi, int dist )
+                {
+                    return ( hi << ( 64 - dist ) ) | ( lo >> dist );
+                }
+
+                constexpr void compute_pow5( int i, uint64_t* result )
+                {
+                    const int       base = i / pow5_table_size;
+                    const int       base2 = base * pow5_table_size;
+                    const int       offset = i - base2;
+                    const uint64_t* mul = pow5_split2[base];
+
+                    if ( offset == 0 )
+                    {
+                        result[0] = mul[0];
+                        result[1] = mul[1];
+                        return;
+                    }
+
+                    const uint64_t m = pow5_table[offset];
+
+                    uint64_t       high1 = 0;
+                    const uint64_t low1 = umul128( m, mul[1], &high1 );
+                    uint64_t       high0 = 0;
+                    const uint64_t low0 = umul128( m, mul[0], &high0 );
+                    const uint64_t sum = high0 + low1;
+                    if ( sum < high0 )
+                        ++high1;
+
+                    const int      delta = pow5bits( i ) - pow5bits( base2 );
+
+                    result[0] = shiftright128( low0, sum, delta )
+                                + ( ( pow5_offsets[i / 16] >> ( ( i % 16 ) << 1 ) ) & 3 );
+                    result[1] = shiftright128( sum, high1, delta );
+                }
+
+                constexpr void compute_inv_pow5( int i, uint64_t* result )
+                {
+                    const int       base = ( i + pow5_table_size - 1 ) / pow5_table_size;
+                    const int       base2 = base * pow5_table_size;
+                    const int       offset = base2 - i;
+                    const uint64_t* mul = pow5_inv_split2[base];
+
+                    if ( offset == 0 )
+                    {
+                        result[0] = mul[0];
+                        result[1] = mul[1];
+                        return;
+                    }
+
+                    const uint64_t m = pow5_table[offset];
+
+                    uint64_t       high1 = 0;
+                    const uint64_t low1 = umul128( m, mul[1], &high1 );
+                    uint64_t       high0 = 0;
+                    const uint64_t low0 = umul128( m, mul[0] - 1, &high0 );
+                    const uint64_t sum = high0 + low1;
+                    if ( sum < high0 )
+                        ++high1;
+
+                    const int      delta = pow5bits( base2 ) - pow5bits( i );
+
+                    result[0] = shiftright128( low0, sum, delta ) + 1
+                                + ( ( pow5_inv_offsets[i / 16] >> ( ( i % 16 ) << 1 ) ) & 3 );
+                    result[1] = shiftright128( sum, high1, delta );
+                }
+
+                [[nodiscard]] constexpr int pow5_factor( uint64_t value )
+                {
+                    // NOTE: 5 * m_inv_5 = 1 (mod 2^64) and n_div_5 = (2^64 - 1) / 5
+                    constexpr uint64_t m_inv_5 = 14757395258967641293u;
+                    constexpr uint64_t n_div_5 = 3689348814741910323u;
+
+                    int count = 0;
+                    for ( ;; )
+                    {
+                        value *= m_inv_5;
+                        if ( value > n_div_5 )
+                            break;
+                        ++count;
+                    }
+                    return count;
+                }
+
+                [[nodiscard]] constexpr bool multiple_of_pow5( uint64_t value, int p )
+                {
+                    return pow5_factor( value ) >= p;
+                }
+
+                [[nodiscard]] constexpr bool multiple_of_pow2( uint64_t value, int p )
+                {
+                    return ( value & ( ( 1ull << p ) - 1 ) ) == 0;
+                }
+
+                [[nodiscard]] constexpr uint64_t mul_shift64( uint64_t m, const uint64_t* mul,
+                                                              int j )
+                {
+                    uint64_t high1 = 0;
+                    const uint64_t low1 = umul128( m, mul[1], &high1 );
+                    uint64_t high0 = 0;
+                    umul128( m, mul[0], &high0 );
+                    const uint64_t sum = high0 + low1;
+                    if ( sum < high0 )
+                        ++high1;
+                    return shiftright128( sum, high1, j - 64 );
+                }
+
+                [[nodiscard]] constexpr uint32_t mul_shift32( uint32_t m, uint64_t factor,
+                                                              int shift )
+                {
+                    const uint64_t bits0 = static_cast<uint64_t>( m )
+                                           * static_cast<uint32_t>( factor );
+                    const uint64_t bits1 = static_cast<uint64_t>( m )
+                                           * static_cast<uint32_t>( factor >> 32 );
+                    const uint64_t sum = ( bits0 >> 32 ) + bits1;
+                    return static_cast<uint32_t>( sum >> ( shift - 32 ) );
+                }
+
+                [[nodiscard]] constexpr uint32_t mul_pow5_inv_div_pow2( uint32_t m, int q, int j )
+                {
+                    uint64_t pow5[2] = {};
+                    compute_inv_pow5( q, pow5 );
+                    return mul_shift32( m, pow5[1] + 1, j );
+                }
+
+                [[nodiscard]] constexpr uint32_t mul_pow5_div_pow2( uint32_t m, int i, int j )
+                {
+                    uint64_t pow5[2] = {};
+                    compute_pow5( i, pow5 );
+                    return mul_shift32( m, pow5[1], j );
+                }
+
+                struct decimal
+                {
+                    uint64_t mantissa;
+                    int      exponent;
+                };
+
+                [[nodiscard]] constexpr decimal d2d( uint64_t ieee_mantissa,
+                                                     uint32_t ieee_exponent )
+                {
+                    constexpr int mantissa_bits = 52;
+                    constexpr int bias = 1023;
+
+                    int      e2 = 0;
+                    uint64_t m2 = 0;
+
+                    if ( ieee_exponent == 0 )
+                    {
+                        e2 = 1 - bias - mantissa_bits - 2;
+                        m2 = ieee_mantissa;
+                    }
+                    else
+                    {
+                        e2 = static_cast<int>( ieee_exponent ) - bias - mantissa_bits - 2;
+                        m2 = ( 1ull << mantissa_bits ) | ieee_mantissa;
+                    }
+
+                    const bool     accept_bounds = ( m2 & 1 ) == 0;
+                    const uint64_t mv = 4 * m2;
+                    const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+                    uint64_t pow5[2] = {};
+                    uint64_t vr = 0;
+                    uint64_t vp = 0;
+                    uint64_t vm = 0;
+                    int      e10 = 0;
+                    bool     vm_is_trailing_zeros = false;
+                    bool     vr_is_trailing_zeros = false;
+
+                    if ( e2 >= 0 )
+                    {
+                        const int q = log10_pow2( e2 ) - ( e2 > 3 );
+                        const int k = pow5_inv_bitcount + pow5bits( q ) - 1;
+                        const int i = -e2 + q + k;
+
+                        e10 = q;
+                        compute_inv_pow5( q, pow5 );
+                        vr = mul_shift64( 4 * m2, pow5, i );
+                        vp = mul_shift64( 4 * m2 + 2, pow5, i );
+                        vm = mul_shift64( 4 * m2 - 1 - mm_shift, pow5, i );
+
+                        if ( q <= 21 )
+                        {
+                            // NOTE: Only one of mp, mv, and mm can be a multiple of 5, if any
+                            if ( mv - 5 * div5( mv ) == 0 )
+                                vr_is_trailing_zeros = multiple_of_pow5( mv, q );
+                            else if ( accept_bounds )
+                                vm_is_trailing_zeros = multiple_of_pow5( mv - 1 - mm_shift, q );
+                            else
+                                vp -= multiple_of_pow5( mv + 2, q );
+                        }
+                    }
+                    else
+                    {
+                        const int q = log10_pow5( -e2 ) - ( -e2 > 1 );
+                        const int i = -e2 - q;
+                        const int k = pow5bits( i ) - pow5_bitcount;
+                        const int j = q - k;
+
+                        e10 = q + e2;
+                        compute_pow5( i, pow5 );
+                        vr = mul_shift64( 4 * m2, pow5, j );
+                        vp = mul_shift64( 4 * m2 + 2, pow5, j );
+                        vm = mul_shift64( 4 * m2 - 1 - mm_shift, pow5, j );
+
+                        if ( q <= 1 )
+                        {
+                            // NOTE: mv = 4 * m2 always has at least two trailing zero bits
+                            vr_is_trailing_zeros = true;
+                            if ( accept_bounds )
+                                vm_is_trailing_zeros = mm_shift == 1;
+                            else
+                                --vp;
+                        }
+                        else if ( q < 63 )
+                        {
+                            vr_is_trailing_zeros = multiple_of_pow2( mv, q );
+                        }
+                    }
+
+                    int      removed = 0;
+                    uint32_t last_removed_digit = 0;
+                    uint64_t output = 0;
+
+                    if ( vm_is_trailing_zeros || vr_is_trailing_zeros )
+                    {
+                        // NOTE: The general (rare) case
+                        for ( ;; )
+                        {
+                            const uint64_t vp_div10 = div10( vp );
+                            const uint64_t vm_div10 = div10( vm );
+                            if ( vp_div10 <= vm_div10 )
+                                break;
+
+                            const uint64_t vr_div10 = div10( vr );
+
+                            vm_is_trailing_zeros &= vm - 10 * vm_div10 == 0;
+                            vr_is_trailing_zeros &= last_removed_digit == 0;
+                            last_removed_digit = static_cast<uint32_t>( vr - 10 * vr_div10 );
+                            vr = vr_div10;
+                            vp = vp_div10;
+                            vm = vm_div10;
+                            ++removed;
+                        }
+
+                        if ( vm_is_trailing_zeros )
+                        {
+                            for ( ;; )
+                            {
+                                const uint64_t vm_div10 = div10( vm );
+                                if ( vm - 10 * vm_div10 != 0 )
+                                    break;
+
+                                const uint64_t vr_div10 = div10( vr );
+
+                                vr_is_trailing_zeros &= last_removed_digit == 0;
+                                last_removed_digit = static_cast<uint32_t>( vr - 10 * vr_div10 );
+                                vr = vr_div10;
+                                vp = div10( vp );
+                                vm = vm_div10;
+                                ++removed;
+                            }
+                        }
+
+                        // NOTE: Round even if the exact number is .....50..0
+                        if ( vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0 )
+                            last_removed_digit = 4;
+
+                        output = vr
+                                 + ( ( vr == vm && ( !accept_bounds || !vm_is_trailing_zeros ) )
+                                     || last_removed_digit >= 5 );
+                    }
+                    else
+                    {
+                        // NOTE: The common case, about 99.3% of inputs
+                        bool round_up = false;
+
+                        const uint64_t vp_div100 = div100( vp );
+                        const uint64_t vm_div100 = div100( vm );
+                        if ( vp_div100 > vm_div100 )
+                        {
+                            const uint64_t vr_div100 = div100( vr );
+
+                            round_up = vr - 100 * vr_div100 >= 50;
+                            vr = vr_div100;
+                            vp = vp_div100;
+                            vm = vm_div100;
+                            removed += 2;
+                        }
+
+                        for ( ;; )
+                        {
+                            const uint64_t vp_div10 = div10( vp );
+                            const uint64_t vm_div10 = div10( vm );
+                            if ( vp_div10 <= vm_div10 )
+                                break;
+
+                            const uint64_t vr_div10 = div10( vr );
+
+                            round_up = vr - 10 * vr_div10 >= 5;
+                            vr = vr_div10;
+                            vp = vp_div10;
+                            vm = vm_div10;
+                            ++removed;
+                        }
+
+                        output = vr + ( vr == vm || round_up );
+                    }
+
+                    return { output, e10 + removed };
+                }
+
+                [[nodiscard]] constexpr decimal f2d( uint32_t ieee_mantissa,
+                                                     uint32_t ieee_exponent )
+                {
+                    constexpr int mantissa_bits = 23;
+                    constexpr int bias = 127;
+
+                    int      e2 = 0;
+                    uint32_t m2 = 0;
+
+                    if ( ieee_exponent == 0 )
+                    {
+                        e2 = 1 - bias - mantissa_bits - 2;
+                        m2 = ieee_mantissa;
+                    }
+                    else
+                    {
+                        e2 = static_cast<int>( ieee_exponent ) - bias - mantissa_bits - 2;
+                        m2 = ( 1u << mantissa_bits ) | ieee_mantissa;
+                    }
+
+                    const bool     accept_bounds = ( m2 & 1 ) == 0;
+                    const uint32_t mv = 4 * m2;
+                    const uint32_t mp = 4 * m2 + 2;
+                    const uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+                    const uint32_t mm = 4 * m2 - 1 - mm_shift;
+
+                    uint32_t vr = 0;
+                    uint32_t vp = 0;
+                    uint32_t vm = 0;
+                    int      e10 = 0;
+                    bool     vm_is_trailing_zeros = false;
+                    bool     vr_is_trailing_zeros = false;
+                    uint32_t last_removed_digit = 0;
+
+                    if ( e2 >= 0 )
+                    {
+                        const int q = log10_pow2( e2 );
+                        const int k = float_pow5_inv_bitcount + pow5bits( q ) - 1;
+                        const int i = -e2 + q + k;
+
+                        e10 = q;
+                        vr = mul_pow5_inv_div_pow2( mv, q, i );
+                        vp = mul_pow5_inv_div_pow2( mp, q, i );
+                        vm = mul_pow5_inv_div_pow2( mm, q, i );
+
+                        if ( q != 0 && ( vp - 1 ) / 10 <= vm / 10 )
+                        {
+                            // NOTE: The loop below would not remove any digit, so the last
+                            // removed digit has to be computed separately
+                            const int l = float_pow5_inv_bitcount + pow5bits( q - 1 ) - 1;
+                            const int i1 = -e2 + q - 1 + l;
+                            last_removed_digit = mul_pow5_inv_div_pow2( mv, q - 1, i1 ) % 10;
+                        }
+
+                        if ( q <= 9 )
+                        {
+                            if ( mv % 5 == 0 )
+                                vr_is_trailing_zeros = multiple_of_pow5( mv, q );
+                            else if ( accept_bounds )
+                                vm_is_trailing_zeros = multiple_of_pow5( mm, q );
+                            else
+                                vp -= multiple_of_pow5( mp, q );
+                        }
+                    }
+                    else
+                    {
+                        const int q = log10_pow5( -e2 );
+                        const int i = -e2 - q;
+                        const int k = pow5bits( i ) - float_pow5_bitcount;
+                        const int j = q - k;
+
+                        e10 = q + e2;
+                        vr = mul_pow5_div_pow2( mv, i, j );
+                        vp = mul_pow5_div_pow2( mp, i, j );
+                        vm = mul_pow5_div_pow2( mm, i, j );
+
+                        if ( q != 0 && ( vp - 1 ) / 10 <= vm / 10 )
+                        {
+                            const int j1 = q - 1 - ( pow5bits( i + 1 ) - float_pow5_bitcount );
+                            last_removed_digit = mul_pow5_div_pow2( mv, i + 1, j1 ) % 10;
+                        }
+
+                        if ( q <= 1 )
+                        {
+                            vr_is_trailing_zeros = true;
+                            if ( accept_bounds )
+                                vm_is_trailing_zeros = mm_shift == 1;
+                            else
+                                --vp;
+                        }
+                        else if ( q < 31 )
+                        {
+                            vr_is_trailing_zeros = multiple_of_pow2( mv, q - 1 );
+                        }
+                    }
+
+                    int      removed = 0;
+                    uint32_t output = 0;
+
+                    if ( vm_is_trailing_zeros || vr_is_trailing_zeros )
+                    {
+                        while ( vp / 10 > vm / 10 )
+                        {
+                            vm_is_trailing_zeros &= vm % 10 == 0;
+                            vr_is_trailing_zeros &= last_removed_digit == 0;
+                            last_removed_digit = vr % 10;
+                            vr /= 10;
+                            vp /= 10;
+                            vm /= 10;
+                            ++removed;
+                        }
+
+                        if ( vm_is_trailing_zeros )
+                        {
+                            while ( vm % 10 == 0 )
+                            {
+                                vr_is_trailing_zeros &= last_removed_digit == 0;
+                                last_removed_digit = vr % 10;
+                                vr /= 10;
+                                vp /= 10;
+                                vm /= 10;
+                                ++removed;
+                            }
+                        }
+
+                        if ( vr_is_trailing_zeros && last_removed_digit == 5 && vr % 2 == 0 )
+                            last_removed_digit = 4;
+
+                        output = vr
+                                 + ( ( vr == vm && ( !accept_bounds || !vm_is_trailing_zeros ) )
+                                     || last_removed_digit >= 5 );
+                    }
+                    else
+                    {
+                        while ( vp / 10 > vm / 10 )
+                        {
+                            last_removed_digit = vr % 10;
+                            vr /= 10;
+                            vp /= 10;
+                            vm /= 10;
+                            ++removed;
+                        }
+
+                        output = vr + ( vr == vm || last_removed_digit >= 5 );
+                    }
+
+                    return { output, e10 + removed };
+                }
+            } // namespace ryu
+
+            constexpr unsigned format_scientific = 1;
+            constexpr unsigned format_fixed = 2;
+
+            template<typename Char>
+            [[nodiscard]] constexpr Char* copy_chars( Char* first, const char* str, int size )
+            {
+                for ( int i = 0; i < size; ++i )
+                    *first++ = static_cast<Char>( str[i] );
+                return first;
+            }
+
+            template<typename Char>
+            [[nodiscard]] constexpr basic_to_chars_result<Char>
+            write_special( Char* first, Char* last, bool sign, const char* str )
+            {
+                if ( last - first < 3 + sign )
+                    return { last, errc::value_too_large };
+
+                if ( sign )
+                    *first++ = '-';
+                return { copy_chars( first, str, 3 ), errc::ok };
+            }
+
+            // Formats \mantissa * 10^\exponent either in the scientific or in the fixed notation.
+            // If both are allowed by \format, the shorter one is written, fixed on a tie.
+            template<typename Char>
+            [[nodiscard]] constexpr basic_to_chars_result<Char>
+            write_decimal( Char* first, Char* last, bool sign, ryu::decimal value, unsigned format )
+            {
+                char buffer[20] = {};
+
+                const int length
+                    = static_cast<int>( to_chars_decimal( buffer, buffer + 20, value.mantissa ).ptr
+                                        - buffer );
+
+                const int sci_exponent = value.exponent + length - 1;
+                const int sci_exponent_abs = sci_exponent < 0 ? -sci_exponent : sci_exponent;
+                const int sci_length
+                    = length + ( length > 1 ) + 2 + ( sci_exponent_abs >= 100 ? 3 : 2 );
+
+                int fixed_length = 0;
+                if ( value.exponent >= 0 )
+                    fixed_length = length + value.exponent;
+                else if ( length > -value.exponent )
+                    fixed_length = length + 1;
+                else
+                    fixed_length = 2 - value.exponent;
+
+                const bool fixed = ( format & format_fixed )
+                                   && ( !( format & format_scientific )
+                                        || fixed_length <= sci_length );
+                const int total = sign + ( fixed ? fixed_length : sci_length );
+
+                if ( last - first < total )
+                    return { last, errc::value_too_large };
+
+                if ( sign )
+                    *first++ = '-';
+
+                if ( !fixed )
+                {
+                    *first++ = static_cast<Char>( buffer[0] );
+                    if ( length > 1 )
+                    {
+                        *first++ = '.';
+                        first = copy_chars( first, buffer + 1, length - 1 );
+                    }
+
+                    *first++ = 'e';
+                    *first++ = sci_exponent < 0 ? '-' : '+';
+
+                    if ( sci_exponent_abs >= 100 )
+                    {
+                        *first++ = static_cast<Char>( '0' + sci_exponent_abs / 100 );
+                        first = copy_chars(
+                            first, digit_pairs + ( sci_exponent_abs % 100 ) * 2, 2 );
+                    }
+                    else
+                    {
+                        first = copy_chars( first, digit_pairs + sci_exponent_abs * 2, 2 );
+                    }
+
+                    return { first, errc::ok };
+                }
+
+                if ( value.exponent >= 0 )
+                {
+                    first = copy_chars( first, buffer, length );
+                    for ( int i = 0; i < value.exponent; ++i )
+                        *first++ = '0';
+                }
+                else if ( length > -value.exponent )
+                {
+                    const int integer_length = length + value.exponent;
+
+                    first = copy_chars( first, buffer, integer_length );
+                    *first++ = '.';
+                    first = copy_chars( first, buffer + integer_length, -value.exponent );
+                }
+                else
+                {
+                    *first++ = '0';
+                    *first++ = '.';
+                    for ( int i = length; i < -value.exponent; ++i )
+                        *first++ = '0';
+                    first = copy_chars( first, buffer, length );
+                }
+
+                return { first, errc::ok };
+            }
+
+            template<typename Char>
+            [[nodiscard]] inline basic_to_chars_result<Char>
+            to_chars( Char* first, Char* last, double value, unsigned format )
+            {
+                uint64_t bits = 0;
+                memcpy( &bits, &value, sizeof( bits ) );
+
+                const bool     sign = ( bits >> 63 ) != 0;
+                const uint64_t ieee_mantissa = bits & ( ( 1ull << 52 ) - 1 );
+                const uint32_t ieee_exponent = static_cast<uint32_t>( bits >> 52 ) & 0x7FF;
+
+                if ( ieee_exponent == 0x7FF )
+                    return write_special( first, last, sign, ieee_mantissa ? "nan" : "inf" );
+
+                if ( ieee_exponent == 0 && ieee_mantissa == 0 )
+                    return write_decimal( first, last, sign, { 0, 0 }, format );
+
+                return write_decimal( first, last, sign, ryu::d2d( ieee_mantissa, ieee_exponent ),
+                                      format );
+            }
+
+            template<typename Char>
+            [[nodiscard]] inline basic_to_chars_result<Char>
+            to_chars( Char* first, Char* last, float value, unsigned format )
+            {
+                uint32_t bits = 0;
+                memcpy( &bits, &value, sizeof( bits ) );
+
+                const bool     sign = ( bits >> 31 ) != 0;
+                const uint32_t ieee_mantissa = bits & ( ( 1u << 23 ) - 1 );
+                const uint32_t ieee_exponent = ( bits >> 23 ) & 0xFF;
+
+                if ( ieee_exponent == 0xFF )
+                    return write_special( first, last, sign, ieee_mantissa ? "nan" : "inf" );
+
+                if ( ieee_exponent == 0 && ieee_mantissa == 0 )
+                    return write_decimal( first, last, sign, { 0, 0 }, format );
+
+                return write_decimal( first, last, sign, ryu::f2d( ieee_mantissa, ieee_exponent ),
+                                      format );
+            }
+
+            template<typename Char>
+            [[nodiscard]] constexpr unsigned digit_value( Char ch )
+            {
+                if ( ch >= '0' && ch <= '9' )
+                    return static_cast<unsigned>( ch - '0' );
+                if ( ch >= 'a' && ch <= 'z' )
+                    return static_cast<unsigned>( ch - 'a' ) + 10;
+                if ( ch >= 'A' && ch <= 'Z' )
+                    return static_cast<unsigned>( ch - 'A' ) + 10;
+                return 36;
+            }
+
+            // NOTE: SWAR (SIMD within a register): four characters are validated and converted at
+            // once as the byte lanes of a 32-bit word. 32-bit lanes avoid the 64-bit
+            // multiplications, that are library calls on x86.
+            [[nodiscard]] constexpr bool is_four_digits( uint32_t chunk )
+            {
+                return ( ( ( chunk + 0x46464646u ) | ( chunk - 0x30303030u ) ) & 0x80808080u ) == 0;
+            }
+
+            [[nodiscard]] constexpr uint32_t parse_four_digits( uint32_t chunk )
+            {
+                chunk -= 0x30303030u;
+                chunk = chunk * 10 + ( chunk >> 8 );
+                return ( chunk & 0xFF ) * 100 + ( ( chunk >> 16 ) & 0xFF );
+            }
+
+            // Reads eight decimal digits at \ptr. Returns false if any of them is not a digit.
+            template<typename Char>
+            [[nodiscard]] inline bool read_eight_digits( const Char* ptr, uint32_t* value )
+            {
+                static_assert( sizeof( Char ) == 1 );
+
+                uint32_t chunk[2] = {};
+                memcpy( chunk, ptr, sizeof( chunk ) );
+
+                if ( !is_four_digits( chunk[0] ) || !is_four_digits( chunk[1] ) )
+                    return false;
+
+                *value = parse_four_digits( chunk[0] ) * 10000 + parse_four_digits( chunk[1] );
+                return true;
+            }
+
+            // Parses the digits in the given \base up to the first character, that is not a digit.
+            // Returns false if the value does not fit \U, the digits are consumed anyway.
+            template<typename Char, typename U>
+            [[nodiscard]] constexpr bool
+            parse_unsigned( const Char*& first, const Char* last, U& value, unsigned base )
+            {
+                constexpr U max = static_cast<U>( ~U( 0 ) );
+
+                const U        cutoff = base == 10 ? max / 10 : max / base;
+                const unsigned cutlim = static_cast<unsigned>( max - cutoff * base );
+
+                U    result = 0;
+                bool fits = true;
+
+                if constexpr ( sizeof( Char ) == 1 )
+                {
+                    // NOTE: Eight more digits can not overflow the result below this bound.
+                    constexpr U chunk_limit = ( max - 99999999u ) / 100000000u;
+
+                    if ( base == 10 && !rtl::is_constant_evaluated() )
+                    {
+                        uint32_t chunk = 0;
+                        while ( last - first >= 8 && result <= chunk_limit
+                                && read_eight_digits( first, &chunk ) )
+                        {
+                            result = result * 100000000u + chunk;
+                            first += 8;
+                        }
+                    }
+                }
+
+                for ( ; first != last; ++first )
+                {
+                    const unsigned digit = digit_value( *first );
+                    if ( digit >= base )
+                        break;
+
+                    if ( result > cutoff || ( result == cutoff && digit > cutlim ) )
+                        fits = false;
+                    else if ( fits )
+                        result = result * base + digit;
+                }
+
+                value = result;
+                return fits;
+            }
+
+            // NOTE: Wraps around after 19 digits, the caller parses the long numbers again.
+            template<typename Char>
+            [[nodiscard]] constexpr const Char*
+            parse_decimal_digits( const Char* first, const Char* last, uint64_t& value )
+            {
+                if constexpr ( sizeof( Char ) == 1 )
+                {
+                    if ( !rtl::is_constant_evaluated() )
+                    {
+                        uint32_t chunk = 0;
+                        while ( last - first >= 8 && read_eight_digits( first, &chunk ) )
+                        {
+                            value = value * 100000000u + chunk;
+                            first += 8;
+                        }
+                    }
+                }
+
+                for ( ; first != last; ++first )
+                {
+                    const auto digit = static_cast<unsigned>( *first - '0' );
+                    if ( digit >= 10 )
+                        break;
+
+                    value = value * 10 + digit;
+                }
+
+                return first;
+            }
+
+            // A decimal number split into its parts. \mantissa holds the first 19 significant
+            // digits, so that the number is \mantissa * 10^\exponent, unless it is \truncated.
+            template<typename Char>
+            struct decimal_string
+            {
+                uint64_t    mantissa;
+                int         exponent;
+                bool        negative;
+                bool        truncated;
+                const Char* integer;
+                const Char* integer_end;
+                const Char* fraction;
+                const Char* fraction_end;
+                int         explicit_exponent;
+            };
+
+            // Parses a number in the fixed or in the scientific notation. Returns the end of the
+            // number or nullptr, if there are no digits.
+            template<typename Char>
+            [[nodiscard]] constexpr const Char*
+            parse_decimal( const Char* first, const Char* last, decimal_string<Char>& number )
+            {
+                number.negative = first != last && *first == '-';
+                if ( number.negative )
+                    ++first;
+
+                uint64_t mantissa = 0;
+
+                number.integer = first;
+                first = parse_decimal_digits( first, last, mantissa );
+                number.integer_end = first;
+                number.fraction = first;
+                number.fraction_end = first;
+
+                if ( first != last && *first == '.' )
+                {
+                    number.fraction = ++first;
+                    first = parse_decimal_digits( first, last, mantissa );
+                    number.fraction_end = first;
+                }
+
+                const int fraction_size = static_cast<int>( number.fraction_end - number.fraction );
+                int digit_count
+                    = static_cast<int>( number.integer_end - number.integer ) + fraction_size;
+
+                if ( digit_count == 0 )
+                    return nullptr;
+
+                int exponent = 0;
+
+                if ( first != last && ( *first == 'e' || *first == 'E' ) )
+                {
+                    const Char* ptr = first + 1;
+                    const bool  negative = ptr != last && *ptr == '-';
+
+                    if ( ptr != last && ( *ptr == '-' || *ptr == '+' ) )
+                        ++ptr;
+
+                    if ( ptr != last && digit_value( *ptr ) < 10 )
+                    {
+                        for ( ; ptr != last && digit_value( *ptr ) < 10; ++ptr )
+                        {
+                            if ( exponent < 0x10000 )
+                                exponent = exponent * 10 + static_cast<int>( *ptr - '0' );
+                        }
+
+                        first = ptr;
+                        exponent = negative ? -exponent : exponent;
+                    }
+                }
+
+                number.mantissa = mantissa;
+                number.exponent = exponent - fraction_size;
+                number.truncated = false;
+                number.explicit_exponent = exponent;
+
+                if ( digit_count > 19 )
+                {
+                    for ( const Char* ptr = number.integer;
+                          ptr != number.fraction_end && ( *ptr == '0' || *ptr == '.' );
+                          ++ptr )
+                    {
+                        if ( *ptr == '0' )
+                            --digit_count;
+                    }
+                }
+
+                if ( digit_count > 19 )
+                {
+                    constexpr uint64_t nineteen_digits = 1000000000000000000u;
+
+                    const Char* ptr = number.integer;
+
+                    mantissa = 0;
+                    for ( ; mantissa < nineteen_digits && ptr != number.integer_end; ++ptr )
+                        mantissa = mantissa * 10 + static_cast<unsigned>( *ptr - '0' );
+
+                    if ( mantissa >= nineteen_digits )
+                    {
+                        number.exponent = static_cast<int>( number.integer_end - ptr ) + exponent;
+                    }
+                    else
+                    {
+                        ptr = number.fraction;
+                        for ( ; mantissa < nineteen_digits && ptr != number.fraction_end; ++ptr )
+                            mantissa = mantissa * 10 + static_cast<unsigned>( *ptr - '0' );
+
+                        number.exponent = exponent - static_cast<int>( ptr - number.fraction );
+                    }
+
+                    number.mantissa = mantissa;
+                    number.truncated = true;
+                }
+
+                return first;
+            }
+
+            // Matches \word case insensitively. Returns the end of the match or nullptr.
+            template<typename Char>
+            [[nodiscard]] constexpr const Char*
+            match_word( const Char* first, const Char* last, const char* word )
+            {
+                for ( ; *word; ++word, ++first )
+                {
+                    if ( first == last || ( *first | 0x20 ) != *word )
+                        return nullptr;
+                }
+
+                return first;
+            }
+
+            namespace eisel_lemire
+            {
+                constexpr int smallest_power_of_five = -342;
+
+                // NOTE: The upper halves of the 128-bit truncated powers of five 5^q for q in
+                // [-342, 308], normalized so that the most significant bit is set. The lower halves
+                // are not stored: the few products that would need them take the slow path.
+                constexpr uint64_t power_of_five[651] = {
+                    0xEEF453D6923BD65Au, 0x9558B4661B6565F8u, 0xBAAEE17FA23EBF76u,
+                    0xE95A99DF8ACE6F53u, 0x91D8A02BB6C10594u, 0xB64EC836A47146F9u,
+                    0xE3E27A444D8D98B7u, 0x8E6D8C6AB0787F72u, 0xB208EF855C969F4Fu,
+                    0xDE8B2B66B3BC4723u, 0x8B16FB203055AC76u, 0xADDCB9E83C6B1793u,
+                    0xD953E8624B85DD78u, 0x87D4713D6F33AA6Bu, 0xA9C98D8CCB009506u,
+                    0xD43BF0EFFDC0BA48u, 0x84A57695FE98746Du, 0xA5CED43B7E3E9188u,
+                    0xCF42894A5DCE35EAu, 0x818995CE7AA0E1B2u, 0xA1EBFB4219491A1Fu,
+                    0xCA66FA129F9B60A6u, 0xFD00B897478238D0u, 0x9E20735E8CB16382u,
+                    0xC5A890362FDDBC62u, 0xF712B443BBD52B7Bu, 0x9A6BB0AA55653B2Du,
+                    0xC1069CD4EABE89F8u, 0xF148440A256E2C76u, 0x96CD2A865764DBCAu,
+                    0xBC807527ED3E12BCu, 0xEBA09271E88D976Bu, 0x93445B8731587EA3u,
+                    0xB8157268FDAE9E4Cu, 0xE61ACF033D1A45DFu, 0x8FD0C16206306BABu,
+                    0xB3C4F1BA87BC8696u, 0xE0B62E2929ABA83Cu, 0x8C71DCD9BA0B4925u,
+                    0xAF8E5410288E1B6Fu, 0xDB71E91432B1A24Au, 0x892731AC9FAF056Eu,
+                    0xAB70FE17C79AC6CAu, 0xD64D3D9DB981787Du, 0x85F0468293F0EB4Eu,
+                    0xA76C582338ED2621u, 0xD1476E2C07286FAAu, 0x82CCA4DB847945CAu,
+                    0xA37FCE126597973Cu, 0xCC5FC196FEFD7D0Cu, 0xFF77B1FCBEBCDC4Fu,
+                    0x9FAACF3DF73609B1u, 0xC795830D75038C1Du, 0xF97AE3D0D2446F25u,
+                    0x9BECCE62836AC577u, 0xC2E801FB244576D5u, 0xF3A20279ED56D48Au,
+                    0x9845418C345644D6u, 0xBE5691EF416BD60Cu, 0xEDEC366B11C6CB8Fu,
+                    0x94B3A202EB1C3F39u, 0xB9E08A83A5E34F07u, 0xE858AD248F5C22C9u,
+                    0x91376C36D99995BEu, 0xB58547448FFFFB2Du, 0xE2E69915B3FFF9F9u,
+                    0x8DD01FAD907FFC3Bu, 0xB1442798F49FFB4Au, 0xDD95317F31C7FA1Du,
+                    0x8A7D3EEF7F1CFC52u, 0xAD1C8EAB5EE43B66u, 0xD863B256369D4A40u,
+                    0x873E4F75E2224E68u, 0xA90DE3535AAAE202u, 0xD3515C2831559A83u,
+                    0x8412D9991ED58091u, 0xA5178FFF668AE0B6u, 0xCE5D73FF402D98E3u,
+                    0x80FA687F881C7F8Eu, 0xA139029F6A239F72u, 0xC987434744AC874Eu,
+                    0xFBE9141915D7A922u, 0x9D71AC8FADA6C9B5u, 0xC4CE17B399107C22u,
+                    0xF6019DA07F549B2Bu, 0x99C102844F94E0FBu, 0xC0314325637A1939u,
+                    0xF03D93EEBC589F88u, 0x96267C7535B763B5u, 0xBBB01B9283253CA2u,
+                    0xEA9C227723EE8BCBu, 0x92A1958A7675175Fu, 0xB749FAED14125D36u,
+                    0xE51C79A85916F484u, 0x8F31CC0937AE58D2u, 0xB2FE3F0B8599EF07u,
+                    0xDFBDCECE67006AC9u, 0x8BD6A141006042BDu, 0xAECC49914078536Du,
+                    0xDA7F5BF590966848u, 0x888F99797A5E012Du, 0xAAB37FD7D8F58178u,
+                    0xD5605FCDCF32E1D6u, 0x855C3BE0A17FCD26u, 0xA6B34AD8C9DFC06Fu,
+                    0xD0601D8EFC57B08Bu, 0x823C12795DB6CE57u, 0xA2CB1717B52481EDu,
+                    0xCB7DDCDDA26DA268u, 0xFE5D54150B090B02u, 0x9EFA548D26E5A6E1u,
+                    0xC6B8E9B0709F109Au, 0xF867241C8CC6D4C0u, 0x9B407691D7FC44F8u,
+                    0xC21094364DFB5636u, 0xF294B943E17A2BC4u, 0x979CF3CA6CEC5B5Au,
+                    0xBD8430BD08277231u, 0xECE53CEC4A314EBDu, 0x940F4613AE5ED136u,
+                    0xB913179899F68584u, 0xE757DD7EC07426E5u, 0x9096EA6F3848984Fu,
+                    0xB4BCA50B065ABE63u, 0xE1EBCE4DC7F16DFBu, 0x8D3360F09CF6E4BDu,
+                    0xB080392CC4349DECu, 0xDCA04777F541C567u, 0x89E42CAAF9491B60u,
+                    0xAC5D37D5B79B6239u, 0xD77485CB25823AC7u, 0x86A8D39EF77164BCu,
+                    0xA8530886B54DBDEBu, 0xD267CAA862A12D66u, 0x8380DEA93DA4BC60u,
+                    0xA46116538D0DEB78u, 0xCD795BE870516656u, 0x806BD9714632DFF6u,
+                    0xA086CFCD97BF97F3u, 0xC8A883C0FDAF7DF0u, 0xFAD2A4B13D1B5D6Cu,
+                    0x9CC3A6EEC6311A63u, 0xC3F490AA77BD60FCu, 0xF4F1B4D515ACB93Bu,
+                    0x991711052D8BF3C5u, 0xBF5CD54678EEF0B6u, 0xEF340A98172AACE4u,
+                    0x9580869F0E7AAC0Eu, 0xBAE0A846D2195712u, 0xE998D258869FACD7u,
+                    0x91FF83775423CC06u, 0xB67F6455292CBF08u, 0xE41F3D6A7377EECAu,
+                    0x8E938662882AF53Eu, 0xB23867FB2A35B28Du, 0xDEC681F9F4C31F31u,
+                    0x8B3C113C38F9F37Eu, 0xAE0B158B4738705Eu, 0xD98DDAEE19068C76u,
+                    0x87F8A8D4CFA417C9u, 0xA9F6D30A038D1DBCu, 0xD47487CC8470652Bu,
+                    0x84C8D4DFD2C63F3Bu, 0xA5FB0A17C777CF09u, 0xCF79CC9DB955C2CCu,
+                    0x81AC1FE293D599BFu, 0xA21727DB38CB002Fu, 0xCA9CF1D206FDC03Bu,
+                    0xFD442E4688BD304Au, 0x9E4A9CEC15763E2Eu, 0xC5DD44271AD3CDBAu,
+                    0xF7549530E188C128u, 0x9A94DD3E8CF578B9u, 0xC13A148E3032D6E7u,
+                    0xF18899B1BC3F8CA1u, 0x96F5600F15A7B7E5u, 0xBCB2B812DB11A5DEu,
+                    0xEBDF661791D60F56u, 0x936B9FCEBB25C995u, 0xB84687C269EF3BFBu,
+                    0xE65829B3046B0AFAu, 0x8FF71A0FE2C2E6DCu, 0xB3F4E093DB73A093u,
+                    0xE0F218B8D25088B8u, 0x8C974F7383725573u, 0xAFBD2350644EEACFu,
+                    0xDBAC6C247D62A583u, 0x894BC396CE5DA772u, 0xAB9EB47C81F5114Fu,
+                    0xD686619BA27255A2u, 0x8613FD0145877585u, 0xA798FC4196E952E7u,
+                    0xD17F3B51FCA3A7A0u, 0x82EF85133DE648C4u, 0xA3AB66580D5FDAF5u,
+                    0xCC963FEE10B7D1B3u, 0xFFBBCFE994E5C61Fu, 0x9FD561F1FD0F9BD3u,
+                    0xC7CABA6E7C5382C8u, 0xF9BD690A1B68637Bu, 0x9C1661A651213E2Du,
+                    0xC31BFA0FE5698DB8u, 0xF3E2F893DEC3F126u, 0x986DDB5C6B3A76B7u,
+                    0xBE89523386091465u, 0xEE2BA6C0678B597Fu, 0x94DB483840B717EFu,
+                    0xBA121A4650E4DDEBu, 0xE896A0D7E51E1566u, 0x915E2486EF32CD60u,
+                    0xB5B5ADA8AAFF80B8u, 0xE3231912D5BF60E6u, 0x8DF5EFABC5979C8Fu,
+                    0xB1736B96B6FD83B3u, 0xDDD0467C64BCE4A0u, 0x8AA22C0DBEF60EE4u,
+                    0xAD4AB7112EB3929Du, 0xD89D64D57A607744u, 0x87625F056C7C4A8Bu,
+                    0xA93AF6C6C79B5D2Du, 0xD389B47879823479u, 0x843610CB4BF160CBu,
+                    0xA54394FE1EEDB8FEu, 0xCE947A3DA6A9273Eu, 0x811CCC668829B887u,
+                    0xA163FF802A3426A8u, 0xC9BCFF6034C13052u, 0xFC2C3F3841F17C67u,
+                    0x9D9BA7832936EDC0u, 0xC5029163F384A931u, 0xF64335BCF065D37Du,
+                    0x99EA0196163FA42Eu, 0xC06481FB9BCF8D39u, 0xF07DA27A82C37088u,
+                    0x964E858C91BA2655u, 0xBBE226EFB628AFEAu, 0xEADAB0ABA3B2DBE5u,
+                    0x92C8AE6B464FC96Fu, 0xB77ADA0617E3BBCBu, 0xE55990879DDCAABDu,
+                    0x8F57FA54C2A9EAB6u, 0xB32DF8E9F3546564u, 0xDFF9772470297EBDu,
+                    0x8BFBEA76C619EF36u, 0xAEFAE51477A06B03u, 0xDAB99E59958885C4u,
+                    0x88B402F7FD75539Bu, 0xAAE103B5FCD2A881u, 0xD59944A37C0752A2u,
+                    0x857FCAE62D8493A5u, 0xA6DFBD9FB8E5B88Eu, 0xD097AD07A71F26B2u,
+                    0x825ECC24C873782Fu, 0xA2F67F2DFA90563Bu, 0xCBB41EF979346BCAu,
+                    0xFEA126B7D78186BCu, 0x9F24B832E6B0F436u, 0xC6EDE63FA05D3143u,
+                    0xF8A95FCF88747D94u, 0x9B69DBE1B548CE7Cu, 0xC24452DA229B021Bu,
+                    0xF2D56790AB41C2A2u, 0x97C560BA6B0919A5u, 0xBDB6B8E905CB600Fu,
+                    0xED246723473E3813u, 0x9436C0760C86E30Bu, 0xB94470938FA89BCEu,
+                    0xE7958CB87392C2C2u, 0x90BD77F3483BB9B9u, 0xB4ECD5F01A4AA828u,
+                    0xE2280B6C20DD5232u, 0x8D590723948A535Fu, 0xB0AF48EC79ACE837u,
+                    0xDCDB1B2798182244u, 0x8A08F0F8BF0F156Bu, 0xAC8B2D36EED2DAC5u,
+                    0xD7ADF884AA879177u, 0x86CCBB52EA94BAEAu, 0xA87FEA27A539E9A5u,
+                    0xD29FE4B18E88640Eu, 0x83A3EEEEF9153E89u, 0xA48CEAAAB75A8E2Bu,
+                    0xCDB02555653131B6u, 0x808E17555F3EBF11u, 0xA0B19D2AB70E6ED6u,
+                    0xC8DE047564D20A8Bu, 0xFB158592BE068D2Eu, 0x9CED737BB6C4183Du,
+                    0xC428D05AA4751E4Cu, 0xF53304714D9265DFu, 0x993FE2C6D07B7FABu,
+                    0xBF8FDB78849A5F96u, 0xEF73D256A5C0F77Cu, 0x95A8637627989AADu,
+                    0xBB127C53B17EC159u, 0xE9D71B689DDE71AFu, 0x9226712162AB070Du,
+                    0xB6B00D69BB55C8D1u, 0xE45C10C42A2B3B05u, 0x8EB98A7A9A5B04E3u,
+                    0xB267ED1940F1C61Cu, 0xDF01E85F912E37A3u, 0x8B61313BBABCE2C6u,
+                    0xAE397D8AA96C1B77u, 0xD9C7DCED53C72255u, 0x881CEA14545C7575u,
+                    0xAA242499697392D2u, 0xD4AD2DBFC3D07787u, 0x84EC3C97DA624AB4u,
+                    0xA6274BBDD0FADD61u, 0xCFB11EAD453994BAu, 0x81CEB32C4B43FCF4u,
+                    0xA2425FF75E14FC31u, 0xCAD2F7F5359A3B3Eu, 0xFD87B5F28300CA0Du,
+                    0x9E74D1B791E07E48u, 0xC612062576589DDAu, 0xF79687AED3EEC551u,
+                    0x9ABE14CD44753B52u, 0xC16D9A0095928A27u, 0xF1C90080BAF72CB1u,
+                    0x971DA05074DA7BEEu, 0xBCE5086492111AEAu, 0xEC1E4A7DB69561A5u,
+                    0x9392EE8E921D5D07u, 0xB877AA3236A4B449u, 0xE69594BEC44DE15Bu,
+                    0x901D7CF73AB0ACD9u, 0xB424DC35095CD80Fu, 0xE12E13424BB40E13u,
+                    0x8CBCCC096F5088CBu, 0xAFEBFF0BCB24AAFEu, 0xDBE6FECEBDEDD5BEu,
+                    0x89705F4136B4A597u, 0xABCC77118461CEFCu, 0xD6BF94D5E57A42BCu,
+                    0x8637BD05AF6C69B5u, 0xA7C5AC471B478423u, 0xD1B71758E219652Bu,
+                    0x83126E978D4FDF3Bu, 0xA3D70A3D70A3D70Au, 0xCCCCCCCCCCCCCCCCu,
+                    0x8000000000000000u, 0xA000000000000000u, 0xC800000000000000u,
+                    0xFA00000000000000u, 0x9C40000000000000u, 0xC350000000000000u,
+                    0xF424000000000000u, 0x9896800000000000u, 0xBEBC200000000000u,
+                    0xEE6B280000000000u, 0x9502F90000000000u, 0xBA43B74000000000u,
+                    0xE8D4A51000000000u, 0x9184E72A00000000u, 0xB5E620F480000000u,
+                    0xE35FA931A0000000u, 0x8E1BC9BF04000000u, 0xB1A2BC2EC5000000u,
+                    0xDE0B6B3A76400000u, 0x8AC7230489E80000u, 0xAD78EBC5AC620000u,
+                    0xD8D726B7177A8000u, 0x878678326EAC9000u, 0xA968163F0A57B400u,
+                    0xD3C21BCECCEDA100u, 0x84595161401484A0u, 0xA56FA5B99019A5C8u,
+                    0xCECB8F27F4200F3Au, 0x813F3978F8940984u, 0xA18F07D736B90BE5u,
+                    0xC9F2C9CD04674EDEu, 0xFC6F7C4045812296u, 0x9DC5ADA82B70B59Du,
+                    0xC5371912364CE305u, 0xF684DF56C3E01BC6u, 0x9A130B963A6C115Cu,
+                    0xC097CE7BC90715B3u, 0xF0BDC21ABB48DB20u, 0x96769950B50D88F4u,
+                    0xBC143FA4E250EB31u, 0xEB194F8E1AE525FDu, 0x92EFD1B8D0CF37BEu,
+                    0xB7ABC627050305ADu, 0xE596B7B0C643C719u, 0x8F7E32CE7BEA5C6Fu,
+                    0xB35DBF821AE4F38Bu, 0xE0352F62A19E306Eu, 0x8C213D9DA502DE45u,
+                    0xAF298D050E4395D6u, 0xDAF3F04651D47B4Cu, 0x88D8762BF324CD0Fu,
+                    0xAB0E93B6EFEE0053u, 0xD5D238A4ABE98068u, 0x85A36366EB71F041u,
+                    0xA70C3C40A64E6C51u, 0xD0CF4B50CFE20765u, 0x82818F1281ED449Fu,
+                    0xA321F2D7226895C7u, 0xCBEA6F8CEB02BB39u, 0xFEE50B7025C36A08u,
+                    0x9F4F2726179A2245u, 0xC722F0EF9D80AAD6u, 0xF8EBAD2B84E0D58Bu,
+                    0x9B934C3B330C8577u, 0xC2781F49FFCFA6D5u, 0xF316271C7FC3908Au,
+                    0x97EDD871CFDA3A56u, 0xBDE94E8E43D0C8ECu, 0xED63A231D4C4FB27u,
+                    0x945E455F24FB1CF8u, 0xB975D6B6EE39E436u, 0xE7D34C64A9C85D44u,
+                    0x90E40FBEEA1D3A4Au, 0xB51D13AEA4A488DDu, 0xE264589A4DCDAB14u,
+                    0x8D7EB76070A08AECu, 0xB0DE65388CC8ADA8u, 0xDD15FE86AFFAD912u,
+                    0x8A2DBF142DFCC7ABu, 0xACB92ED9397BF996u, 0xD7E77A8F87DAF7FBu,
+                    0x86F0AC99B4E8DAFDu, 0xA8ACD7C0222311BCu, 0xD2D80DB02AABD62Bu,
+                    0x83C7088E1AAB65DBu, 0xA4B8CAB1A1563F52u, 0xCDE6FD5E09ABCF26u,
+                    0x80B05E5AC60B6178u, 0xA0DC75F1778E39D6u, 0xC913936DD571C84Cu,
+                    0xFB5878494ACE3A5Fu, 0x9D174B2DCEC0E47Bu, 0xC45D1DF942711D9Au,
+                    0xF5746577930D6500u, 0x9968BF6ABBE85F20u, 0xBFC2EF456AE276E8u,
+                    0xEFB3AB16C59B14A2u, 0x95D04AEE3B80ECE5u, 0xBB445DA9CA61281Fu,
+                    0xEA1575143CF97226u, 0x924D692CA61BE758u, 0xB6E0C377CFA2E12Eu,
+                    0xE498F455C38B997Au, 0x8EDF98B59A373FECu, 0xB2977EE300C50FE7u,
+                    0xDF3D5E9BC0F653E1u, 0x8B865B215899F46Cu, 0xAE67F1E9AEC07187u,
+                    0xDA01EE641A708DE9u, 0x884134FE908658B2u, 0xAA51823E34A7EEDEu,
+                    0xD4E5E2CDC1D1EA96u, 0x850FADC09923329Eu, 0xA6539930BF6BFF45u,
+                    0xCFE87F7CEF46FF16u, 0x81F14FAE158C5F6Eu, 0xA26DA3999AEF7749u,
+                    0xCB090C8001AB551Cu, 0xFDCB4FA002162A63u, 0x9E9F11C4014DDA7Eu,
+                    0xC646D63501A1511Du, 0xF7D88BC24209A565u, 0x9AE757596946075Fu,
+                    0xC1A12D2FC3978937u, 0xF209787BB47D6B84u, 0x9745EB4D50CE6332u,
+                    0xBD176620A501FBFFu, 0xEC5D3FA8CE427AFFu, 0x93BA47C980E98CDFu,
+                    0xB8A8D9BBE123F017u, 0xE6D3102AD96CEC1Du, 0x9043EA1AC7E41392u,
+                    0xB454E4A179DD1877u, 0xE16A1DC9D8545E94u, 0x8CE2529E2734BB1Du,
+                    0xB01AE745B101E9E4u, 0xDC21A1171D42645Du, 0x899504AE72497EBAu,
+                    0xABFA45DA0EDBDE69u, 0xD6F8D7509292D603u, 0x865B86925B9BC5C2u,
+                    0xA7F26836F282B732u, 0xD1EF0244AF2364FFu, 0x8335616AED761F1Fu,
+                    0xA402B9C5A8D3A6E7u, 0xCD036837130890A1u, 0x802221226BE55A64u,
+                    0xA02AA96B06DEB0FDu, 0xC83553C5C8965D3Du, 0xFA42A8B73ABBF48Cu,
+                    0x9C69A97284B578D7u, 0xC38413CF25E2D70Du, 0xF46518C2EF5B8CD1u,
+                    0x98BF2F79D5993802u, 0xBEEEFB584AFF8603u, 0xEEAABA2E5DBF6784u,
+                    0x952AB45CFA97A0B2u, 0xBA756174393D88DFu, 0xE912B9D1478CEB17u,
+                    0x91ABB422CCB812EEu, 0xB616A12B7FE617AAu, 0xE39C49765FDF9D94u,
+                    0x8E41ADE9FBEBC27Du, 0xB1D219647AE6B31Cu, 0xDE469FBD99A05FE3u,
+                    0x8AEC23D680043BEEu, 0xADA72CCC20054AE9u, 0xD910F7FF28069DA4u,
+                    0x87AA9AFF79042286u, 0xA99541BF57452B28u, 0xD3FA922F2D1675F2u,
+                    0x847C9B5D7C2E09B7u, 0xA59BC234DB398C25u, 0xCF02B2C21207EF2Eu,
+                    0x8161AFB94B44F57Du, 0xA1BA1BA79E1632DCu, 0xCA28A291859BBF93u,
+                    0xFCB2CB35E702AF78u, 0x9DEFBF01B061ADABu, 0xC56BAEC21C7A1916u,
+                    0xF6C69A72A3989F5Bu, 0x9A3C2087A63F6399u, 0xC0CB28A98FCF3C7Fu,
+                    0xF0FDF2D3F3C30B9Fu, 0x969EB7C47859E743u, 0xBC4665B596706114u,
+                    0xEB57FF22FC0C7959u, 0x9316FF75DD87CBD8u, 0xB7DCBF5354E9BECEu,
+                    0xE5D3EF282A242E81u, 0x8FA475791A569D10u, 0xB38D92D760EC4455u,
+                    0xE070F78D3927556Au, 0x8C469AB843B89562u, 0xAF58416654A6BABBu,
+                    0xDB2E51BFE9D0696Au, 0x88FCF317F22241E2u, 0xAB3C2FDDEEAAD25Au,
+                    0xD60B3BD56A5586F1u, 0x85C7056562757456u, 0xA738C6BEBB12D16Cu,
+                    0xD106F86E69D785C7u, 0x82A45B450226B39Cu, 0xA34D721642B06084u,
+                    0xCC20CE9BD35C78A5u, 0xFF290242C83396CEu, 0x9F79A169BD203E41u,
+                    0xC75809C42C684DD1u, 0xF92E0C3537826145u, 0x9BBCC7A142B17CCBu,
+                    0xC2ABF989935DDBFEu, 0xF356F7EBF83552FEu, 0x98165AF37B2153DEu,
+                    0xBE1BF1B059E9A8D6u, 0xEDA2EE1C7064130Cu, 0x9485D4D1C63E8BE7u,
+                    0xB9A74A0637CE2EE1u, 0xE8111C87C5C1BA99u, 0x910AB1D4DB9914A0u,
+                    0xB54D5E4A127F59C8u, 0xE2A0B5DC971F303Au, 0x8DA471A9DE737E24u,
+                    0xB10D8E1456105DADu, 0xDD50F1996B947518u, 0x8A5296FFE33CC92Fu,
+                    0xACE73CBFDC0BFB7Bu, 0xD8210BEFD30EFA5Au, 0x8714A775E3E95C78u,
+                    0xA8D9D1535CE3B396u, 0xD31045A8341CA07Cu, 0x83EA2B892091E44Du,
+                    0xA4E4B66B68B65D60u, 0xCE1DE40642E3F4B9u, 0x80D2AE83E9CE78F3u,
+                    0xA1075A24E4421730u, 0xC94930AE1D529CFCu, 0xFB9B7CD9A4A7443Cu,
+                    0x9D412E0806E88AA5u, 0xC491798A08A2AD4Eu, 0xF5B5D7EC8ACB58A2u,
+                    0x9991A6F3D6BF1765u, 0xBFF610B0CC6EDD3Fu, 0xEFF394DCFF8A948Eu,
+                    0x95F83D0A1FB69CD9u, 0xBB764C4CA7A4440Fu, 0xEA53DF5FD18D5513u,
+                    0x92746B9BE2F8552Cu, 0xB7118682DBB66A77u, 0xE4D5E82392A40515u,
+                    0x8F05B1163BA6832Du, 0xB2C71D5BCA9023F8u, 0xDF78E4B2BD342CF6u,
+                    0x8BAB8EEFB6409C1Au, 0xAE9672ABA3D0C320u, 0xDA3C0F568CC4F3E8u,
+                    0x8865899617FB1871u, 0xAA7EEBFB9DF9DE8Du, 0xD51EA6FA85785631u,
+                    0x8533285C936B35DEu, 0xA67FF273B8460356u, 0xD01FEF10A657842Cu,
+                    0x8213F56A67F6B29Bu, 0xA298F2C501F45F42u, 0xCB3F2F7642717713u,
+                    0xFE0EFB53D30DD4D7u, 0x9EC95D1463E8A506u, 0xC67BB4597CE2CE48u,
+                    0xF81AA16FDC1B81DAu, 0x9B10A4E5E9913128u, 0xC1D4CE1F63F57D72u,
+                    0xF24A01A73CF2DCCFu, 0x976E41088617CA01u, 0xBD49D14AA79DBC82u,
+                    0xEC9C459D51852BA2u, 0x93E1AB8252F33B45u, 0xB8DA1662E7B00A17u,
+                    0xE7109BFBA19C0C9Du, 0x906A617D450187E2u, 0xB484F9DC9641E9DAu,
+                    0xE1A63853BBD26451u, 0x8D07E33455637EB2u, 0xB049DC016ABC5E5Fu,
+                    0xDC5C5301C56B75F7u, 0x89B9B3E11B6329BAu, 0xAC2820D9623BF429u,
+                    0xD732290FBACAF133u, 0x867F59A9D4BED6C0u, 0xA81F301449EE8C70u,
+                    0xD226FC195C6A2F8Cu, 0x83585D8FD9C25DB7u, 0xA42E74F3D032F525u,
+                    0xCD3A1230C43FB26Fu, 0x80444B5E7AA7CF85u, 0xA0555E361951C366u,
+                    0xC86AB5C39FA63440u, 0xFA856334878FC150u, 0x9C935E00D4B9D8D2u,
+                    0xC3B8358109E84F07u, 0xF4A642E14C6262C8u, 0x98E7E9CCCFBD7DBDu,
+                    0xBF21E44003ACDD2Cu, 0xEEEA5D5004981478u, 0x95527A5202DF0CCBu,
+                    0xBAA718E68396CFFDu, 0xE950DF20247C83FDu, 0x91D28B7416CDD27Eu,
+                    0xB6472E511C81471Du, 0xE3D8F9E563A198E5u, 0x8E679C2F5E44FF8Fu
+                };
+
+                template<typename T>
+                struct binary_format;
+
+                template<>
+                struct binary_format<double>
+                {
+                    using bits_type = uint64_t;
+
+                    static constexpr int mantissa_bits = 52;
+                    static constexpr int minimum_exponent = -1023;
+                    static constexpr int infinite_power = 0x7FF;
+                    static constexpr int min_round_to_even = -4;
+                    static constexpr int max_round_to_even = 23;
+                    static constexpr int smallest_power_of_ten = -342;
+                    static constexpr int largest_power_of_ten = 308;
+                    static constexpr int max_fast_exponent = 22;
+
+                    static constexpr uint64_t max_fast_mantissa = 1ull << 53;
+
+                    static constexpr double fast_powers[] = {
+                        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+                };
+
+                template<>
+                struct binary_format<float>
+                {
+                    using bits_type = uint32_t;
+
+                    static constexpr int mantissa_bits = 23;
+                    static constexpr int minimum_exponent = -127;
+                    static constexpr int infinite_power = 0xFF;
+                    static constexpr int min_round_to_even = -17;
+                    static constexpr int max_round_to_even = 10;
+                    static constexpr int smallest_power_of_ten = -64;
+                    static constexpr int largest_power_of_ten = 38;
+                    static constexpr int max_fast_exponent = 10;
+
+                    static constexpr uint64_t max_fast_mantissa = 1ull << 24;
+
+                    static constexpr float fast_powers[] = {
+                        1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+                };
+
+                struct adjusted_mantissa
+                {
+                    uint64_t mantissa;
+                    int      power2;
+                };
+
+                [[nodiscard]] constexpr bool operator==( const adjusted_mantissa& lhs,
+                                                         const adjusted_mantissa& rhs )
+                {
+                    return lhs.mantissa == rhs.mantissa && lhs.power2 == rhs.power2;
+                }
+
+                [[nodiscard]] constexpr int leading_zeros( uint64_t value )
+                {
+                    int count = 0;
+                    for ( int shift = 32; shift > 0; shift >>= 1 )
+                    {
+                        if ( ( value >> ( 64 - shift ) ) == 0 )
+                        {
+                            value <<= shift;
+                            count += shift;
+                        }
+                    }
+
+                    return count;
+                }
+
+                // Rounds \w * 10^\q to the nearest floating point value, see "Number Parsing at a
+                // Gigabyte per Second" by D. Lemire. Clears \exact, if the truncated product is too
+                // close to a rounding boundary to decide; the result is one ulp off at most then.
+                template<typename T>
+                [[nodiscard]] constexpr adjusted_mantissa
+                compute_float( int q, uint64_t w, bool* exact )
+                {
+                    using format = binary_format<T>;
+
+                    *exact = true;
+
+                    if ( w == 0 || q < format::smallest_power_of_ten )
+                        return { 0, 0 };
+
+                    if ( q > format::largest_power_of_ten )
+                        return { 0, format::infinite_power };
+
+                    const int lz = leading_zeros( w );
+                    w <<= lz;
+
+                    uint64_t       high = 0;
+                    const uint64_t low
+                        = umul128( w, power_of_five[q - smallest_power_of_five], &high );
+
+                    constexpr uint64_t precision_mask = ~0ull >> ( format::mantissa_bits + 3 );
+                    if ( ( high & precision_mask ) == precision_mask )
+                        *exact = false;
+
+                    const int upper_bit = static_cast<int>( high >> 63 );
+                    const int shift = upper_bit + 64 - format::mantissa_bits - 3;
+
+                    uint64_t mantissa = high >> shift;
+                    int      power2 = ( ( ( 152170 + 65536 ) * q ) >> 16 ) + 63 + upper_bit - lz
+                                 - format::minimum_exponent;
+
+                    if ( power2 <= 0 )
+                    {
+                        if ( -power2 + 1 >= 64 )
+                            return { 0, 0 };
+
+                        mantissa >>= -power2 + 1;
+                        mantissa += mantissa & 1;
+                        mantissa >>= 1;
+
+                        // NOTE: Rounding may carry a subnormal value into the smallest normal one.
+                        return { mantissa, mantissa < ( 1ull << format::mantissa_bits ) ? 0 : 1 };
+                    }
+
+                    // NOTE: The product is exact near 10^0, so a value right between two floating
+                    // point values has to be rounded to the even one instead of up.
+                    if ( low <= 1 && q >= format::min_round_to_even
+                         && q <= format::max_round_to_even && ( mantissa & 3 ) == 1
+                         && ( mantissa << shift ) == high )
+                        mantissa &= ~1ull;
+
+                    mantissa += mantissa & 1;
+                    mantissa >>= 1;
+
+                    if ( mantissa >= ( 2ull << format::mantissa_bits ) )
+                    {
+                        mantissa = 1ull << format::mantissa_bits;
+                        ++power2;
+                    }
+
+                    mantissa &= ~( 1ull << format::mantissa_bits );
+
+                    if ( power2 >= format::infinite_power )
+                        return { 0, format::infinite_power };
+
+                    return { mantissa, power2 };
+                }
+            } // namespace eisel_lemire
+
+            // An arbitrary precision unsigned integer for the slow path of the floating point
+            // parsing, that is large enough for the 800 significant digits kept there.
+            class big_integer final
+            {
+            public:
+                constexpr big_integer()
+                    : m_limbs()
+                    , m_size( 0 )
+                {
+                }
+
+                constexpr explicit big_integer( uint64_t value )
+                    : m_limbs()
+                    , m_size( 0 )
+                {
+                    for ( ; value != 0; value >>= 32 )
+                        m_limbs[m_size++] = static_cast<uint32_t>( value );
+                }
+
+                constexpr void multiply_add( uint32_t factor, uint32_t term )
+                {
+                    uint64_t carry = term;
+                    for ( int i = 0; i < m_size; ++i )
+                    {
+                        carry += static_cast<uint64_t>( m_limbs[i] ) * factor;
+                        m_limbs[i] = static_cast<uint32_t>( carry );
+                        carry >>= 32;
+                    }
+
+                    if ( carry != 0 )
+                        m_limbs[m_size++] = static_cast<uint32_t>( carry );
+                }
+
+                constexpr void multiply_pow5( int exponent )
+                {
+                    for ( ; exponent >= 13; exponent -= 13 )
+                        multiply_add( 1220703125u, 0 );
+
+                    uint32_t factor = 1;
+                    for ( ; exponent > 0; --exponent )
+                        factor *= 5;
+
+                    multiply_add( factor, 0 );
+                }
+
+                constexpr void shift_left( int bits )
+                {
+                    if ( m_size == 0 )
+                        return;
+
+                    const int words = bits / 32;
+                    const int shift = bits % 32;
+
+                    if ( shift != 0 )
+                    {
+                        uint32_t carry = 0;
+                        for ( int i = 0; i < m_size; ++i )
+                        {
+                            const uint32_t limb = m_limbs[i];
+                            m_limbs[i] = ( limb << shift ) | carry;
+                            carry = limb >> ( 32 - shift );
+                        }
+
+                        if ( carry != 0 )
+                            m_limbs[m_size++] = carry;
+                    }
+
+                    if ( words != 0 )
+                    {
+                        for ( int i = m_size - 1; i >= 0; --i )
+                            m_limbs[i + words] = m_limbs[i];
+                        for ( int i = 0; i < words; ++i )
+                            m_limbs[i] = 0;
+
+                        m_size += words;
+                    }
+                }
+
+                [[nodiscard]] constexpr int compare( const big_integer& rhs ) const
+                {
+                    if ( m_size != rhs.m_size )
+                        return m_size < rhs.m_size ? -1 : 1;
+
+                    for ( int i = m_size - 1; i >= 0; --i )
+                    {
+                        if ( m_limbs[i] != rhs.m_limbs[i] )
+                            return m_limbs[i] < rhs.m_limbs[i] ? -1 : 1;
+                    }
+
+                    return 0;
+                }
+
+            private:
+                uint32_t m_limbs[128];
+                int      m_size;
+            };
+
+            // The exact significant digits of a decimal number: \digits * 10^\exponent, plus a
+            // nonzero tail past the kept digits, if \sticky.
+            struct big_decimal
+            {
+                big_integer digits;
+                int         exponent;
+                bool        sticky;
+            };
+
+            // NOTE: 767 significant digits are enough to tell any two halfway points between
+            // doubles apart, the rest only matter as a nonzero tail.
+            template<typename Char>
+            [[nodiscard]] constexpr big_decimal to_big_decimal( const decimal_string<Char>& number )
+            {
+                constexpr int max_digits = 800;
+
+                big_decimal result = {};
+
+                uint32_t chunk = 0;
+                uint32_t chunk_scale = 1;
+                int      count = 0;
+                int      kept = 0;
+
+                for ( const Char* ptr = number.integer; ptr != number.fraction_end; ++ptr )
+                {
+                    if ( *ptr == '.' || ( count == 0 && *ptr == '0' ) )
+                        continue;
+
+                    const auto digit = static_cast<uint32_t>( *ptr - '0' );
+                    ++count;
+
+                    if ( kept == max_digits )
+                    {
+                        result.sticky = result.sticky || digit != 0;
+                        continue;
+                    }
+
+                    chunk = chunk * 10 + digit;
+                    chunk_scale *= 10;
+                    ++kept;
+
+                    if ( chunk_scale == 1000000000u )
+                    {
+                        result.digits.multiply_add( chunk_scale, chunk );
+                        chunk = 0;
+                        chunk_scale = 1;
+                    }
+                }
+
+                result.digits.multiply_add( chunk_scale, chunk );
+                result.exponent = number.explicit_exponent
+                                  - static_cast<int>( number.fraction_end - number.fraction )
+                                  + count - kept;
+
+                return result;
+            }
+
+            template<typename T, typename Bits>
+            constexpr void decode_float( Bits bits, uint64_t* mantissa, int* exponent )
+            {
+                using format = eisel_lemire::binary_format<T>;
+
+                constexpr int bias = -format::minimum_exponent + format::mantissa_bits;
+
+                const int biased = static_cast<int>( bits >> format::mantissa_bits );
+
+                *mantissa = bits & ( ( 1ull << format::mantissa_bits ) - 1 );
+                *exponent = biased == 0 ? 1 - bias : biased - bias;
+
+                if ( biased != 0 )
+                    *mantissa |= 1ull << format::mantissa_bits;
+            }
+
+            // Compares the decimal \number with the point halfway between the floating point
+            // values with the representations \bits and \bits + 1.
+            template<typename T, typename Bits>
+            [[nodiscard]] constexpr int compare_halfway( const big_decimal& number, Bits bits )
+            {
+                uint64_t low_mantissa = 0;
+                uint64_t high_mantissa = 0;
+                int      low_exponent = 0;
+                int      high_exponent = 0;
+
+                decode_float<T>( bits, &low_mantissa, &low_exponent );
+                decode_float<T>( static_cast<Bits>( bits + 1 ), &high_mantissa, &high_exponent );
+
+                // NOTE: The halfway point is (low + high) / 2 at the exponent of the lower value.
+                const big_integer halfway(
+                    low_mantissa + ( high_mantissa << ( high_exponent - low_exponent ) ) );
+
+                big_integer lhs = number.digits;
+                big_integer rhs = halfway;
+
+                if ( number.exponent >= 0 )
+                    lhs.multiply_pow5( number.exponent );
+                else
+                    rhs.multiply_pow5( -number.exponent );
+
+                const int shift = number.exponent - ( low_exponent - 1 );
+                if ( shift > 0 )
+                    lhs.shift_left( shift );
+                else
+                    rhs.shift_left( -shift );
+
+                const int result = lhs.compare( rhs );
+                return result == 0 && number.sticky ? 1 : result;
+            }
+
+            // Moves the \candidate representation, that is at most one ulp off, to the correctly
+            // rounded value of the decimal \number with exact big integer comparisons.
+            template<typename T, typename Char, typename Bits>
+            [[nodiscard]] constexpr Bits round_exactly( const decimal_string<Char>& number,
+                                                        Bits                        candidate )
+            {
+                using format = eisel_lemire::binary_format<T>;
+
+                constexpr Bits infinity = static_cast<Bits>( format::infinite_power )
+                                          << format::mantissa_bits;
+
+                const big_decimal decimal = to_big_decimal( number );
+
+                for ( ;; )
+                {
+                    if ( candidate != infinity )
+                    {
+                        const int above = compare_halfway<T>( decimal, candidate );
+                        if ( above > 0 )
+                        {
+                            ++candidate;
+                            continue;
+                        }
+
+                        if ( above == 0 )
+                            return static_cast<Bits>( candidate + ( candidate & 1 ) );
+                    }
+
+                    if ( candidate != 0 )
+                    {
+                        const int below
+                            = compare_halfway<T>( decimal, static_cast<Bits>( candidate - 1 ) );
+                        if ( below < 0 )
+                        {
+                            --candidate;
+                            continue;
+                        }
+
+                        if ( below == 0 )
+                            return static_cast<Bits>( candidate - ( candidate & 1 ) );
+                    }
+
+                    return candidate;
+                }
+            }
+
+            template<typename T, typename Char>
+            [[nodiscard]] inline basic_from_chars_result<Char>
+            parse_special( const Char* first, const Char* last, T& value )
+            {
+                using format = eisel_lemire::binary_format<T>;
+                using bits_type = typename format::bits_type;
+
+                const bool  negative = first != last && *first == '-';
+                const Char* ptr = first + ( negative ? 1 : 0 );
+                bits_type   bits = static_cast<bits_type>( format::infinite_power )
+                                 << format::mantissa_bits;
+
+                if ( const Char* end = match_word( ptr, last, "inf" ) )
+                {
+                    const Char* infinity = match_word( end, last, "inity" );
+                    ptr = infinity ? infinity : end;
+                }
+                else if ( const Char* nan = match_word( ptr, last, "nan" ) )
+                {
+                    bits |= static_cast<bits_type>( 1ull << ( format::mantissa_bits - 1 ) );
+                    ptr = nan;
+
+                    if ( nan != last && *nan == '(' )
+                    {
+                        const Char* end = nan + 1;
+                        while ( end != last
+                                && ( digit_value( *end ) < 36 || *end == '_' ) )
+                            ++end;
+
+                        if ( end != last && *end == ')' )
+                            ptr = end + 1;
+                    }
+                }
+                else
+                {
+                    return { first, errc::invalid_argument };
+                }
+
+                if ( negative )
+                    bits |= static_cast<bits_type>( 1ull << ( sizeof( bits_type ) * 8 - 1 ) );
+
+                memcpy( &value, &bits, sizeof( value ) );
+                return { ptr, errc::ok };
+            }
+
+            template<typename T, typename Char>
+            [[nodiscard]] inline basic_from_chars_result<Char>
+            from_chars( const Char* first, const Char* last, T& value )
+            {
+                using format = eisel_lemire::binary_format<T>;
+                using bits_type = typename format::bits_type;
+
+                decimal_string<Char> number = {};
+
+                const Char* end = parse_decimal( first, last, number );
+                if ( !end )
+                    return parse_special( first, last, value );
+
+                // NOTE: Both the mantissa and the power of ten are exact in T here, so a single
+                // correctly rounded operation gives the correctly rounded result.
+                if ( !number.truncated && number.exponent >= -format::max_fast_exponent
+                     && number.exponent <= format::max_fast_exponent
+                     && number.mantissa <= format::max_fast_mantissa )
+                {
+                    T result = static_cast<T>( number.mantissa );
+
+                    if ( number.exponent < 0 )
+                        result /= format::fast_powers[-number.exponent];
+                    else
+                        result *= format::fast_powers[number.exponent];
+
+                    value = number.negative ? -result : result;
+                    return { end, errc::ok };
+                }
+
+                bool exact = true;
+
+                const eisel_lemire::adjusted_mantissa rounded
+                    = eisel_lemire::compute_float<T>( number.exponent, number.mantissa, &exact );
+
+                // NOTE: The dropped digits of a truncated mantissa matter only if rounding the
+                // next mantissa gives a different value.
+                if ( number.truncated && exact )
+                {
+                    const eisel_lemire::adjusted_mantissa next = eisel_lemire::compute_float<T>(
+                        number.exponent, number.mantissa + 1, &exact );
+
+                    exact = exact && next == rounded;
+                }
+
+                bits_type bits = static_cast<bits_type>(
+                    rounded.mantissa
+                    | ( static_cast<uint64_t>( rounded.power2 ) << format::mantissa_bits ) );
+
+                if ( !exact )
+                    bits = round_exactly<T>( number, bits );
+
+                constexpr bits_type infinity = static_cast<bits_type>( format::infinite_power )
+                                               << format::mantissa_bits;
+
+                if ( bits == infinity || ( bits == 0 && number.mantissa != 0 ) )
+                    return { end, errc::result_out_of_range };
+
+                if ( number.negative )
+                    bits |= static_cast<bits_type>( 1ull << ( sizeof( bits_type ) * 8 - 1 ) );
+
+                memcpy( &value, &bits, sizeof( value ) );
+                return { end, errc::ok };
+            }
+        } // namespace charconv
+    } // namespace impl
+
+    // Converts an integer \value into a character string in the given \base (must be 2..36)
+    // without a terminating null character. Returns value_too_large and \last, if the range is
+    // too small.
+    template<typename Char, typename T>
+    [[nodiscard]] constexpr typename enable_if<
+        is_integral<T>::value && !is_same<typename remove_cv<T>::type, bool>::value,
+        basic_to_chars_result<Char>>::type
+    to_chars( Char* first, Char* last, T value, int base = 10 )
+    {
+        using unsigned_type = typename make_unsigned<T>::type;
+
+        auto magnitude = static_cast<unsigned_type>( value );
+
+        if constexpr ( is_signed<T>::value )
+        {
+            if ( value < 0 )
+            {
+                if ( first == last )
+                    return { last, errc::value_too_large };
+
+                *first++ = '-';
+                magnitude = static_cast<unsigned_type>( 0u - magnitude );
+            }
+        }
+
+        const auto radix = static_cast<unsigned>( base );
+
+        if constexpr ( sizeof( unsigned_type ) > sizeof( uint32_t ) )
+            return impl::charconv::to_chars_unsigned( first, last, magnitude, radix );
+        else
+            return impl::charconv::to_chars_unsigned(
+                first, last, static_cast<uint32_t>( magnitude ), radix );
+    }
+
+    // Converts a floating point \value into the shortest character string, that is parsed back
+    // into exactly the same value, in the fixed or in the scientific notation, whichever is
+    // shorter. Does not depend on a locale and does not allocate.
+    template<typename Char>
+    [[nodiscard]] inline basic_to_chars_result<Char>
+    to_chars( Char* first, Char* last, double value )
+    {
+        return impl::charconv::to_chars( first, last, value,
+                                         impl::charconv::format_scientific
+                                             | impl::charconv::format_fixed );
+    }
+
+    template<typename Char>
+    [[nodiscard]] inline basic_to_chars_result<Char>
+    to_chars( Char* first, Char* last, float value )
+    {
+        return impl::charconv::to_chars( first, last, value,
+                                         impl::charconv::format_scientific
+                                             | impl::charconv::format_fixed );
+    }
+
+    // NOTE: The fixed notation of a large value pads the shortest digits with zeros, so the
+    // result round-trips but is not necessarily the exact decimal expansion of the value.
+    template<typename Char>
+    [[nodiscard]] inline basic_to_chars_result<Char>
+    to_chars( Char* first, Char* last, double value, chars_format format )
+    {
+        return impl::charconv::to_chars( first, last, value, static_cast<unsigned>( format ) );
+    }
+
+    template<typename Char>
+    [[nodiscard]] inline basic_to_chars_result<Char>
+    to_chars( Char* first, Char* last, float value, chars_format format )
+    {
+        return impl::charconv::to_chars( first, last, value, static_cast<unsigned>( format ) );
+    }
+
+    // Parses an integer in the given \base (must be 2..36): an optional minus sign for a signed
+    // \T and the digits, without a base prefix. Returns invalid_argument and \first, if there are
+    // no digits, or result_out_of_range and the end of the digits, if the value does not fit \T.
+    // \value is only modified on success.
+    template<typename Char, typename T>
+    [[nodiscard]] constexpr typename enable_if<
+        is_integral<T>::value && !is_same<typename remove_cv<T>::type, bool>::value,
+        basic_from_chars_result<Char>>::type
+    from_chars( const Char* first, const Char* last, T& value, int base = 10 )
+    {
+        using unsigned_type = typename make_unsigned<T>::type;
+        using parse_type = typename conditional<( sizeof( T ) > sizeof( uint32_t ) ), uint64_t,
+                                                uint32_t>::type;
+
+        const Char* ptr = first;
+        bool        negative = false;
+
+        if constexpr ( is_signed<T>::value )
+        {
+            negative = ptr != last && *ptr == '-';
+            if ( negative )
+                ++ptr;
+        }
+
+        const Char* digits = ptr;
+        parse_type  magnitude = 0;
+
+        const bool fits = impl::charconv::parse_unsigned( ptr, last, magnitude,
+                                                          static_cast<unsigned>( base ) );
+        if ( ptr == digits )
+            return { first, errc::invalid_argument };
+
+        parse_type max = static_cast<unsigned_type>( ~unsigned_type( 0 ) );
+        if constexpr ( is_signed<T>::value )
+            max = ( max >> 1 ) + ( negative ? 1u : 0u );
+
+        if ( !fits || magnitude > max )
+            return { ptr, errc::result_out_of_range };
+
+        value = static_cast<T>( negative ? 0u - magnitude : magnitude );
+        return { ptr, errc::ok };
+    }
+
+    // Parses a floating point number in the fixed or in the scientific notation, or "inf",
+    // "infinity", "nan", "nan(...)" in any case, with an optional minus sign, and rounds it to the
+    // nearest \value, ties to even. Does not depend on a locale and does not allocate. Returns
+    // invalid_argument and \first, if there is no number, or result_out_of_range, if it overflows
+    // or underflows to zero. \value is only modified on success.
+    template<typename Char>
+    [[nodiscard]] inline basic_from_chars_result<Char>
+    from_chars( const Char* first, const Char* last, double& value )
+    {
+        return impl::charconv::from_chars( first, last, value );
+    }
+
+    template<typename Char>
+    [[nodiscard]] inline basic_from_chars_result<Char>
+    from_chars( const Char* first, const Char* last, float& value )
+    {
+        return impl::charconv::from_chars( first, last, value );
+    }
+
+    // Parses a fixed point number: an optional minus sign and the digits with an optional
+    // fraction, without an exponent. The fraction is converted with integer arithmetic and
+    // rounded to the nearest \FractBits binary digits, ties to even; the digits past the 18th only
+    // break the ties. Returns invalid_argument and \first, if there are no digits, or
+    // result_out_of_range, if the number does not fit. \value is only modified on success.
+    template<typename Char, typename Int, int FractBits>
+    [[nodiscard]] constexpr basic_from_chars_result<Char>
+    from_chars( const Char* first, const Char* last, fix<Int, FractBits>& value )
+    {
+        using unsigned_type = typename make_unsigned<Int>::type;
+
+        const Char* ptr = first;
+        const bool  negative = ptr != last && *ptr == '-';
+        if ( negative )
+            ++ptr;
+
+        // NOTE: The most negative value has a larger magnitude than the most positive one.
+        const uint64_t limit
+            = ( static_cast<unsigned_type>( ~unsigned_type( 0 ) ) >> 1 ) + ( negative ? 1u : 0u );
+        const uint64_t integer_limit = limit >> FractBits;
+
+        const Char* digits = ptr;
+        uint64_t    integer = 0;
+        bool        fits = true;
+
+        for ( ; ptr != last && *ptr >= '0' && *ptr <= '9'; ++ptr )
+        {
+            const auto digit = static_cast<unsigned>( *ptr - '0' );
+
+            if ( fits && integer <= impl::charconv::div10( integer_limit )
+                 && integer * 10 + digit <= integer_limit )
+                integer = integer * 10 + digit;
+            else
+                fits = false;
+        }
+
+        uint64_t fraction = 0;
+        uint64_t scale = 1;
+        bool     sticky = false;
+
+        if ( ptr != last && *ptr == '.' )
+        {
+            const Char* fraction_digits = ptr + 1;
+            const Char* fraction_end = fraction_digits;
+
+            for ( ; fraction_end != last && *fraction_end >= '0' && *fraction_end <= '9';
+                  ++fraction_end )
+            {
+                const auto digit = static_cast<unsigned>( *fraction_end - '0' );
+
+                if ( scale < 1000000000000000000u )
+                {
+                    fraction = fraction * 10 + digit;
+                    scale *= 10;
+                }
+                else
+                {
+                    sticky = sticky || digit != 0;
+                }
+            }
+
+            if ( fraction_end != fraction_digits || ptr != digits )
+                ptr = fraction_end;
+        }
+
+        if ( ptr == digits )
+            return { first, errc::invalid_argument };
+
+        // NOTE: Long division of the decimal fraction by one, a binary digit at a time. The
+        // digits are random, so the step is written without a branch.
+        uint64_t bits = 0;
+        for ( int i = 0; i < FractBits; ++i )
+        {
+            fraction <<= 1;
+
+            const uint64_t digit = fraction >= scale ? 1 : 0;
+            fraction -= scale & ( 0 - digit );
+            bits = ( bits << 1 ) | digit;
+        }
+
+        fraction <<= 1;
+        if ( fraction > scale || ( fraction == scale && ( sticky || ( bits & 1 ) != 0 ) ) )
+            ++bits;
+
+        if ( !fits || bits > limit - ( integer << FractBits ) )
+            return { ptr, errc::result_out_of_range };
+
+        const uint64_t magnitude = ( integer << FractBits ) + bits;
+
+        value = fix<Int, FractBits>::from_raw(
+            static_cast<Int>( negative ? 0u - magnitude : magnitude ) );
+        return { ptr, errc::ok };
+    }
+
+    template<typename Char, typename T>
+    [[nodiscard]] constexpr typename enable_if<
+        is_integral<T>::value && !is_same<typename remove_cv<T>::type, bool>::value,
+        basic_from_chars_result<Char>>::type
+    from_chars( basic_string_view<Char> str, T& value, int base = 10 )
+    {
+        return from_chars( str.data(), str.data() + str.size(), value, base );
+    }
+
+    template<typename Char, typename T>
+    [[nodiscard]] constexpr
+        typename enable_if<!is_integral<T>::value, basic_from_chars_result<Char>>::type
+        from_chars( basic_string_view<Char> str, T& value )
+    {
+        return from_chars( str.data(), str.data() + str.size(), value );
+    }
+} // namespace rtl
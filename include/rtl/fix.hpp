@@ -56,6 +56,12 @@ namespace rtl
                                            : ( ( 1 << fract_bits ) >> i ) );
         }
 
+        // Makes a value from its raw representation, i.e. the value multiplied by 2^fract_bits.
+        [[nodiscard]] static constexpr type from_raw( value_type raw )
+        {
+            return type::from_value( raw );
+        }
+
         [[nodiscard]] static constexpr type min()
         {
             return type::from_value( 1 );
@@ -210,7 +216,7 @@ namespace rtl
 
         static constexpr type from_value( value_type value )
         {
-            type type;
+            type type{};
             type.value = value;
             return type;
         }
@@ -0,0 +1,846 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/allocator.hpp>
+#include <rtl/functional.hpp>
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/pair.hpp>
+#include <rtl/type_traits.hpp>
+#include <rtl/utility.hpp>
+
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __SSE2__ )
+    #define RTL_FLAT_HASH_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define RTL_FLAT_HASH_SSE2 0
+#endif
+
+#if defined( _MSC_VER )
+    #include <intrin.h>
+#endif
+
+namespace rtl
+{
+    namespace impl
+    {
+        // Open addressing hash table in the style of the Swiss tables. Every slot has a control
+        // byte, that is either free (empty or deleted) or keeps the low 7 bits of the key's hash.
+        // Lookups compare the control bytes of 16 slots at a time and touch the slots only on a
+        // 7-bit match. Slots and control bytes are kept in a single allocation.
+        namespace flat_hash
+        {
+            using ctrl_t = signed char;
+
+            // NOTE: Full control bytes are 0..127, so the sign bit marks the free ones
+            constexpr ctrl_t ctrl_empty = -128;
+            constexpr ctrl_t ctrl_deleted = -2;
+
+            constexpr size_t group_width = 16;
+
+            [[nodiscard]] inline unsigned lowest_bit( unsigned mask )
+            {
+#if defined( _MSC_VER )
+                unsigned long index;
+                _BitScanForward( &index, mask );
+                return index;
+#else
+                return static_cast<unsigned>( __builtin_ctz( mask ) );
+#endif
+            }
+
+            [[nodiscard]] inline unsigned highest_bit( unsigned mask )
+            {
+#if defined( _MSC_VER )
+                unsigned long index;
+                _BitScanReverse( &index, mask );
+                return index;
+#else
+                return static_cast<unsigned>( 31 - __builtin_clz( mask ) );
+#endif
+            }
+
+            // Control bytes of \group_width consecutive slots. Bit i of a match mask stands for
+            // the slot i.
+            class group final
+            {
+            public:
+                explicit group( const ctrl_t* ctrl )
+#if RTL_FLAT_HASH_SSE2
+                    : m_ctrl( _mm_loadu_si128( reinterpret_cast<const __m128i*>( ctrl ) ) )
+#else
+                    : m_ctrl( ctrl )
+#endif
+                {
+                }
+
+                [[nodiscard]] unsigned match( ctrl_t h2 ) const
+                {
+#if RTL_FLAT_HASH_SSE2
+                    return mask( _mm_cmpeq_epi8( m_ctrl, _mm_set1_epi8( h2 ) ) );
+#else
+                    unsigned result = 0;
+
+                    for ( size_t i = 0; i < group_width; ++i )
+                        if ( m_ctrl[i] == h2 )
+                            result |= 1u << i;
+
+                    return result;
+#endif
+                }
+
+                [[nodiscard]] unsigned match_empty() const
+                {
+                    return match( ctrl_empty );
+                }
+
+                [[nodiscard]] unsigned match_free() const
+                {
+#if RTL_FLAT_HASH_SSE2
+                    return mask( m_ctrl );
+#else
+                    unsigned result = 0;
+
+                    for ( size_t i = 0; i < group_width; ++i )
+                        if ( m_ctrl[i] < 0 )
+                            result |= 1u << i;
+
+                    return result;
+#endif
+                }
+
+            private:
+#if RTL_FLAT_HASH_SSE2
+                [[nodiscard]] static unsigned mask( __m128i bytes )
+                {
+                    return static_cast<unsigned>( _mm_movemask_epi8( bytes ) );
+                }
+
+                __m128i m_ctrl;
+#else
+                const ctrl_t* m_ctrl;
+#endif
+            };
+
+            template<typename Key, typename Value>
+            struct map_policy
+            {
+                using key_type = Key;
+                using value_type = pair<Key, Value>;
+                using element_type = value_type;
+
+                [[nodiscard]] static constexpr const Key& key( const value_type& value )
+                {
+                    return value.first;
+                }
+            };
+
+            template<typename Key>
+            struct set_policy
+            {
+                using key_type = Key;
+                using value_type = Key;
+                using element_type = const Key;
+
+                [[nodiscard]] static constexpr const Key& key( const value_type& value )
+                {
+                    return value;
+                }
+            };
+
+            template<typename T, typename = void>
+            struct is_transparent : false_type
+            {
+            };
+
+            template<typename T>
+            struct is_transparent<T, void_type<typename T::is_transparent>> : true_type
+            {
+            };
+
+            // NOTE: With transparent hash and equality lookup functions take any key type,
+            // otherwise the argument is converted to the key type.
+            template<bool Transparent>
+            struct key_arg
+            {
+                template<typename Lookup, typename Key>
+                using type = Lookup;
+            };
+
+            template<>
+            struct key_arg<false>
+            {
+                template<typename Lookup, typename Key>
+                using type = Key;
+            };
+
+            template<typename T>
+            class iterator final
+            {
+            public:
+                constexpr iterator( const ctrl_t* ctrl, T* slot, T* end )
+                    : m_ctrl( ctrl )
+                    , m_slot( slot )
+                    , m_end( end )
+                {
+                }
+
+                template<typename U,
+                         typename = typename enable_if<!is_same<U, T>::value
+                                                       && is_same<const U, T>::value>::type>
+                // cppcheck-suppress noExplicitConstructor
+                constexpr iterator( const iterator<U>& that )
+                    : m_ctrl( that.m_ctrl )
+                    , m_slot( that.m_slot )
+                    , m_end( that.m_end )
+                {
+                }
+
+                [[nodiscard]] constexpr T& operator*() const
+                {
+                    return *m_slot;
+                }
+
+                [[nodiscard]] constexpr T* operator->() const
+                {
+                    return m_slot;
+                }
+
+                constexpr iterator& operator++()
+                {
+                    do
+                    {
+                        ++m_ctrl;
+                        ++m_slot;
+                    } while ( m_slot != m_end && *m_ctrl < 0 );
+
+                    return *this;
+                }
+
+                [[nodiscard]] constexpr bool operator==( const iterator& rhs ) const
+                {
+                    return m_slot == rhs.m_slot;
+                }
+
+                [[nodiscard]] constexpr bool operator!=( const iterator& rhs ) const
+                {
+                    return m_slot != rhs.m_slot;
+                }
+
+            private:
+                template<typename>
+                friend class iterator;
+
+                const ctrl_t* m_ctrl;
+                T*            m_slot;
+                T*            m_end;
+            };
+
+            // NOTE: \Hash and \KeyEqual are expected to be stateless, they are not stored
+            template<typename Policy, typename Hash, typename KeyEqual, typename Allocator>
+            class table : private impl::allocator_holder<Allocator>
+            {
+            public:
+                using key_type = typename Policy::key_type;
+                using value_type = typename Policy::value_type;
+                using hasher = Hash;
+                using key_equal = KeyEqual;
+                using allocator_type = Allocator;
+                using iterator = flat_hash::iterator<typename Policy::element_type>;
+                using const_iterator = flat_hash::iterator<const value_type>;
+
+                static_assert( is_same<typename Allocator::value_type, value_type>::value,
+                               "allocator value type mismatch" );
+
+            protected:
+                template<typename Lookup>
+                using key_arg = typename flat_hash::key_arg<
+                    is_transparent<Hash>::value
+                    && is_transparent<KeyEqual>::value>::template type<Lookup, key_type>;
+
+            public:
+
+                [[nodiscard]] constexpr iterator begin()
+                {
+                    iterator it = iterator_at( 0 );
+                    if ( m_capacity > 0 && m_ctrl[0] < 0 )
+                        ++it;
+
+                    return it;
+                }
+
+                [[nodiscard]] constexpr iterator end()
+                {
+                    return iterator_at( m_capacity );
+                }
+
+                [[nodiscard]] constexpr const_iterator begin() const
+                {
+                    return const_cast<table*>( this )->begin();
+                }
+
+                [[nodiscard]] constexpr const_iterator end() const
+                {
+                    return const_cast<table*>( this )->end();
+                }
+
+                [[nodiscard]] constexpr size_t size() const
+                {
+                    return m_size;
+                }
+
+                [[nodiscard]] constexpr bool empty() const
+                {
+                    return m_size == 0;
+                }
+
+                // NOTE: Number of slots, up to 7/8 of them may be occupied
+                [[nodiscard]] constexpr size_t capacity() const
+                {
+                    return m_capacity;
+                }
+
+                [[nodiscard]] constexpr allocator_type get_allocator() const
+                {
+                    return this->allocator_ref();
+                }
+
+                template<typename Lookup = key_type>
+                [[nodiscard]] iterator find( const key_arg<Lookup>& key )
+                {
+                    return iterator_at( find_index( key, hash_of( key ) ) );
+                }
+
+                template<typename Lookup = key_type>
+                [[nodiscard]] const_iterator find( const key_arg<Lookup>& key ) const
+                {
+                    return const_cast<table*>( this )->template find<Lookup>( key );
+                }
+
+                template<typename Lookup = key_type>
+                [[nodiscard]] bool contains( const key_arg<Lookup>& key ) const
+                {
+                    return find_index( key, hash_of( key ) ) != m_capacity;
+                }
+
+                template<typename Lookup = key_type>
+                size_t erase( const key_arg<Lookup>& key )
+                {
+                    const size_t index = find_index( key, hash_of( key ) );
+                    if ( index == m_capacity )
+                        return 0;
+
+                    erase_at( index );
+                    return 1;
+                }
+
+                // NOTE: Does not return the next iterator, as the caller can just increment
+                // \it, erasing does not move other elements
+                void erase( const_iterator it )
+                {
+                    erase_at( static_cast<size_t>( it.operator->() - m_slots ) );
+                }
+
+                void clear()
+                {
+                    destroy_all();
+
+                    if ( m_capacity > 0 )
+                        reset_ctrl();
+
+                    m_size = 0;
+                }
+
+                // NOTE: Makes room for \count elements without rehashing
+                void reserve( size_t count )
+                {
+                    size_t capacity = group_width;
+                    while ( max_load( capacity ) < count )
+                        capacity *= 2;
+
+                    if ( capacity > m_capacity )
+                        resize( capacity );
+                }
+
+            protected:
+                constexpr explicit table( const Allocator& allocator )
+                    : impl::allocator_holder<Allocator>( allocator )
+                    , m_ctrl( nullptr )
+                    , m_slots( nullptr )
+                    , m_capacity( 0 )
+                    , m_size( 0 )
+                    , m_growth_left( 0 )
+                {
+                }
+
+                ~table()
+                {
+                    destroy_all();
+                    deallocate();
+                }
+
+                table( const table& that )
+                    : table( that.get_allocator() )
+                {
+                    copy( that );
+                }
+
+                table& operator=( const table& that )
+                {
+                    if ( this != &that )
+                    {
+                        destroy_all();
+                        deallocate();
+
+                        m_size = 0;
+                        copy( that );
+                    }
+
+                    return *this;
+                }
+
+                constexpr table( table&& that )
+                    : table( that.get_allocator() )
+                {
+                    steal( that );
+                }
+
+                table& operator=( table&& that )
+                {
+                    if ( this != &that )
+                    {
+                        destroy_all();
+                        deallocate();
+
+                        this->replace_allocator( that );
+                        steal( that );
+                    }
+
+                    return *this;
+                }
+
+                [[nodiscard]] constexpr iterator iterator_at( size_t index )
+                {
+                    return iterator( m_ctrl + index, m_slots + index, m_slots + m_capacity );
+                }
+
+                // NOTE: Reserves a slot for the key, if the table does not have it yet. The
+                // caller must construct the element in the slot right away.
+                template<typename Lookup>
+                [[nodiscard]] pair<size_t, bool> find_or_prepare_insert( const Lookup& key )
+                {
+                    const size_t hash = hash_of( key );
+                    const size_t index = find_index( key, hash );
+
+                    if ( index != m_capacity )
+                        return { index, false };
+
+                    return { prepare_insert( hash ), true };
+                }
+
+                template<typename... Args>
+                void emplace_at( size_t index, Args&&... args )
+                {
+                    ::new ( static_cast<void*>( m_slots + index ) )
+                        value_type{ rtl::forward<Args>( args )... };
+                }
+
+            private:
+                [[nodiscard]] static constexpr size_t max_load( size_t capacity )
+                {
+                    return capacity - capacity / 8;
+                }
+
+                // NOTE: Number of \value_type units to hold the slots and the control bytes.
+                // The first group of the control bytes is mirrored after the last one, so a
+                // group can be loaded at any position without wrapping around.
+                [[nodiscard]] static constexpr size_t allocation_size( size_t capacity )
+                {
+                    return capacity
+                           + ( capacity + group_width + sizeof( value_type ) - 1 )
+                                 / sizeof( value_type );
+                }
+
+                template<typename Lookup>
+                [[nodiscard]] static size_t hash_of( const Lookup& key )
+                {
+                    size_t hash = Hash()( key );
+
+                    // NOTE: Fibonacci hashing moves the entropy to the high bits, the final
+                    // xor brings it back to the low ones used for \h2 and the position
+                    if constexpr ( sizeof( size_t ) == 8 )
+                        hash *= static_cast<size_t>( 0x9e3779b97f4a7c15ull );
+                    else
+                        hash *= static_cast<size_t>( 0x9e3779b1u );
+
+                    return hash ^ ( hash >> ( sizeof( size_t ) * 4 ) );
+                }
+
+                [[nodiscard]] static constexpr ctrl_t h2( size_t hash )
+                {
+                    return static_cast<ctrl_t>( hash & 0x7f );
+                }
+
+                // NOTE: Returns \m_capacity, if there is no such key
+                template<typename Lookup>
+                [[nodiscard]] size_t find_index( const Lookup& key, size_t hash ) const
+                {
+                    if ( m_size == 0 )
+                        return m_capacity;
+
+                    const size_t mask = m_capacity - 1;
+                    const ctrl_t tag = h2( hash );
+
+                    size_t position = ( hash >> 7 ) & mask;
+
+                    for ( size_t step = group_width;; step += group_width )
+                    {
+                        const group g( m_ctrl + position );
+
+                        for ( unsigned bits = g.match( tag ); bits; bits &= bits - 1 )
+                        {
+                            const size_t index = ( position + lowest_bit( bits ) ) & mask;
+
+                            if ( KeyEqual()( Policy::key( m_slots[index] ), key ) )
+                                return index;
+                        }
+
+                        if ( g.match_empty() )
+                            return m_capacity;
+
+                        position = ( position + step ) & mask;
+                    }
+                }
+
+                // NOTE: The table always has an empty slot, so the probing terminates. Probe
+                // positions grow by triangular numbers of groups and visit every group of a
+                // power of 2 sized table.
+                [[nodiscard]] size_t find_free( size_t hash ) const
+                {
+                    const size_t mask = m_capacity - 1;
+
+                    size_t position = ( hash >> 7 ) & mask;
+
+                    for ( size_t step = group_width;; step += group_width )
+                    {
+                        if ( const unsigned bits = group( m_ctrl + position ).match_free() )
+                            return ( position + lowest_bit( bits ) ) & mask;
+
+                        position = ( position + step ) & mask;
+                    }
+                }
+
+                [[nodiscard]] size_t prepare_insert( size_t hash )
+                {
+                    if ( m_capacity == 0 )
+                        resize( group_width );
+
+                    size_t index = find_free( hash );
+
+                    if ( m_growth_left == 0 && m_ctrl[index] != ctrl_deleted )
+                    {
+                        // NOTE: A table full of deleted slots is rehashed in place
+                        resize( m_size > max_load( m_capacity ) / 2 ? m_capacity * 2
+                                                                     : m_capacity );
+                        index = find_free( hash );
+                    }
+
+                    if ( m_ctrl[index] == ctrl_empty )
+                        --m_growth_left;
+
+                    set_ctrl( index, h2( hash ) );
+                    ++m_size;
+
+                    return index;
+                }
+
+                void erase_at( size_t index )
+                {
+                    rtl::destroy_at( m_slots + index );
+                    --m_size;
+
+                    // NOTE: If less than a group of full or deleted slots surrounds the slot,
+                    // every probe sequence, that reached it, has also seen an empty slot and
+                    // stopped. So the slot can be made empty instead of deleted.
+                    const size_t   before = ( index - group_width ) & ( m_capacity - 1 );
+                    const unsigned empty_after = group( m_ctrl + index ).match_empty();
+                    const unsigned empty_before = group( m_ctrl + before ).match_empty();
+
+                    if ( empty_before && empty_after
+                         && lowest_bit( empty_after ) + ( group_width - 1 )
+                                    - highest_bit( empty_before )
+                                < group_width )
+                    {
+                        set_ctrl( index, ctrl_empty );
+                        ++m_growth_left;
+                    }
+                    else
+                    {
+                        set_ctrl( index, ctrl_deleted );
+                    }
+                }
+
+                void set_ctrl( size_t index, ctrl_t value )
+                {
+                    m_ctrl[index] = value;
+                    m_ctrl[( ( index - group_width ) & ( m_capacity - 1 ) ) + group_width]
+                        = value;
+                }
+
+                void reset_ctrl()
+                {
+                    memset( m_ctrl, ctrl_empty, m_capacity + group_width );
+                    m_growth_left = max_load( m_capacity );
+                }
+
+                void allocate( size_t capacity )
+                {
+                    m_slots = this->allocator_ref().allocate( allocation_size( capacity ) );
+                    m_ctrl = reinterpret_cast<ctrl_t*>( m_slots + capacity );
+                    m_capacity = capacity;
+                }
+
+                void deallocate()
+                {
+                    if ( m_capacity > 0 )
+                        this->allocator_ref().deallocate( m_slots, allocation_size( m_capacity ) );
+                }
+
+                void destroy_all()
+                {
+                    if constexpr ( !is_trivially_destructible<value_type>::value )
+                    {
+                        for ( size_t i = 0; i < m_capacity; ++i )
+                            if ( m_ctrl[i] >= 0 )
+                                rtl::destroy_at( m_slots + i );
+                    }
+                }
+
+                // NOTE: Moves the elements to a new buffer, that drops the deleted slots
+                void resize( size_t capacity )
+                {
+                    ctrl_t*       old_ctrl = m_ctrl;
+                    value_type*   old_slots = m_slots;
+                    const size_t  old_capacity = m_capacity;
+
+                    allocate( capacity );
+                    reset_ctrl();
+                    m_growth_left -= m_size;
+
+                    for ( size_t i = 0; i < old_capacity; ++i )
+                    {
+                        if ( old_ctrl[i] < 0 )
+                            continue;
+
+                        const size_t hash = hash_of( Policy::key( old_slots[i] ) );
+                        const size_t index = find_free( hash );
+
+                        set_ctrl( index, h2( hash ) );
+                        impl::relocate_n( old_slots + i, size_t( 1 ), m_slots + index );
+                    }
+
+                    if ( old_capacity > 0 )
+                        this->allocator_ref().deallocate( old_slots,
+                                                          allocation_size( old_capacity ) );
+                }
+
+                // NOTE: Expects this table to be empty and without a buffer. Elements keep
+                // their slots, as both tables hash the same way.
+                void copy( const table& that )
+                {
+                    if ( that.m_size == 0 )
+                    {
+                        m_ctrl = nullptr;
+                        m_slots = nullptr;
+                        m_capacity = 0;
+                        m_growth_left = 0;
+                        return;
+                    }
+
+                    allocate( that.m_capacity );
+                    memcpy( m_ctrl, that.m_ctrl, m_capacity + group_width );
+
+                    for ( size_t i = 0; i < m_capacity; ++i )
+                        if ( m_ctrl[i] >= 0 )
+                            ::new ( static_cast<void*>( m_slots + i ) )
+                                value_type( that.m_slots[i] );
+
+                    m_size = that.m_size;
+                    m_growth_left = that.m_growth_left;
+                }
+
+                constexpr void steal( table& that )
+                {
+                    m_ctrl = that.m_ctrl;
+                    m_slots = that.m_slots;
+                    m_capacity = that.m_capacity;
+                    m_size = that.m_size;
+                    m_growth_left = that.m_growth_left;
+
+                    that.m_ctrl = nullptr;
+                    that.m_slots = nullptr;
+                    that.m_capacity = 0;
+                    that.m_size = 0;
+                    that.m_growth_left = 0;
+                }
+
+                ctrl_t*     m_ctrl;
+                value_type* m_slots;
+                size_t      m_capacity;
+                size_t      m_size;
+                size_t      m_growth_left;
+            };
+        } // namespace flat_hash
+    }     // namespace impl
+
+    // Hash map with open addressing. Elements are stored in place, so inserts may move them
+    // and invalidate iterators, erasing invalidates only the iterators to the erased element.
+    // An empty map does not allocate. With the string keys \find, \contains, \erase and
+    // operator[] also take string views and literals without making a temporary string.
+    //
+    // NOTE: The key of \value_type is not const, but must not be modified through iterators
+    template<typename Key,
+             typename Value,
+             typename Hash = rtl::hash<Key>,
+             typename KeyEqual = rtl::equal_to<Key>,
+             typename Allocator = rtl::allocator<pair<Key, Value>>>
+    class flat_hash_map final
+        : public impl::flat_hash::
+              table<impl::flat_hash::map_policy<Key, Value>, Hash, KeyEqual, Allocator>
+    {
+        using base = impl::flat_hash::
+            table<impl::flat_hash::map_policy<Key, Value>, Hash, KeyEqual, Allocator>;
+
+        template<typename Lookup>
+        using key_arg = typename base::template key_arg<Lookup>;
+
+    public:
+        using mapped_type = Value;
+        using typename base::iterator;
+        using typename base::key_type;
+        using typename base::value_type;
+
+        constexpr flat_hash_map()
+            : flat_hash_map( Allocator() )
+        {
+        }
+
+        constexpr explicit flat_hash_map( const Allocator& allocator )
+            : base( allocator )
+        {
+        }
+
+        pair<iterator, bool> insert( const value_type& value )
+        {
+            const auto slot = this->find_or_prepare_insert( value.first );
+            if ( slot.second )
+                this->emplace_at( slot.first, value.first, value.second );
+
+            return { this->iterator_at( slot.first ), slot.second };
+        }
+
+        pair<iterator, bool> insert( value_type&& value )
+        {
+            const auto slot = this->find_or_prepare_insert( value.first );
+            if ( slot.second )
+                this->emplace_at( slot.first, rtl::move( value.first ), rtl::move( value.second ) );
+
+            return { this->iterator_at( slot.first ), slot.second };
+        }
+
+        // NOTE: Does nothing with \args, if the key is already in the map
+        template<typename Lookup = key_type, typename... Args>
+        pair<iterator, bool> try_emplace( const key_arg<Lookup>& key, Args&&... args )
+        {
+            const auto slot = this->find_or_prepare_insert( key );
+            if ( slot.second )
+                this->emplace_at( slot.first,
+                                    key_type( key ),
+                                    mapped_type( rtl::forward<Args>( args )... ) );
+
+            return { this->iterator_at( slot.first ), slot.second };
+        }
+
+        template<typename... Args>
+        pair<iterator, bool> try_emplace( key_type&& key, Args&&... args )
+        {
+            const auto slot = this->find_or_prepare_insert( key );
+            if ( slot.second )
+                this->emplace_at( slot.first,
+                                    rtl::move( key ),
+                                    mapped_type( rtl::forward<Args>( args )... ) );
+
+            return { this->iterator_at( slot.first ), slot.second };
+        }
+
+        template<typename Lookup = key_type>
+        mapped_type& operator[]( const key_arg<Lookup>& key )
+        {
+            return try_emplace<Lookup>( key ).first->second;
+        }
+
+        mapped_type& operator[]( key_type&& key )
+        {
+            return try_emplace( rtl::move( key ) ).first->second;
+        }
+    };
+
+    // Hash set with open addressing, see \flat_hash_map.
+    template<typename Key,
+             typename Hash = rtl::hash<Key>,
+             typename KeyEqual = rtl::equal_to<Key>,
+             typename Allocator = rtl::allocator<Key>>
+    class flat_hash_set final
+        : public impl::flat_hash::table<impl::flat_hash::set_policy<Key>, Hash, KeyEqual, Allocator>
+    {
+        using base
+            = impl::flat_hash::table<impl::flat_hash::set_policy<Key>, Hash, KeyEqual, Allocator>;
+
+        template<typename Lookup>
+        using key_arg = typename base::template key_arg<Lookup>;
+
+    public:
+        using typename base::iterator;
+        using typename base::key_type;
+
+        constexpr flat_hash_set()
+            : flat_hash_set( Allocator() )
+        {
+        }
+
+        constexpr explicit flat_hash_set( const Allocator& allocator )
+            : base( allocator )
+        {
+        }
+
+        // NOTE: With the transparent hash the key is made from the argument only if it is
+        // inserted, e.g. a string view is turned into a string
+        template<typename Lookup = key_type>
+        pair<iterator, bool> insert( const key_arg<Lookup>& key )
+        {
+            const auto slot = this->find_or_prepare_insert( key );
+            if ( slot.second )
+                this->emplace_at( slot.first, key_type( key ) );
+
+            return { this->iterator_at( slot.first ), slot.second };
+        }
+
+        pair<iterator, bool> insert( key_type&& key )
+        {
+            const auto slot = this->find_or_prepare_insert( key );
+            if ( slot.second )
+                this->emplace_at( slot.first, rtl::move( key ) );
+
+            return { this->iterator_at( slot.first ), slot.second };
+        }
+    };
+} // namespace rtl
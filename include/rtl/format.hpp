@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/charconv.hpp>
+#include <rtl/int.hpp>
+#include <rtl/string.hpp>
+#include <rtl/type_traits.hpp>
+
+// Wraps a string literal into a type, so that the format functions can parse and check it at
+// compile time (C++17 has no consteval to do it for a plain literal argument):
+//
+//     rtl::format_to( buffer, RTL_FMT_STRING( "{} of {:x}" ), 1, 255u );
+//
+// Replacement fields are "{}" and "{:x}" (hexadecimal integer), "{{" and "}}" are escaped
+// braces. A wrong field or a wrong number of arguments is a compile error.
+#define RTL_FMT_STRING( str )                                                                      \
+    []                                                                                             \
+    {                                                                                              \
+        struct format_string                                                                       \
+        {                                                                                          \
+            [[nodiscard]] static constexpr auto value()                                            \
+            {                                                                                      \
+                return str;                                                                        \
+            }                                                                                      \
+        };                                                                                         \
+        return format_string{};                                                                    \
+    }()
+
+namespace rtl
+{
+    template<typename Char>
+    struct format_to_n_result
+    {
+        Char*  out;
+        size_t size;
+    };
+
+    namespace impl
+    {
+        namespace format
+        {
+            enum class error
+            {
+                none,
+                unmatched_open_brace,
+                unmatched_close_brace,
+                unsupported_field
+            };
+
+            // NOTE: The format string without escapes and replacement fields. Argument i is
+            // written right after the text from positions[i] to positions[i + 1].
+            template<typename Char, size_t Length>
+            struct parsed_string
+            {
+                Char   text[Length + 1];
+                size_t text_size;
+                size_t positions[Length + 2];
+                char   specs[Length + 1];
+                size_t fields;
+                error  status;
+            };
+
+            template<typename Char>
+            [[nodiscard]] constexpr size_t string_length( const Char* str )
+            {
+                size_t size = 0;
+                while ( str[size] )
+                    ++size;
+                return size;
+            }
+
+            template<typename Char, size_t Length>
+            [[nodiscard]] constexpr parsed_string<Char, Length> parse( const Char* str )
+            {
+                parsed_string<Char, Length> result = {};
+
+                for ( size_t i = 0; i < Length; ++i )
+                {
+                    const Char ch = str[i];
+
+                    if ( ch == '}' )
+                    {
+                        if ( i + 1 == Length || str[i + 1] != '}' )
+                        {
+                            result.status = error::unmatched_close_brace;
+                            return result;
+                        }
+
+                        result.text[result.text_size++] = ch;
+                        ++i;
+                    }
+                    else if ( ch != '{' )
+                    {
+                        result.text[result.text_size++] = ch;
+                    }
+                    else if ( i + 1 < Length && str[i + 1] == '{' )
+                    {
+                        result.text[result.text_size++] = ch;
+                        ++i;
+                    }
+                    else
+                    {
+                        char spec = 0;
+
+                        if ( i + 1 < Length && str[i + 1] == '}' )
+                        {
+                            i += 1;
+                        }
+                        else if ( i + 3 < Length && str[i + 1] == ':' && str[i + 2] == 'x'
+                                  && str[i + 3] == '}' )
+                        {
+                            spec = 'x';
+                            i += 3;
+                        }
+                        else
+                        {
+                            bool closed = false;
+                            for ( size_t j = i + 1; j < Length; ++j )
+                                closed = closed || str[j] == '}';
+
+                            result.status
+                                = closed ? error::unsupported_field : error::unmatched_open_brace;
+                            return result;
+                        }
+
+                        result.specs[result.fields] = spec;
+                        result.positions[++result.fields] = result.text_size;
+                    }
+                }
+
+                return result;
+            }
+
+            template<typename Format>
+            struct compiled
+            {
+                using char_type = typename remove_cv<
+                    typename remove_reference<decltype( *Format::value() )>::type>::type;
+
+                static constexpr size_t length = string_length( Format::value() );
+
+                static constexpr parsed_string<char_type, length> value
+                    = parse<char_type, length>( Format::value() );
+            };
+
+            // Writes the output sequentially and truncates it at \last. Counts the characters
+            // that would have been written without truncation.
+            template<typename Char>
+            class writer final
+            {
+            public:
+                constexpr writer( Char* first, Char* last )
+                    : m_ptr( first )
+                    , m_last( last )
+                    , m_size( 0 )
+                {
+                }
+
+                [[nodiscard]] constexpr Char* out() const
+                {
+                    return m_ptr;
+                }
+
+                [[nodiscard]] constexpr size_t size() const
+                {
+                    return m_size;
+                }
+
+                constexpr void put( Char ch )
+                {
+                    if ( m_ptr != m_last )
+                        *m_ptr++ = ch;
+
+                    ++m_size;
+                }
+
+                // NOTE: A narrower source is widened char by char, so non-ASCII narrow text
+                // is only valid in the narrow output.
+                template<typename T>
+                constexpr void put( const T* str, size_t size )
+                {
+                    static_assert( sizeof( T ) <= sizeof( Char ), "narrowing string conversion" );
+
+                    const size_t available = static_cast<size_t>( m_last - m_ptr );
+                    const size_t count = size < available ? size : available;
+
+                    for ( size_t i = 0; i < count; ++i )
+                        *m_ptr++ = static_cast<Char>( str[i] );
+
+                    m_size += size;
+                }
+
+                constexpr void write( const char* str, char /* spec */ = 0 )
+                {
+                    put( str, string_length( str ) );
+                }
+
+                constexpr void write( const wchar_t* str, char /* spec */ = 0 )
+                {
+                    put( str, string_length( str ) );
+                }
+
+                void write( const void* ptr, char /* spec */ = 0 )
+                {
+                    put( '0' );
+                    put( 'x' );
+                    write( reinterpret_cast<uintptr_value>( ptr ), 'x' );
+                }
+
+                template<typename T>
+                constexpr void write( const basic_string_view<T>& str, char /* spec */ = 0 )
+                {
+                    put( str.data(), str.size() );
+                }
+
+                template<typename T, typename Allocator>
+                constexpr void write( const basic_string<T, Allocator>& str, char /* spec */ = 0 )
+                {
+                    put( str.data(), str.size() );
+                }
+
+                constexpr void write( bool value, char /* spec */ = 0 )
+                {
+                    if ( value )
+                        put( "true", 4 );
+                    else
+                        put( "false", 5 );
+                }
+
+                constexpr void write( char ch, char /* spec */ = 0 )
+                {
+                    put( static_cast<Char>( ch ) );
+                }
+
+                constexpr void write( wchar_t ch, char /* spec */ = 0 )
+                {
+                    static_assert( sizeof( Char ) == sizeof( wchar_t ),
+                                   "wide character in narrow output" );
+                    put( static_cast<Char>( ch ) );
+                }
+
+                template<typename T>
+                constexpr typename enable_if<is_integral<T>::value>::type write( T value,
+                                                                                  char spec = 0 )
+                {
+                    Char       buffer[66] = {};
+                    const int  base = spec == 'x' ? 16 : 10;
+                    const auto result = to_chars( buffer, buffer + 66, value, base );
+                    put( buffer, static_cast<size_t>( result.ptr - buffer ) );
+                }
+
+                template<typename T>
+                typename enable_if<is_floating_point<T>::value>::type write( T      value,
+                                                                             char /* spec */ = 0 )
+                {
+                    Char       buffer[32] = {};
+                    const auto result = to_chars( buffer, buffer + 32, value );
+                    put( buffer, static_cast<size_t>( result.ptr - buffer ) );
+                }
+
+                template<typename Format, typename... Args>
+                constexpr void format( Format, const Args&... args )
+                {
+                    using parsed = compiled<Format>;
+
+                    constexpr const auto& fmt = parsed::value;
+
+                    static_assert( fmt.status != error::unmatched_open_brace,
+                                   "unmatched '{' in format string" );
+                    static_assert( fmt.status != error::unmatched_close_brace,
+                                   "unmatched '}' in format string" );
+                    static_assert( fmt.status != error::unsupported_field,
+                                   "only {} and {:x} replacement fields are supported" );
+                    static_assert( fmt.fields == sizeof...( Args ),
+                                   "number of arguments does not match format string" );
+
+                    [[maybe_unused]] size_t field = 0;
+
+                    ( ( put( fmt.text + fmt.positions[field],
+                             fmt.positions[field + 1] - fmt.positions[field] ),
+                        write( args, fmt.specs[field] ),
+                        ++field ),
+                      ... );
+
+                    put( fmt.text + fmt.positions[field],
+                         fmt.text_size - fmt.positions[field] );
+                }
+
+            private:
+                using uintptr_value = conditional<sizeof( void* ) == 8, uint64_t, uint32_t>::type;
+
+                Char*  m_ptr;
+                Char*  m_last;
+                size_t m_size;
+            };
+        } // namespace format
+    }     // namespace impl
+
+    // Writes at most \size characters to \out, without a terminating null character. Returns the
+    // end of the written characters and the total output size without truncation.
+    template<typename Char, typename Format, typename... Args>
+    constexpr format_to_n_result<Char> format_to_n( Char*          out,
+                                                    size_t         size,
+                                                    Format         format,
+                                                    const Args&... args )
+    {
+        impl::format::writer<Char> writer( out, out + size );
+        writer.format( format, args... );
+
+        return { writer.out(), writer.size() };
+    }
+
+    // Writes the formatted output to \buffer, truncated to fit it with the terminating null
+    // character. Returns the pointer to the terminating null character.
+    template<typename Char, size_t Size, typename Format, typename... Args>
+    constexpr Char* format_to( Char ( &buffer )[Size], Format format, const Args&... args )
+    {
+        static_assert( Size > 0 );
+
+        Char* out = format_to_n( buffer, Size - 1, format, args... ).out;
+        *out = 0;
+
+        return out;
+    }
+} // namespace rtl
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/hash.hpp>
+#include <rtl/int.hpp>
+#include <rtl/string.hpp>
+#include <rtl/type_traits.hpp>
+
+namespace rtl
+{
+    namespace impl
+    {
+        // FNV-1a over the code units of a wide string
+        template<typename T>
+        [[nodiscard]] constexpr size_t hash_units( const T* str, size_t size )
+        {
+            uint64_t hash = 0xcbf29ce484222325ull;
+
+            for ( size_t i = 0; i < size; ++i )
+            {
+                hash ^= static_cast<uint64_t>( str[i] );
+                hash *= 0x100000001b3ull;
+            }
+
+            return static_cast<size_t>( hash ^ ( hash >> 32 ) );
+        }
+    } // namespace impl
+
+    // NOTE: Hashes of integers and pointers are their values, containers must mix them on their
+    // own before using the low or the high bits.
+    template<typename T, typename = void>
+    struct hash;
+
+    template<typename T>
+    struct hash<T, typename enable_if<is_integral<T>::value>::type>
+    {
+        [[nodiscard]] constexpr size_t operator()( T value ) const
+        {
+            using unsigned_type = typename make_unsigned<T>::type;
+
+            const auto bits = static_cast<unsigned_type>( value );
+
+            if constexpr ( sizeof( T ) > sizeof( size_t ) )
+                return static_cast<size_t>( bits ^ ( bits >> 32 ) );
+            else
+                return static_cast<size_t>( bits );
+        }
+    };
+
+    template<typename T>
+    struct hash<T*>
+    {
+        [[nodiscard]] size_t operator()( const T* ptr ) const
+        {
+            static_assert( sizeof( T* ) == sizeof( size_t ) );
+            return reinterpret_cast<size_t>( ptr );
+        }
+    };
+
+    // NOTE: String hashes are transparent: a string, a string view and a string literal of
+    // the same characters have the same hash, so containers can look strings up by views.
+    template<typename T>
+    struct hash<basic_string_view<T>>
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] constexpr size_t operator()( basic_string_view<T> str ) const
+        {
+            if constexpr ( sizeof( T ) == 1 )
+                return static_cast<size_t>( wyhash( str.data(), str.size() ) );
+            else
+                return impl::hash_units( str.data(), str.size() );
+        }
+    };
+
+    template<typename T, typename Allocator>
+    struct hash<basic_string<T, Allocator>> : hash<basic_string_view<T>>
+    {
+    };
+
+    template<typename T>
+    struct equal_to
+    {
+        [[nodiscard]] constexpr bool operator()( const T& lhs, const T& rhs ) const
+        {
+            return lhs == rhs;
+        }
+    };
+
+    template<typename T>
+    struct equal_to<basic_string_view<T>>
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] constexpr bool operator()( basic_string_view<T> lhs,
+                                                 basic_string_view<T> rhs ) const
+        {
+            return lhs == rhs;
+        }
+    };
+
+    template<typename T, typename Allocator>
+    struct equal_to<basic_string<T, Allocator>> : equal_to<basic_string_view<T>>
+    {
+    };
+} // namespace rtl
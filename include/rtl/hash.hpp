@@ -0,0 +1,367 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/string.hpp>
+#include <rtl/type_traits.hpp>
+
+namespace rtl
+{
+    namespace impl
+    {
+        namespace hash
+        {
+            // NOTE: Little-endian loads. Constant evaluation assembles them from bytes, at
+            // runtime they are single unaligned loads.
+            [[nodiscard]] constexpr uint64_t read64( const char* p )
+            {
+                if ( !rtl::is_constant_evaluated() )
+                {
+                    uint64_t value = 0;
+                    memcpy( &value, p, sizeof( value ) );
+                    return value;
+                }
+
+                uint64_t value = 0;
+                for ( int i = 7; i >= 0; --i )
+                    value = ( value << 8 ) | static_cast<unsigned char>( p[i] );
+
+                return value;
+            }
+
+            [[nodiscard]] constexpr uint64_t read32( const char* p )
+            {
+                if ( !rtl::is_constant_evaluated() )
+                {
+                    uint32_t value = 0;
+                    memcpy( &value, p, sizeof( value ) );
+                    return value;
+                }
+
+                uint32_t value = 0;
+                for ( int i = 3; i >= 0; --i )
+                    value = ( value << 8 ) | static_cast<unsigned char>( p[i] );
+
+                return value;
+            }
+
+            [[nodiscard]] constexpr uint64_t rotl( uint64_t x, int r )
+            {
+                return ( x << r ) | ( x >> ( 64 - r ) );
+            }
+
+            // NOTE: The 128-bit product is assembled from 32-bit halves, because there is no
+            // 64x64 multiplication instruction on x86. The compilers with a 128-bit integer type
+            // on the 64-bit targets do it in one instruction.
+            constexpr void multiply( uint64_t& a, uint64_t& b )
+            {
+#if defined( __SIZEOF_INT128__ )
+                const unsigned __int128 product = static_cast<unsigned __int128>( a ) * b;
+
+                a = static_cast<uint64_t>( product );
+                b = static_cast<uint64_t>( product >> 64 );
+#else
+                const uint64_t a_lo = static_cast<uint32_t>( a );
+                const uint64_t a_hi = a >> 32;
+                const uint64_t b_lo = static_cast<uint32_t>( b );
+                const uint64_t b_hi = b >> 32;
+
+                const uint64_t b00 = a_lo * b_lo;
+                const uint64_t b01 = a_lo * b_hi;
+                const uint64_t b10 = a_hi * b_lo;
+                const uint64_t b11 = a_hi * b_hi;
+
+                const uint64_t mid1 = b10 + ( b00 >> 32 );
+                const uint64_t mid2 = b01 + static_cast<uint32_t>( mid1 );
+
+                a = ( mid2 << 32 ) | static_cast<uint32_t>( b00 );
+                b = b11 + ( mid1 >> 32 ) + ( mid2 >> 32 );
+#endif
+            }
+
+            [[nodiscard]] constexpr uint64_t mix( uint64_t a, uint64_t b )
+            {
+                multiply( a, b );
+                return a ^ b;
+            }
+
+            constexpr uint64_t wy_secret[4] = { 0x2d358dccaa6c78a5ull,
+                                                0x8bb84b93962eacc9ull,
+                                                0x4b33a62ed433d4a3ull,
+                                                0x4d5a2da51de1aa47ull };
+
+            constexpr uint64_t xxh_prime1 = 0x9e3779b185ebca87ull;
+            constexpr uint64_t xxh_prime2 = 0xc2b2ae3d27d4eb4full;
+            constexpr uint64_t xxh_prime3 = 0x165667b19e3779f9ull;
+            constexpr uint64_t xxh_prime4 = 0x85ebca77c2b2ae63ull;
+            constexpr uint64_t xxh_prime5 = 0x27d4eb2f165667c5ull;
+
+            [[nodiscard]] constexpr uint64_t xxh_round( uint64_t acc, uint64_t input )
+            {
+                acc += input * xxh_prime2;
+                acc = rotl( acc, 31 );
+                return acc * xxh_prime1;
+            }
+
+            [[nodiscard]] constexpr uint64_t xxh_merge( uint64_t acc, uint64_t value )
+            {
+                acc ^= xxh_round( 0, value );
+                return acc * xxh_prime1 + xxh_prime4;
+            }
+        } // namespace hash
+    }     // namespace impl
+
+    // FNV-1a. Byte at a time, so it is best for short keys and compile-time string hashes.
+    [[nodiscard]] constexpr uint32_t fnv1a_32( const char* data, size_t size )
+    {
+        uint32_t hash = 0x811c9dc5u;
+
+        for ( size_t i = 0; i < size; ++i )
+        {
+            hash ^= static_cast<unsigned char>( data[i] );
+            hash *= 0x01000193u;
+        }
+
+        return hash;
+    }
+
+    [[nodiscard]] constexpr uint64_t fnv1a_64( const char* data, size_t size )
+    {
+        uint64_t hash = 0xcbf29ce484222325ull;
+
+        for ( size_t i = 0; i < size; ++i )
+        {
+            hash ^= static_cast<unsigned char>( data[i] );
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+    [[nodiscard]] constexpr uint32_t fnv1a_32( string_view str )
+    {
+        return fnv1a_32( str.data(), str.size() );
+    }
+
+    [[nodiscard]] constexpr uint64_t fnv1a_64( string_view str )
+    {
+        return fnv1a_64( str.data(), str.size() );
+    }
+
+    // Hash of the wyhash family: consumes 16 bytes per 64x64->128 multiplication and handles
+    // the short keys without loops. The general purpose hash of the library.
+    [[nodiscard]] constexpr uint64_t wyhash( const char* data, size_t size, uint64_t seed = 0 )
+    {
+        using namespace impl::hash;
+
+        const char* p = data;
+        uint64_t    a = 0;
+        uint64_t    b = 0;
+
+        seed ^= mix( seed ^ wy_secret[0], wy_secret[1] );
+
+        if ( size <= 16 )
+        {
+            if ( size >= 4 )
+            {
+                // NOTE: Two pairs of overlapping 4-byte loads cover any size from 4 to 16
+                const size_t offset = ( size >> 3 ) << 2;
+
+                a = ( read32( p ) << 32 ) | read32( p + offset );
+                b = ( read32( p + size - 4 ) << 32 ) | read32( p + size - 4 - offset );
+            }
+            else if ( size > 0 )
+            {
+                a = ( static_cast<uint64_t>( static_cast<unsigned char>( p[0] ) ) << 16 )
+                    | ( static_cast<uint64_t>( static_cast<unsigned char>( p[size >> 1] ) ) << 8 )
+                    | static_cast<unsigned char>( p[size - 1] );
+            }
+        }
+        else
+        {
+            size_t remaining = size;
+
+            if ( remaining > 48 )
+            {
+                uint64_t seed1 = seed;
+                uint64_t seed2 = seed;
+
+                do
+                {
+                    seed = mix( read64( p ) ^ wy_secret[1], read64( p + 8 ) ^ seed );
+                    seed1 = mix( read64( p + 16 ) ^ wy_secret[2], read64( p + 24 ) ^ seed1 );
+                    seed2 = mix( read64( p + 32 ) ^ wy_secret[3], read64( p + 40 ) ^ seed2 );
+
+                    p += 48;
+                    remaining -= 48;
+                } while ( remaining > 48 );
+
+                seed ^= seed1 ^ seed2;
+            }
+
+            while ( remaining > 16 )
+            {
+                seed = mix( read64( p ) ^ wy_secret[1], read64( p + 8 ) ^ seed );
+
+                p += 16;
+                remaining -= 16;
+            }
+
+            // NOTE: The last 16 bytes may overlap the already hashed ones
+            a = read64( p + remaining - 16 );
+            b = read64( p + remaining - 8 );
+        }
+
+        a ^= wy_secret[1];
+        b ^= seed;
+        multiply( a, b );
+
+        return mix( a ^ wy_secret[0] ^ size, b ^ wy_secret[1] );
+    }
+
+    [[nodiscard]] constexpr uint64_t wyhash( string_view str, uint64_t seed = 0 )
+    {
+        return wyhash( str.data(), str.size(), seed );
+    }
+
+    // CRC-32C (Castagnoli), e.g. for integrity checks. Uses the SSE4.2 CRC32 instruction, if the
+    // CPU has it. Pass the previous result as \crc to continue the checksum over the next
+    // buffer.
+    [[nodiscard]] uint32_t crc32c( const void* data, size_t size, uint32_t crc = 0 );
+
+    // Streaming XXH64: the same result as the reference xxHash for the same seed, however the
+    // data is split among \update calls. Runs 32 bytes per step in four independent lanes.
+    class xxhash64_state final
+    {
+    public:
+        constexpr explicit xxhash64_state( uint64_t seed = 0 )
+            : m_acc{ seed + impl::hash::xxh_prime1 + impl::hash::xxh_prime2,
+                     seed + impl::hash::xxh_prime2,
+                     seed,
+                     seed - impl::hash::xxh_prime1 }
+            , m_seed( seed )
+            , m_total_size( 0 )
+            , m_buffer{}
+            , m_buffer_size( 0 )
+        {
+        }
+
+        void update( const void* data, size_t size )
+        {
+            const char* p = static_cast<const char*>( data );
+            const char* last = p + size;
+
+            m_total_size += size;
+
+            if ( m_buffer_size + size < stripe_size )
+            {
+                if ( size > 0 )
+                    memcpy( m_buffer + m_buffer_size, p, size );
+
+                m_buffer_size += size;
+                return;
+            }
+
+            if ( m_buffer_size > 0 )
+            {
+                const size_t fill = stripe_size - m_buffer_size;
+
+                memcpy( m_buffer + m_buffer_size, p, fill );
+                consume( m_buffer );
+
+                p += fill;
+                m_buffer_size = 0;
+            }
+
+            for ( ; last - p >= static_cast<ptrdiff_t>( stripe_size ); p += stripe_size )
+                consume( p );
+
+            m_buffer_size = static_cast<size_t>( last - p );
+            if ( m_buffer_size > 0 )
+                memcpy( m_buffer, p, m_buffer_size );
+        }
+
+        [[nodiscard]] uint64_t digest() const
+        {
+            using namespace impl::hash;
+
+            uint64_t hash;
+
+            if ( m_total_size >= stripe_size )
+            {
+                hash = rotl( m_acc[0], 1 ) + rotl( m_acc[1], 7 ) + rotl( m_acc[2], 12 )
+                       + rotl( m_acc[3], 18 );
+
+                for ( uint64_t acc : m_acc )
+                    hash = xxh_merge( hash, acc );
+            }
+            else
+            {
+                hash = m_seed + xxh_prime5;
+            }
+
+            hash += m_total_size;
+
+            const char* p = m_buffer;
+            size_t      size = m_buffer_size;
+
+            for ( ; size >= 8; size -= 8, p += 8 )
+                hash = rotl( hash ^ xxh_round( 0, read64( p ) ), 27 ) * xxh_prime1 + xxh_prime4;
+
+            if ( size >= 4 )
+            {
+                hash = rotl( hash ^ ( read32( p ) * xxh_prime1 ), 23 ) * xxh_prime2 + xxh_prime3;
+                size -= 4;
+                p += 4;
+            }
+
+            for ( ; size > 0; --size, ++p )
+                hash = rotl( hash ^ ( static_cast<unsigned char>( *p ) * xxh_prime5 ), 11 )
+                       * xxh_prime1;
+
+            hash ^= hash >> 33;
+            hash *= xxh_prime2;
+            hash ^= hash >> 29;
+            hash *= xxh_prime3;
+            hash ^= hash >> 32;
+
+            return hash;
+        }
+
+    private:
+        static constexpr size_t stripe_size = 32;
+
+        void consume( const char* p )
+        {
+            using namespace impl::hash;
+
+            m_acc[0] = xxh_round( m_acc[0], read64( p ) );
+            m_acc[1] = xxh_round( m_acc[1], read64( p + 8 ) );
+            m_acc[2] = xxh_round( m_acc[2], read64( p + 16 ) );
+            m_acc[3] = xxh_round( m_acc[3], read64( p + 24 ) );
+        }
+
+        uint64_t m_acc[4];
+        uint64_t m_seed;
+        uint64_t m_total_size;
+        char     m_buffer[stripe_size];
+        size_t   m_buffer_size;
+    };
+
+    [[nodiscard]] inline uint64_t xxhash64( const void* data, size_t size, uint64_t seed = 0 )
+    {
+        xxhash64_state state( seed );
+        state.update( data, size );
+        return state.digest();
+    }
+} // namespace rtl
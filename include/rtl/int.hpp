@@ -17,8 +17,8 @@ namespace rtl
 
     typedef long long          intmax_t;
     typedef unsigned long long uintmax_t;
-    typedef signed int         ptrdiff_t;
-    typedef unsigned int       size_t;
+    typedef decltype( sizeof( 0 ) ) size_t;
+    typedef decltype( static_cast<int*>( nullptr ) - static_cast<int*>( nullptr ) ) ptrdiff_t;
     typedef signed long long   int64_t;
     typedef unsigned long long uint64_t;
     typedef signed int         int32_t;
@@ -29,7 +29,11 @@ namespace rtl
     typedef char               int8_t;
 
     static_assert( sizeof( unsigned ) == 4 );
+
+// NOTE: The library targets Windows, the benchmarks are built on LP64 Linux too
+#if defined( _WIN32 )
     static_assert( sizeof( unsigned long ) == 4 );
+#endif
 
     static_assert( sizeof( uintmax_t ) == 8 );
     static_assert( sizeof( uint64_t ) == 8 );
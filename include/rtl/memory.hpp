@@ -13,10 +13,40 @@
 #include <rtl/int.hpp>
 #include <rtl/utility.hpp>
 
+// NOTE: memcpy, memmove, memset, std::align_val_t and the placement new are declared by the C and
+// C++ runtime headers, so the library can share a translation unit with the standard library. The
+// runtime defines memcpy, memmove and memset itself if RTL_ENABLE_MEMCPY and RTL_ENABLE_MEMSET are
+// on.
+#if defined( _MSC_VER )
+    #include <vcruntime_new.h>
+    #include <vcruntime_string.h>
+#else
+    #include <new>
+    #include <string.h>
+#endif
+
 namespace rtl
 {
     using nullptr_t = decltype( nullptr );
 
+    // NOTE: Unlike the global operator new, these functions are available only if
+    // RTL_ENABLE_HEAP is on. Memory returned by \malloc is not initialized.
+    [[nodiscard]] void* malloc( size_t size );
+    [[nodiscard]] void* calloc( size_t num, size_t size );
+    void                free( void* ptr );
+
+    // NOTE: Minimum offset between two objects to avoid false sharing: data written by different
+    // threads must be at least this far apart, otherwise the cores fight for the cache line.
+    constexpr size_t hardware_destructive_interference_size = 64;
+
+    // Tag for the container constructors that leave trivial elements uninitialized
+    struct default_init_t
+    {
+        explicit default_init_t() = default;
+    };
+
+    inline constexpr default_init_t default_init{};
+
     namespace impl
     {
         template<typename T>
@@ -314,6 +344,107 @@ namespace rtl
         deleter_type m_deleter;
     };
 
+    template<typename T, typename... Args>
+    constexpr T* construct_at( T* p, Args&&... args )
+    {
+        return ::new ( static_cast<void*>( p ) ) T( rtl::forward<Args>( args )... );
+    }
+
+    template<typename T>
+    constexpr void destroy_at( T* p )
+    {
+        p->~T();
+    }
+
+    template<typename T, typename Size>
+    constexpr T* destroy_n( T* first, Size count )
+    {
+        if constexpr ( is_trivially_destructible<T>::value )
+        {
+            return first + count;
+        }
+        else
+        {
+            for ( Size i = 0; i < count; ++i )
+                rtl::destroy_at( first++ );
+
+            return first;
+        }
+    }
+
+    template<typename T, typename Size>
+    constexpr T* uninitialized_value_construct_n( T* first, Size count )
+    {
+        for ( Size i = 0; i < count; ++i )
+            ::new ( static_cast<void*>( first++ ) ) T();
+
+        return first;
+    }
+
+    // NOTE: Objects of trivial types are left uninitialized, the loop is optimized out for them
+    template<typename T, typename Size>
+    constexpr T* uninitialized_default_construct_n( T* first, Size count )
+    {
+        for ( Size i = 0; i < count; ++i )
+            ::new ( static_cast<void*>( first++ ) ) T;
+
+        return first;
+    }
+
+    template<typename T, typename Size, typename Value>
+    constexpr T* uninitialized_fill_n( T* first, Size count, const Value& value )
+    {
+        for ( Size i = 0; i < count; ++i )
+            ::new ( static_cast<void*>( first++ ) ) T( value );
+
+        return first;
+    }
+
+    template<typename InputIterator, typename Size, typename T>
+    constexpr T* uninitialized_copy_n( InputIterator src, Size count, T* dst )
+    {
+        for ( Size i = 0; i < count; ++i )
+            ::new ( static_cast<void*>( dst++ ) ) T( *src++ );
+
+        return dst;
+    }
+
+    template<typename InputIterator, typename Size, typename T>
+    constexpr T* uninitialized_move_n( InputIterator src, Size count, T* dst )
+    {
+        for ( Size i = 0; i < count; ++i )
+            ::new ( static_cast<void*>( dst++ ) ) T( rtl::move( *src++ ) );
+
+        return dst;
+    }
+
+    namespace impl
+    {
+        // Moves \count objects from \src to the uninitialized storage \dst and ends lifetime of
+        // the source objects. Trivially copyable objects are moved by a single memcpy.
+        template<typename T, typename Size>
+        constexpr T* relocate_n( T* src, Size count, T* dst )
+        {
+            if constexpr ( is_trivially_copyable<T>::value )
+            {
+                if ( count > 0 )
+                    memcpy( dst, src, count * sizeof( T ) );
+
+                return dst + count;
+            }
+            else
+            {
+                for ( Size i = 0; i < count; ++i, ++src )
+                {
+                    ::new ( static_cast<void*>( dst++ ) ) T( rtl::move( *src ) );
+                    rtl::destroy_at( src );
+                }
+
+                return dst;
+            }
+        }
+    } // namespace impl
+
     template<typename T, typename... Args>
     [[nodiscard]] typename enable_if<!is_array<T>::value, unique_ptr<T>>::type
     make_unique( Args&&... args )
@@ -328,4 +459,20 @@ namespace rtl
     {
         return unique_ptr<T>( new typename remove_extent<T>::type[n]() );
     }
+
+    template<typename T>
+    [[nodiscard]] typename enable_if<!is_array<T>::value, unique_ptr<T>>::type
+    make_unique_for_overwrite()
+    {
+        return unique_ptr<T>( new T );
+    }
+
+    // NOTE: Elements of trivial types are left uninitialized
+    template<typename T>
+    [[nodiscard]]
+    typename enable_if<is_same<T, typename remove_extent<T>::type[]>::value, unique_ptr<T>>::type
+    make_unique_for_overwrite( size_t n )
+    {
+        return unique_ptr<T>( new typename remove_extent<T>::type[n] );
+    }
 } // namespace rtl
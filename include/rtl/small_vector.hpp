@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/algorithm.hpp>
+#include <rtl/allocator.hpp>
+#include <rtl/limits.hpp>
+#include <rtl/memory.hpp>
+
+namespace rtl
+{
+    // Vector that keeps up to \N elements in the object itself and allocates memory only when it
+    // outgrows them. Has the same interface as \rtl::vector.
+    template<typename T, size_t N, typename Allocator = rtl::allocator<T>>
+    class small_vector final : private impl::allocator_holder<Allocator>
+    {
+    public:
+        typedef T         element_type;
+        typedef Allocator allocator_type;
+
+        static_assert( N > 0, "inline capacity must be positive" );
+        static_assert( is_same<typename Allocator::value_type, T>::value,
+                       "allocator value type mismatch" );
+
+        constexpr small_vector()
+            : small_vector( Allocator() )
+        {
+        }
+
+        constexpr explicit small_vector( const Allocator& allocator )
+            : impl::allocator_holder<Allocator>( allocator )
+            , m_size( 0 )
+            , m_capacity( N )
+            , m_data( inline_data() )
+        {
+        }
+
+        constexpr small_vector( size_t size,
+                                element_type&& value,
+                                const Allocator& allocator = Allocator() )
+            : small_vector( allocator )
+        {
+            reserve( size );
+            rtl::uninitialized_fill_n( m_data, size, value );
+            m_size = size;
+        }
+
+        constexpr explicit small_vector( size_t size, const Allocator& allocator = Allocator() )
+            : small_vector( allocator )
+        {
+            reserve( size );
+            rtl::uninitialized_value_construct_n( m_data, size );
+            m_size = size;
+        }
+
+        // NOTE: Elements of trivial types are left uninitialized
+        constexpr small_vector( size_t size,
+                                default_init_t,
+                                const Allocator& allocator = Allocator() )
+            : small_vector( allocator )
+        {
+            reserve( size );
+            rtl::uninitialized_default_construct_n( m_data, size );
+            m_size = size;
+        }
+
+        ~small_vector()
+        {
+            rtl::destroy_n( m_data, m_size );
+            deallocate();
+        }
+
+        constexpr small_vector( const small_vector& that )
+            : small_vector( that.get_allocator() )
+        {
+            reserve( that.m_size );
+            rtl::uninitialized_copy_n( that.m_data, that.m_size, m_data );
+            m_size = that.m_size;
+        }
+
+        constexpr small_vector& operator=( const small_vector& that )
+        {
+            if ( this != &that )
+            {
+                clear();
+                reserve( that.m_size );
+
+                rtl::uninitialized_copy_n( that.m_data, that.m_size, m_data );
+                m_size = that.m_size;
+            }
+
+            return *this;
+        }
+
+        constexpr small_vector( small_vector&& that )
+            : small_vector( that.get_allocator() )
+        {
+            steal( that );
+        }
+
+        constexpr small_vector& operator=( small_vector&& that )
+        {
+            if ( this != &that )
+            {
+                rtl::destroy_n( m_data, m_size );
+                deallocate();
+
+                this->replace_allocator( that );
+
+                m_size = 0;
+                m_capacity = N;
+                m_data = inline_data();
+
+                steal( that );
+            }
+
+            return *this;
+        }
+
+        [[nodiscard]] constexpr const element_type* data() const
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr element_type* data()
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr element_type& front()
+        {
+            return m_data[0];
+        }
+
+        [[nodiscard]] constexpr const element_type& front() const
+        {
+            return m_data[0];
+        }
+
+        [[nodiscard]] constexpr element_type& back()
+        {
+            return m_data[size() - 1];
+        }
+
+        [[nodiscard]] constexpr const element_type& back() const
+        {
+            return m_data[size() - 1];
+        }
+
+        [[nodiscard]] constexpr element_type* begin()
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr element_type* end()
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] constexpr const element_type* begin() const
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr const element_type* end() const
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] constexpr element_type& operator[]( size_t index )
+        {
+            return m_data[index];
+        }
+
+        [[nodiscard]] constexpr const element_type& operator[]( size_t index ) const
+        {
+            return m_data[index];
+        }
+
+        [[nodiscard]] constexpr size_t size() const
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr size_t capacity() const
+        {
+            return m_capacity;
+        }
+
+        [[nodiscard]] constexpr bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr allocator_type get_allocator() const
+        {
+            return this->allocator_ref();
+        }
+
+        // NOTE: Returns true while the elements are stored in the object itself
+        [[nodiscard]] constexpr bool is_inline() const
+        {
+            return m_data == inline_data();
+        }
+
+        constexpr void push_back( element_type&& element )
+        {
+            emplace_back( rtl::move( element ) );
+        }
+
+        constexpr void push_back( const element_type& element )
+        {
+            emplace_back( element );
+        }
+
+        template<typename... Args>
+        constexpr element_type& emplace_back( Args&&... args )
+        {
+            if ( m_size < m_capacity )
+                return *rtl::construct_at( m_data + m_size++, rtl::forward<Args>( args )... );
+
+            // NOTE: The new element is constructed before relocation, because \args may refer
+            // to the elements of this vector
+            const size_t  capacity = grown_capacity();
+            element_type* new_data = this->allocator_ref().allocate( capacity );
+            element_type* element
+                = rtl::construct_at( new_data + m_size, rtl::forward<Args>( args )... );
+
+            impl::relocate_n( m_data, m_size, new_data );
+            deallocate();
+
+            m_data = new_data;
+            m_capacity = capacity;
+            ++m_size;
+
+            return *element;
+        }
+
+        constexpr void pop_back()
+        {
+            rtl::destroy_at( m_data + --m_size );
+        }
+
+        constexpr void clear()
+        {
+            rtl::destroy_n( m_data, m_size );
+            m_size = 0;
+        }
+
+        constexpr void resize( size_t size )
+        {
+            if ( size > m_size )
+            {
+                if ( size > m_capacity )
+                    reallocate( size ); // TODO: do align?
+
+                rtl::uninitialized_value_construct_n( m_data + m_size, size - m_size );
+            }
+            else
+            {
+                rtl::destroy_n( m_data + size, m_size - size );
+            }
+
+            m_size = size;
+        }
+
+        // NOTE: New elements of trivial types are left uninitialized
+        constexpr void resize( size_t size, default_init_t )
+        {
+            if ( size > m_size )
+            {
+                if ( size > m_capacity )
+                    reallocate( size ); // TODO: do align?
+
+                rtl::uninitialized_default_construct_n( m_data + m_size, size - m_size );
+            }
+            else
+            {
+                rtl::destroy_n( m_data + size, m_size - size );
+            }
+
+            m_size = size;
+        }
+
+        constexpr void reserve( size_t capacity )
+        {
+            if ( m_capacity < capacity )
+                reallocate( capacity ); // TODO: do align?
+        }
+
+    private:
+        [[nodiscard]] constexpr element_type* inline_data()
+        {
+            return reinterpret_cast<element_type*>( m_inline );
+        }
+
+        [[nodiscard]] constexpr const element_type* inline_data() const
+        {
+            return reinterpret_cast<const element_type*>( m_inline );
+        }
+
+        constexpr void deallocate()
+        {
+            if ( !is_inline() )
+                this->allocator_ref().deallocate( m_data, m_capacity );
+        }
+
+        [[nodiscard]] constexpr size_t grown_capacity() const
+        {
+            if ( rtl::numeric_limits<size_t>::max() - m_capacity < m_capacity )
+                return rtl::numeric_limits<size_t>::max(); // TODO: do align?
+
+            return m_capacity * 2;
+        }
+
+        constexpr void reallocate( size_t capacity )
+        {
+            element_type* new_data = this->allocator_ref().allocate( capacity );
+
+            impl::relocate_n( m_data, m_size, new_data );
+            deallocate();
+
+            m_data = new_data;
+            m_capacity = capacity;
+        }
+
+        // NOTE: Expects this vector to be empty and inline. Heap buffer is taken over as is,
+        // inline elements are relocated one by one.
+        constexpr void steal( small_vector& that )
+        {
+            if ( that.is_inline() )
+            {
+                impl::relocate_n( that.m_data, that.m_size, m_data );
+            }
+            else
+            {
+                m_data = that.m_data;
+                m_capacity = that.m_capacity;
+
+                that.m_data = that.inline_data();
+                that.m_capacity = N;
+            }
+
+            m_size = that.m_size;
+            that.m_size = 0;
+        }
+
+        size_t        m_size;
+        size_t        m_capacity;
+        element_type* m_data;
+
+        alignas( element_type ) unsigned char m_inline[N * sizeof( element_type )];
+    };
+} // namespace rtl
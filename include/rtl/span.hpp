@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/int.hpp>
+#include <rtl/type_traits.hpp>
+
+namespace rtl
+{
+    // Non-owning view of a contiguous sequence of objects.
+    template<typename T>
+    class span final
+    {
+    public:
+        using element_type = T;
+
+        constexpr span()
+            : m_data( nullptr )
+            , m_size( 0 )
+        {
+        }
+
+        constexpr span( T* data, size_t size )
+            : m_data( data )
+            , m_size( size )
+        {
+        }
+
+        template<size_t N>
+        // cppcheck-suppress noExplicitConstructor
+        constexpr span( T ( &array )[N] )
+            : m_data( array )
+            , m_size( N )
+        {
+        }
+
+        template<typename U,
+                 typename = typename enable_if<is_same<const U, T>::value
+                                               && !is_same<U, T>::value>::type>
+        // cppcheck-suppress noExplicitConstructor
+        constexpr span( const span<U>& that )
+            : m_data( that.data() )
+            , m_size( that.size() )
+        {
+        }
+
+        [[nodiscard]] constexpr T* data() const
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr size_t size() const
+        {
+            return m_size;
+        }
+
+        [[nodiscard]] constexpr size_t size_bytes() const
+        {
+            return m_size * sizeof( T );
+        }
+
+        [[nodiscard]] constexpr bool empty() const
+        {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] constexpr T* begin() const
+        {
+            return m_data;
+        }
+
+        [[nodiscard]] constexpr T* end() const
+        {
+            return m_data + m_size;
+        }
+
+        [[nodiscard]] constexpr T& operator[]( size_t index ) const
+        {
+            return m_data[index];
+        }
+
+        [[nodiscard]] constexpr span first( size_t count ) const
+        {
+            return span( m_data, count );
+        }
+
+        [[nodiscard]] constexpr span subspan( size_t offset ) const
+        {
+            return span( m_data + offset, m_size - offset );
+        }
+
+    private:
+        T*     m_data;
+        size_t m_size;
+    };
+} // namespace rtl
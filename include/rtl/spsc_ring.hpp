@@ -0,0 +1,364 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/algorithm.hpp>
+#include <rtl/atomic.hpp>
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/span.hpp>
+#include <rtl/type_traits.hpp>
+
+namespace rtl
+{
+    // Lock-free ring buffer of \N elements for exactly one producer thread and one consumer
+    // thread. The producer calls the push and write functions, the consumer calls the pop and
+    // read functions.
+    //
+    // NOTE: The indices run freely and wrap around only in the element access, so a full ring
+    // holds all \N elements. Each side keeps a copy of the other's index and reloads it only
+    // when the copy says there is no room, so the shared cache lines are touched rarely.
+    template<typename T, size_t N>
+    class spsc_ring final
+    {
+        static_assert( N >= 2 && ( N & ( N - 1 ) ) == 0, "Capacity must be a power of 2" );
+        static_assert( is_trivially_copyable<T>::value, "Elements must be trivially copyable" );
+
+    public:
+        using value_type = T;
+
+        spsc_ring()
+            : m_producer{ 0, 0 }
+            , m_consumer{ 0, 0 }
+        {
+        }
+
+        spsc_ring( const spsc_ring& ) = delete;
+        spsc_ring& operator=( const spsc_ring& ) = delete;
+
+        [[nodiscard]] static constexpr size_t capacity()
+        {
+            return N;
+        }
+
+        // NOTE: Exact only if the ring is not being changed, otherwise an estimate
+        [[nodiscard]] size_t size() const
+        {
+            const size_t head = m_consumer.head.load( memory_order_acquire );
+            return m_producer.tail.load( memory_order_acquire ) - head;
+        }
+
+        [[nodiscard]] bool empty() const
+        {
+            return size() == 0;
+        }
+
+        [[nodiscard]] bool try_push( const T& value )
+        {
+            const size_t tail = m_producer.tail.load( memory_order_relaxed );
+
+            if ( free_space( tail, 1 ) == 0 )
+                return false;
+
+            m_data[tail & mask] = value;
+            m_producer.tail.store( tail + 1, memory_order_release );
+            return true;
+        }
+
+        // Copies up to \count elements into the ring, returns the number of the copied ones
+        size_t push_n( const T* values, size_t count )
+        {
+            const size_t tail = m_producer.tail.load( memory_order_relaxed );
+            const size_t index = tail & mask;
+
+            count = rtl::min( count, free_space( tail, count ) );
+
+            const size_t first = rtl::min( count, N - index );
+            rtl::copy_n( values, first, m_data + index );
+            rtl::copy_n( values + first, count - first, m_data );
+
+            m_producer.tail.store( tail + count, memory_order_release );
+            return count;
+        }
+
+        // Returns the free slots, at most \count of them, that follow each other in memory. The
+        // span is empty if the ring is full. The elements are published by \commit_write.
+        [[nodiscard]] span<T> write_span( size_t count = N )
+        {
+            const size_t tail = m_producer.tail.load( memory_order_relaxed );
+            const size_t index = tail & mask;
+
+            count = rtl::min( count, free_space( tail, count ) );
+            return span<T>( m_data + index, rtl::min( count, N - index ) );
+        }
+
+        void commit_write( size_t count )
+        {
+            const size_t tail = m_producer.tail.load( memory_order_relaxed );
+            m_producer.tail.store( tail + count, memory_order_release );
+        }
+
+        [[nodiscard]] bool try_pop( T& value )
+        {
+            const size_t head = m_consumer.head.load( memory_order_relaxed );
+
+            if ( used_space( head, 1 ) == 0 )
+                return false;
+
+            value = m_data[head & mask];
+            m_consumer.head.store( head + 1, memory_order_release );
+            return true;
+        }
+
+        // Moves up to \count elements out of the ring, returns the number of the moved ones
+        size_t pop_n( T* values, size_t count )
+        {
+            const size_t head = m_consumer.head.load( memory_order_relaxed );
+            const size_t index = head & mask;
+
+            count = rtl::min( count, used_space( head, count ) );
+
+            const size_t first = rtl::min( count, N - index );
+            rtl::copy_n( m_data + index, first, values );
+            rtl::copy_n( m_data, count - first, values + first );
+
+            m_consumer.head.store( head + count, memory_order_release );
+            return count;
+        }
+
+        // Returns the elements, at most \count of them, that follow each other in memory. The
+        // span is empty if the ring is empty. The elements are released by \commit_read.
+        [[nodiscard]] span<const T> read_span( size_t count = N )
+        {
+            const size_t head = m_consumer.head.load( memory_order_relaxed );
+            const size_t index = head & mask;
+
+            count = rtl::min( count, used_space( head, count ) );
+            return span<const T>( m_data + index, rtl::min( count, N - index ) );
+        }
+
+        void commit_read( size_t count )
+        {
+            const size_t head = m_consumer.head.load( memory_order_relaxed );
+            m_consumer.head.store( head + count, memory_order_release );
+        }
+
+    private:
+        static constexpr size_t mask = N - 1;
+
+        // NOTE: Reloads the consumer index only if the cached one shows less than \wanted slots
+        size_t free_space( size_t tail, size_t wanted )
+        {
+            size_t space = N - ( tail - m_producer.cached_head );
+
+            if ( space < wanted )
+            {
+                m_producer.cached_head = m_consumer.head.load( memory_order_acquire );
+                space = N - ( tail - m_producer.cached_head );
+            }
+
+            return space;
+        }
+
+        size_t used_space( size_t head, size_t wanted )
+        {
+            size_t space = m_consumer.cached_tail - head;
+
+            if ( space < wanted )
+            {
+                m_consumer.cached_tail = m_producer.tail.load( memory_order_acquire );
+                space = m_consumer.cached_tail - head;
+            }
+
+            return space;
+        }
+
+        struct alignas( hardware_destructive_interference_size ) producer_state
+        {
+            atomic<size_t> tail;
+            size_t         cached_head;
+        };
+
+        struct alignas( hardware_destructive_interference_size ) consumer_state
+        {
+            atomic<size_t> head;
+            size_t         cached_tail;
+        };
+
+        producer_state m_producer;
+        consumer_state m_consumer;
+
+        alignas( hardware_destructive_interference_size ) T m_data[N];
+    };
+
+    // Lock-free ring buffer of \N bytes for the records of variable size, with exactly one
+    // producer thread and one consumer thread.
+    //
+    // NOTE: A record is an 8-byte header with its size followed by the payload, padded to 8
+    // bytes. Records never wrap around: if there is no room up to the end of the buffer, the
+    // producer fills the rest with a wrap marker, which the consumer skips. So a payload is
+    // always one contiguous span and can be read in place.
+    template<size_t N>
+    class spsc_byte_ring final
+    {
+        static_assert( N >= 16 && ( N & ( N - 1 ) ) == 0, "Capacity must be a power of 2" );
+
+    public:
+        spsc_byte_ring()
+            : m_producer{ 0, 0, 0 }
+            , m_consumer{ 0, 0, 0 }
+        {
+        }
+
+        spsc_byte_ring( const spsc_byte_ring& ) = delete;
+        spsc_byte_ring& operator=( const spsc_byte_ring& ) = delete;
+
+        // The largest payload that fits the empty ring
+        [[nodiscard]] static constexpr size_t max_record_size()
+        {
+            return N - header_size;
+        }
+
+        // Reserves a record of \size bytes and returns its payload, or an empty span with null
+        // data if there is no room. The record is published by \commit_write.
+        [[nodiscard]] span<uint8_t> begin_write( size_t size )
+        {
+            if ( size > max_record_size() )
+                return {};
+
+            const size_t needed = record_size( size );
+
+            size_t tail = m_producer.tail.load( memory_order_relaxed );
+            size_t index = tail & mask;
+
+            if ( needed > N - index )
+            {
+                // NOTE: The marker is published alone, so the space it occupies is freed by
+                // the consumer even if the record itself does not fit yet
+                const size_t rest = N - index;
+
+                if ( free_space( tail, rest ) < rest )
+                    return {};
+
+                header( index ) = wrap_marker;
+                tail += rest;
+                index = 0;
+
+                m_producer.tail.store( tail, memory_order_release );
+            }
+
+            if ( free_space( tail, needed ) < needed )
+                return {};
+
+            header( index ) = static_cast<uint32_t>( size );
+            m_producer.pending_tail = tail + needed;
+
+            return span<uint8_t>( m_data + index + header_size, size );
+        }
+
+        void commit_write()
+        {
+            m_producer.tail.store( m_producer.pending_tail, memory_order_release );
+        }
+
+        bool push( const void* data, size_t size )
+        {
+            span<uint8_t> record = begin_write( size );
+            if ( record.data() == nullptr )
+                return false;
+
+            rtl::copy_n( static_cast<const uint8_t*>( data ), size, record.data() );
+            commit_write();
+            return true;
+        }
+
+        // Returns the payload of the oldest record, or an empty span with null data if there are
+        // no records. The record is released by \pop.
+        [[nodiscard]] span<const uint8_t> front()
+        {
+            for ( ;; )
+            {
+                const size_t head = m_consumer.head.load( memory_order_relaxed );
+
+                if ( head == m_consumer.cached_tail )
+                {
+                    m_consumer.cached_tail = m_producer.tail.load( memory_order_acquire );
+                    if ( head == m_consumer.cached_tail )
+                        return {};
+                }
+
+                const size_t   index = head & mask;
+                const uint32_t size = header( index );
+
+                if ( size == wrap_marker )
+                {
+                    m_consumer.head.store( head + N - index, memory_order_release );
+                    continue;
+                }
+
+                m_consumer.pending_head = head + record_size( size );
+                return span<const uint8_t>( m_data + index + header_size, size );
+            }
+        }
+
+        void pop()
+        {
+            m_consumer.head.store( m_consumer.pending_head, memory_order_release );
+        }
+
+    private:
+        static constexpr size_t   mask = N - 1;
+        static constexpr size_t   header_size = 8;
+        static constexpr uint32_t wrap_marker = 0xffffffffu;
+
+        [[nodiscard]] static constexpr size_t record_size( size_t size )
+        {
+            return ( header_size + size + 7 ) & ~size_t( 7 );
+        }
+
+        uint32_t& header( size_t index )
+        {
+            return *reinterpret_cast<uint32_t*>( m_data + index );
+        }
+
+        size_t free_space( size_t tail, size_t wanted )
+        {
+            size_t space = N - ( tail - m_producer.cached_head );
+
+            if ( space < wanted )
+            {
+                m_producer.cached_head = m_consumer.head.load( memory_order_acquire );
+                space = N - ( tail - m_producer.cached_head );
+            }
+
+            return space;
+        }
+
+        struct alignas( hardware_destructive_interference_size ) producer_state
+        {
+            atomic<size_t> tail;
+            size_t         cached_head;
+            size_t         pending_tail;
+        };
+
+        struct alignas( hardware_destructive_interference_size ) consumer_state
+        {
+            atomic<size_t> head;
+            size_t         cached_tail;
+            size_t         pending_head;
+        };
+
+        producer_state m_producer;
+        consumer_state m_consumer;
+
+        alignas( hardware_destructive_interference_size ) uint8_t m_data[N];
+    };
+} // namespace rtl
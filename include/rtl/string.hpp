@@ -11,10 +11,21 @@
 #pragma once
 
 #include <rtl/algorithm.hpp>
+#include <rtl/allocator.hpp>
 #include <rtl/memory.hpp>
 
 namespace rtl
 {
+    namespace impl
+    {
+        // NOTE: SSE2 versions of the narrow string search. Return (size_t)-1 if nothing is found.
+        size_t find( const char* str, size_t size, char ch );
+        size_t find( const char* str, size_t size, const char* pattern, size_t pattern_size );
+        size_t rfind( const char* str, size_t size, char ch );
+        size_t rfind( const char* str, size_t size, const char* pattern, size_t pattern_size );
+        size_t find_first_of( const char* str, size_t size, const char* chars, size_t chars_size );
+    } // namespace impl
+
     // TODO: implement more methods
     template<typename T>
     class basic_string_view final
@@ -62,11 +73,16 @@ namespace rtl
             return m_size == 0;
         }
 
+        // NOTE: memcmp compares many characters per step, the loop is for the constant
+        // evaluation
         [[nodiscard]] constexpr bool operator==( const basic_string_view<T>& rhs ) const
         {
             if ( size() != rhs.size() )
                 return false;
 
+            if ( !rtl::is_constant_evaluated() )
+                return size() == 0 || memcmp( data(), rhs.data(), size() * sizeof( T ) ) == 0;
+
             const value_type* l = data();
             const value_type* r = rhs.data();
 
@@ -77,111 +93,216 @@ namespace rtl
             return true;
         }
 
-        [[nodiscard]] constexpr size_t find( const basic_string_view<T>& what ) const
+        [[nodiscard]] constexpr size_t find( const basic_string_view<T>& what,
+                                             size_t                      from = 0 ) const
+        {
+            if ( from > m_size || what.m_size > m_size - from )
+                return npos;
+
+            if constexpr ( is_same<T, char>::value )
+            {
+                if ( !rtl::is_constant_evaluated() )
+                    return offset(
+                        impl::find( m_data + from, m_size - from, what.m_data, what.m_size ),
+                        from );
+            }
+
+            for ( size_t i = from; i <= m_size - what.m_size; ++i )
+                if ( equal( m_data + i, what ) )
+                    return i;
+
+            return npos;
+        }
+
+        [[nodiscard]] constexpr size_t find( value_type ch, size_t from = 0 ) const
         {
-            // TODO: use Strsafe.h routines?
-            const value_type* str = data();
-            const value_type* str_end = data() + size();
-            const value_type* pattern = what.data();
-            const value_type* pattern_end = what.data() + what.size();
+            if ( from >= m_size )
+                return npos;
 
-            for ( ; str < str_end; ++str )
+            if constexpr ( is_same<T, char>::value )
             {
-                if ( *str == *pattern )
-                {
-                    if ( ++pattern >= pattern_end )
-                        return (size_t)( str - data() );
-                }
-                else
-                {
-                    pattern = what.data();
-                }
+                if ( !rtl::is_constant_evaluated() )
+                    return offset( impl::find( m_data + from, m_size - from, ch ), from );
             }
 
+            for ( size_t i = from; i < m_size; ++i )
+                if ( m_data[i] == ch )
+                    return i;
+
+            return npos;
+        }
+
+        // NOTE: Finds the last occurrence that starts at or before \pos
+        [[nodiscard]] constexpr size_t rfind( const basic_string_view<T>& what,
+                                              size_t                      pos = npos ) const
+        {
+            if ( what.m_size > m_size )
+                return npos;
+
+            const size_t last = rtl::min( pos, m_size - what.m_size );
+
+            if constexpr ( is_same<T, char>::value )
+            {
+                if ( !rtl::is_constant_evaluated() )
+                    return impl::rfind( m_data, last + what.m_size, what.m_data, what.m_size );
+            }
+
+            for ( size_t i = last + 1; i-- > 0; )
+                if ( equal( m_data + i, what ) )
+                    return i;
+
+            return npos;
+        }
+
+        [[nodiscard]] constexpr size_t rfind( value_type ch, size_t from = npos ) const
+        {
+            if ( m_size == 0 )
+                return npos;
+
+            const size_t last = rtl::min( from, m_size - 1 );
+
+            if constexpr ( is_same<T, char>::value )
+            {
+                if ( !rtl::is_constant_evaluated() )
+                    return impl::rfind( m_data, last + 1, ch );
+            }
+
+            for ( size_t i = last + 1; i-- > 0; )
+                if ( m_data[i] == ch )
+                    return i;
+
+            return npos;
+        }
+
+        [[nodiscard]] constexpr size_t find_first_of( const basic_string_view<T>& chars,
+                                                      size_t                      from = 0 ) const
+        {
+            if ( from >= m_size )
+                return npos;
+
+            if constexpr ( is_same<T, char>::value )
+            {
+                if ( !rtl::is_constant_evaluated() )
+                    return offset( impl::find_first_of(
+                                       m_data + from, m_size - from, chars.m_data, chars.m_size ),
+                                   from );
+            }
+
+            for ( size_t i = from; i < m_size; ++i )
+                for ( size_t j = 0; j < chars.m_size; ++j )
+                    if ( m_data[i] == chars.m_data[j] )
+                        return i;
+
             return npos;
         }
 
     private:
+        [[nodiscard]] static constexpr bool equal( const value_type* str,
+                                                   const basic_string_view<T>& what )
+        {
+            for ( size_t i = 0; i < what.m_size; ++i )
+                if ( str[i] != what.m_data[i] )
+                    return false;
+
+            return true;
+        }
+
+        [[nodiscard]] static constexpr size_t offset( size_t index, size_t from )
+        {
+            return index == npos ? npos : index + from;
+        }
+
         const value_type* m_data;
         size_t            m_size;
     };
 
-    // TODO: Implement SSO? (it's not code size friendly)
-    // TODO: Align buffer size
-    template<typename T>
-    class basic_string final
+    // String with a separate capacity that grows geometrically, so appending in a loop takes
+    // amortized constant time per character. Buffer always holds the terminating zero.
+    //
+    // With RTL_ENABLE_STRING_SSO short strings are kept in the object itself. Otherwise the
+    // object holds only the terminator of the empty string, so neither layout allocates for it.
+    // The local buffer takes the place of the capacity, so without SSO the object is just the
+    // pointer, the size and the capacity.
+    template<typename T, typename Allocator = rtl::allocator<T>>
+    class basic_string final : private impl::allocator_holder<Allocator>
     {
     public:
         using value_type = T;
+        using allocator_type = Allocator;
+
+        static_assert( is_same<typename Allocator::value_type, T>::value,
+                       "allocator value type mismatch" );
 
         static constexpr size_t npos = (size_t)-1;
 
         constexpr basic_string()
-            : m_data( new value_type[1] )
+            : basic_string( Allocator() )
+        {
+        }
+
+        constexpr explicit basic_string( const Allocator& allocator )
+            : impl::allocator_holder<Allocator>( allocator )
+            , m_data( local_data() )
             , m_size( 0 )
+            , m_local{}
         {
-            m_data[m_size] = 0;
         }
 
-        constexpr basic_string( size_t size, value_type ch )
-            : m_data( new value_type[size + 1] )
-            , m_size( size )
+        constexpr basic_string( size_t size, value_type ch, const Allocator& allocator = Allocator() )
+            : basic_string( allocator )
         {
-            rtl::fill_n( m_data.get(), m_size, ch );
-            m_data[size] = 0;
+            reserve( size );
+            rtl::fill_n( m_data, size, ch );
+            set_size( size );
         }
 
-        // cppcheck-suppress noExplicitConstructor
-        constexpr basic_string( const value_type* str )
-            : basic_string()
+        // NOTE: Characters are left uninitialized, only the terminating zero is written
+        constexpr basic_string( size_t size, default_init_t, const Allocator& allocator = Allocator() )
+            : basic_string( allocator )
         {
-            const value_type* last = str;
-            for ( ; *last; )
-                ++last;
+            reserve( size );
+            set_size( size );
+        }
 
-            m_size = static_cast<size_t>( last - str );
-            m_data.reset( new value_type[m_size + 1] );
-            rtl::copy_n( str, m_size, m_data.get() );
-            m_data[m_size] = 0;
+        // cppcheck-suppress noExplicitConstructor
+        constexpr basic_string( const value_type* str, const Allocator& allocator = Allocator() )
+            : basic_string( basic_string_view<T>( str ), allocator )
+        {
         }
 
         constexpr basic_string( nullptr_t ) = delete;
 
-        constexpr explicit basic_string( const basic_string_view<T>& view )
-            // TODO: rtl::make_unique
-            : m_data( new value_type[view.size() + 1] )
-            , m_size( view.size() )
+        constexpr explicit basic_string( const basic_string_view<T>& view,
+                                         const Allocator&            allocator = Allocator() )
+            : basic_string( allocator )
         {
-            // TODO: use Strsafe.h routines?
-            value_type*       dst = m_data.get();
-            const value_type* src = view.data();
-
-            for ( size_t i = 0; i < view.size(); ++i )
-                *dst++ = *src++;
+            assign( view );
+        }
 
-            *dst = 0;
+        ~basic_string()
+        {
+            deallocate();
         }
 
+        // NOTE: Keeps the capacity
         constexpr void clear()
         {
-            m_data.reset( new value_type[1] );
-            m_size = 0;
-            m_data[m_size] = 0;
+            set_size( 0 );
         }
 
         [[nodiscard]] constexpr const value_type* data() const
         {
-            return m_data.get();
+            return m_data;
         }
 
         [[nodiscard]] constexpr value_type* data()
         {
-            return m_data.get();
+            return m_data;
         }
 
         [[nodiscard]] constexpr const value_type* c_str() const
         {
-            return m_data.get();
+            return m_data;
         }
 
         [[nodiscard]] constexpr size_t size() const
@@ -189,83 +310,133 @@ namespace rtl
             return m_size;
         }
 
+        [[nodiscard]] constexpr size_t capacity() const
+        {
+            return is_local() ? local_capacity : m_capacity;
+        }
+
         [[nodiscard]] constexpr bool empty() const
         {
             return m_size == 0;
         }
 
-        // TODO: basic_string_view::find
-        [[nodiscard]] constexpr size_t rfind( const basic_string_view<T>& what ) const
+        [[nodiscard]] constexpr allocator_type get_allocator() const
+        {
+            return this->allocator_ref();
+        }
+
+        constexpr void reserve( size_t capacity )
+        {
+            if ( capacity > this->capacity() )
+                reallocate( capacity );
+        }
+
+        constexpr basic_string& append( const basic_string_view<T>& view )
         {
-            // TODO: use Strsafe.h routines?
-            const value_type* str = data() + size() - 1;
-            const value_type* pattern = what.data() + what.size() - 1;
+            const size_t size = m_size + view.size();
+
+            if ( size > capacity() )
+            {
+                // NOTE: \view may refer to this string, so the old buffer is kept until the
+                // characters are copied
+                value_type* data = allocate( grown_capacity( size ) );
+                rtl::copy_n( m_data, m_size, data );
+                rtl::copy_n( view.data(), view.size(), data + m_size );
 
-            for ( ; str >= data(); --str )
+                replace_buffer( data, grown_capacity( size ) );
+            }
+            else
             {
-                if ( *str == *pattern )
-                {
-                    if ( --pattern < what.data() )
-                        return (size_t)( str - data() );
-                }
-                else
-                {
-                    pattern = what.data() + what.size() - 1;
-                }
+                rtl::copy_n( view.data(), view.size(), m_data + m_size );
             }
 
-            return npos;
+            set_size( size );
+            return *this;
         }
 
-        [[nodiscard]] constexpr size_t find( const basic_string_view<T>& what ) const
+        constexpr basic_string& append( size_t count, value_type ch )
         {
-            return rtl::basic_string_view<value_type>( *this ).find( what );
+            const size_t size = m_size + count;
+
+            if ( size > capacity() )
+                reallocate( grown_capacity( size ) );
+
+            rtl::fill_n( m_data + m_size, count, ch );
+            set_size( size );
+            return *this;
         }
 
-        [[nodiscard]] constexpr basic_string substr( size_t from, size_t to = npos ) const
+        constexpr void push_back( value_type ch )
         {
-            if ( from == npos )
-                return basic_string<value_type>();
+            if ( m_size == capacity() )
+                reallocate( grown_capacity( m_size + 1 ) );
 
-            return basic_string<value_type>(
-                basic_string_view( data() + from, rtl::min( m_size, to ) - from ) );
+            m_data[m_size] = ch;
+            set_size( m_size + 1 );
         }
 
-        [[nodiscard]] constexpr basic_string operator+( basic_string_view<T> rhs ) const
+        constexpr basic_string& operator+=( const basic_string_view<T>& view )
         {
-            // TODO: use Strsafe.h routines?
-            basic_string<value_type> result( size() + rhs.size(), 0 );
+            return append( view );
+        }
 
-            const value_type* src = data();
-            value_type*       dst = result.m_data.get();
+        constexpr basic_string& operator+=( value_type ch )
+        {
+            push_back( ch );
+            return *this;
+        }
 
-            for ( size_t i = 0; i < size(); ++i )
-                *dst++ = *src++;
+        [[nodiscard]] constexpr size_t find( const basic_string_view<T>& what,
+                                             size_t                      from = 0 ) const
+        {
+            return basic_string_view<T>( *this ).find( what, from );
+        }
 
-            src = rhs.data();
+        [[nodiscard]] constexpr size_t find( value_type ch, size_t from = 0 ) const
+        {
+            return basic_string_view<T>( *this ).find( ch, from );
+        }
 
-            for ( size_t i = 0; i < rhs.size(); ++i )
-                *dst++ = *src++;
+        [[nodiscard]] constexpr size_t rfind( const basic_string_view<T>& what,
+                                              size_t                      from = npos ) const
+        {
+            return basic_string_view<T>( *this ).rfind( what, from );
+        }
 
-            *dst = 0;
+        [[nodiscard]] constexpr size_t rfind( value_type ch, size_t from = npos ) const
+        {
+            return basic_string_view<T>( *this ).rfind( ch, from );
+        }
 
-            return result;
+        [[nodiscard]] constexpr size_t find_first_of( const basic_string_view<T>& chars,
+                                                      size_t                      from = 0 ) const
+        {
+            return basic_string_view<T>( *this ).find_first_of( chars, from );
         }
 
-        [[nodiscard]] constexpr bool operator==( const basic_string_view<T>& rhs ) const
+        [[nodiscard]] constexpr basic_string substr( size_t from, size_t to = npos ) const
         {
-            // TODO: use Strsafe.h routines?
-            if ( size() != rhs.size() )
-                return false;
+            if ( from == npos )
+                return basic_string( get_allocator() );
 
-            const value_type* l = data();
-            const value_type* r = rhs.data();
+            return basic_string( basic_string_view<T>( data() + from, rtl::min( m_size, to ) - from ),
+                                 get_allocator() );
+        }
 
-            for ( size_t i = 0; i < size(); ++i )
-                if ( *l++ != *r++ )
-                    return false;
+        [[nodiscard]] constexpr basic_string operator+( basic_string_view<T> rhs ) const
+        {
+            basic_string result( get_allocator() );
 
-            return true;
+            result.reserve( size() + rhs.size() );
+            result.append( *this );
+            result.append( rhs );
+
+            return result;
+        }
+
+        [[nodiscard]] constexpr bool operator==( const basic_string_view<T>& rhs ) const
+        {
+            return basic_string_view<T>( data(), size() ) == rhs;
         }
 
         [[nodiscard]] constexpr bool operator!=( const basic_string_view<T>& rhs ) const
@@ -279,48 +450,37 @@ namespace rtl
         }
 
         constexpr basic_string( basic_string&& other )
-            : basic_string()
+            : basic_string( other.get_allocator() )
         {
-            *this = rtl::move( other );
+            steal( other );
         }
 
         constexpr basic_string& operator=( basic_string&& other )
         {
             if ( this != &other )
             {
-                m_data.reset( other.m_data.release() );
-                m_size = other.m_size;
-                other.m_size = 0;
+                deallocate();
+
+                this->replace_allocator( other );
+
+                m_data = local_data();
+
+                steal( other );
             }
 
             return *this;
         }
 
         constexpr basic_string( const basic_string& other )
-            : m_data( new value_type[other.m_size + 1] )
-            , m_size( other.m_size )
+            : basic_string( basic_string_view<T>( other ), other.get_allocator() )
         {
-            const value_type* src = other.data();
-            value_type*       dst = m_data.get();
-
-            for ( size_t i = 0; i < size(); ++i )
-                *dst++ = *src++;
         }
 
         // cppcheck-suppress operatorEq
         constexpr basic_string& operator=( const basic_string& other )
         {
             if ( this != &other )
-            {
-                m_data.reset( new value_type[other.m_size + 1] );
-                m_size = other.m_size;
-
-                const value_type* src = other.data();
-                value_type*       dst = m_data.get();
-
-                for ( size_t i = 0; i < size(); ++i )
-                    *dst++ = *src++;
-            }
+                assign( other );
 
             return *this;
         }
@@ -329,14 +489,121 @@ namespace rtl
 
         constexpr basic_string& operator=( const basic_string_view<T>& view )
         {
-            *this = basic_string( view );
+            assign( view );
             return *this;
         }
 
     private:
-        // TODO: use vector or buffer with size overprovision using capacity?
-        rtl::unique_ptr<value_type[]> m_data;
-        size_t                        m_size;
+#if RTL_ENABLE_STRING_SSO
+        // NOTE: Fits the characters and the terminating zero into 16 bytes
+        static constexpr size_t local_capacity = 16 / sizeof( T ) - 1;
+#else
+        static constexpr size_t local_capacity = 0;
+#endif
+
+        [[nodiscard]] constexpr value_type* local_data()
+        {
+            return m_local;
+        }
+
+        [[nodiscard]] constexpr bool is_local() const
+        {
+            return m_data == m_local;
+        }
+
+        // NOTE: Allocates a buffer for \capacity characters and the terminating zero
+        [[nodiscard]] constexpr value_type* allocate( size_t capacity ) const
+        {
+            return this->allocator_ref().allocate( capacity + 1 );
+        }
+
+        constexpr void deallocate()
+        {
+            if ( !is_local() )
+                this->allocator_ref().deallocate( m_data, m_capacity + 1 );
+        }
+
+        [[nodiscard]] constexpr size_t grown_capacity( size_t required ) const
+        {
+            const size_t current = capacity();
+
+            if ( current > ( npos - 1 ) / 2 )
+                return required;
+
+            return rtl::max( required, current * 2 );
+        }
+
+        constexpr void replace_buffer( value_type* data, size_t capacity )
+        {
+            deallocate();
+
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        constexpr void reallocate( size_t capacity )
+        {
+            value_type* data = allocate( capacity );
+            rtl::copy_n( m_data, m_size + 1, data );
+
+            replace_buffer( data, capacity );
+        }
+
+        constexpr void set_size( size_t size )
+        {
+            m_size = size;
+            m_data[size] = 0;
+        }
+
+        constexpr void assign( const basic_string_view<T>& view )
+        {
+            if ( view.size() > capacity() )
+            {
+                // NOTE: Exact size, as assigned strings rarely grow afterwards
+                value_type* data = allocate( view.size() );
+                rtl::copy_n( view.data(), view.size(), data );
+
+                replace_buffer( data, view.size() );
+            }
+            else
+            {
+                rtl::copy_n( view.data(), view.size(), m_data );
+            }
+
+            set_size( view.size() );
+        }
+
+        // NOTE: Expects this string to be empty and local. Heap buffer is taken over as is,
+        // local characters are copied.
+        constexpr void steal( basic_string& other )
+        {
+            if ( other.is_local() )
+            {
+                rtl::copy_n( other.m_data, other.m_size + 1, m_data );
+            }
+            else
+            {
+                m_data = other.m_data;
+                m_capacity = other.m_capacity;
+
+                other.m_data = other.local_data();
+            }
+
+            m_size = other.m_size;
+            other.set_size( 0 );
+        }
+
+        value_type* m_data;
+        size_t      m_size;
+
+        // NOTE: The capacity of the heap buffer, or the characters while \m_data points here.
+        // Without SSO the local buffer holds just the terminator of the empty string. Every
+        // string has its own one, so the strings of different threads share nothing.
+        union
+        {
+            size_t     m_capacity;
+            value_type m_local[local_capacity + 1];
+        };
     };
 
     using string = basic_string<char>;
@@ -345,7 +612,24 @@ namespace rtl
     using wstring = basic_string<wchar_t>;
     using wstring_view = basic_string_view<wchar_t>;
 
+#if RTL_ENABLE_STRING_SSO
+    static_assert( sizeof( string ) == 2 * sizeof( size_t ) + 16 );
+    static_assert( sizeof( wstring ) == 2 * sizeof( size_t ) + 16 );
+#else
+    static_assert( sizeof( string ) == 3 * sizeof( size_t ) );
+    static_assert( sizeof( wstring ) == 3 * sizeof( size_t ) );
+#endif
+
     wstring to_wstring( int value );
     wstring to_wstring( unsigned value );
+
+    // NOTE: Unlike std::to_wstring, writes the shortest representation that round-trips (as
+    // rtl::to_chars does) instead of the "%f" format.
+    wstring to_wstring( double value );
+
+    // NOTE: \string is in the ANSI code page, use \from_utf8 for UTF-8
     wstring to_wstring( const rtl::string& string );
+
+    // NOTE: Returns an empty string if \string is not valid UTF-8
+    wstring from_utf8( string_view string );
 } // namespace rtl
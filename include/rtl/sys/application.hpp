@@ -10,8 +10,11 @@
  */
 #pragma once
 
+#include <rtl/allocator.hpp>
 #include <rtl/int.hpp>
+#include <rtl/sys/heap.hpp>
 #include <rtl/sys/keyboard.hpp>
+#include <rtl/wav.hpp>
 
 #if RTL_ENABLE_APP
 
@@ -81,6 +84,41 @@ namespace rtl
                 size_t samples_per_second;
                 /// The maximum latency of the input and output buffers.
                 size_t max_latency_samples;
+                /// @brief Underruns per minute the output may have, 0 to keep the latency fixed.
+                /// The output queue starts at 2 device buffers, grows when the underruns come
+                /// more often and shrinks after a quiet period, so the output holds the rate at
+                /// the lowest latency. It never exceeds \p max_latency_samples.
+                size_t target_underruns_per_minute;
+
+                /// @brief Audio output sink.
+                /// The app fills the frames the same way for all of them.
+                struct Sink
+                {
+                    /// Sink type.
+                    enum class Type
+                    {
+                        /// Sound device, the frames are played in real time.
+                        wave_out,
+                        /// @brief WAV data, the frames are rendered as fast as possible.
+                        /// Action::wait doesn't wait for the device then.
+                        wav
+                    };
+
+                    /// Sink type.
+                    Type type;
+
+                    /// Sample format of the WAV data.
+                    wav::format format;
+
+                    /// The WAV file name, or nullptr to keep the data in memory.
+                    const wchar_t* path;
+
+                    /// @brief Number of frames to render, 0 for no limit.
+                    /// The app is closed after the last one.
+                    size_t frames;
+                }
+                /// Audio sink.
+                sink;
             }
             /// Audio parameters.
             audio;
@@ -146,8 +184,53 @@ namespace rtl
                 /// For one channel.
                 size_t samples_per_frame;
 
-                /// Pointer to the audio output buffer.
+                /// @brief Pointer to the audio output buffer.
+                /// Aligned to 64 bytes.
                 int16_t* output_frame_pointer;
+
+                /// Output statistics, updated every frame.
+                struct Stats
+                {
+                    /// Committed frames not yet taken by the device.
+                    size_t queued_frames;
+
+                    /// Device buffers queued for playing.
+                    size_t queued_buffers;
+
+                    /// @brief The number of device buffers queued for playing at most.
+                    /// The rest of the buffers are parked, the app is asked to keep one more frame
+                    /// committed.
+                    size_t queue_limit;
+
+                    /// @brief Device buffers padded with silence.
+                    /// Counted since the first committed frame.
+                    uint32_t underruns;
+
+                    /// @brief Frames dropped because the queue was full.
+                    /// The app runs ahead of the device.
+                    uint32_t overruns;
+
+                    /// Time the app waited for the device on the last Action::wait.
+                    uint32_t wait_microseconds;
+
+                    /// @brief Samples committed but not yet played, for one channel.
+                    /// Includes the frames queued in the device buffers.
+                    size_t latency_samples;
+
+                    /// @brief Duration of the committed frames divided by the time it took.
+                    /// About 1 for the sound device, how much faster than real time the WAV
+                    /// data is rendered.
+                    float realtime_factor;
+                }
+                /// Output statistics.
+                stats;
+
+                /// @brief WAV data rendered in memory.
+                /// A complete file, valid until the next frame.
+                const uint8_t* wav_data;
+
+                /// Size of the WAV data, in bytes.
+                size_t wav_size;
             }
             /// Audio data.
             audio;
@@ -163,7 +246,8 @@ namespace rtl
                 int height;
 
     #if RTL_ENABLE_APP_SCREEN_BUFFER
-                /// Pointer to the pixels buffer of the main window.
+                /// @brief Pointer to the pixels buffer of the main window.
+                /// Aligned to the page boundary.
                 uint8_t* pixels_buffer_pointer;
                 /// Size of the pixel line in bytes.
                 size_t pixels_buffer_pitch;
@@ -172,6 +256,29 @@ namespace rtl
             /// Screen data.
             screen;
 
+    #if RTL_ENABLE_HEAP_STATS
+            /// Heap statistics.
+            struct Heap
+            {
+                /// @brief Counters of the previous frame.
+                /// \p live_bytes is the value at the end of the frame, \p peak_bytes is the
+                /// maximum during the frame.
+                heap_statistics frame;
+
+                /// Counters since the start of the application.
+                heap_statistics total;
+            }
+            /// Heap statistics.
+            heap;
+    #endif
+
+    #if RTL_ENABLE_APP_FRAME_ARENA
+            /// @brief Scratch memory of the current frame.
+            /// Everything allocated from the arena is released after the update callback returns.
+            /// Use rtl::allocators::monotonic to place containers into it.
+            allocators::monotonic_buffer* frame_arena;
+    #endif
+
             /// Opaque handle of the main window.
             void* window_handle; // CAUTION: it is better NOT to touch the V̪̪̟O͇̘̞I̝̞D͇͚͜!!!
         };
@@ -228,7 +335,8 @@ namespace rtl
         {
             /// Do nothing.
             none,
-            /// Wait for next input event.
+            /// @brief Wait for next input event.
+            /// Or until the audio output needs the next frame.
             wait,
             /// Close application.
             close,
@@ -295,6 +403,9 @@ namespace rtl
         ////////////////////////////////////////////////////////////////////////////////////////////
         /// @brief Update callback.
         /// Called at the start of every frame or after an input event.
+        /// @note With RTL_ENABLE_APP_RENDER_THREAD it is called on a separate render thread, as
+        /// well as the init callback after the window is resized. The input is a snapshot taken
+        /// at the start of the frame.
         /// @param input Input context.
         /// @param output Output context.
         /// @return The action that the application should take.
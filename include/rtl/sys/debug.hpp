@@ -17,7 +17,11 @@
 #endif
 
 #if RTL_ENABLE_LOG
-    #define RTL_LOG( msg, ... ) rtl::impl::log( __FUNCTION__, msg, __VA_ARGS__ )
+    #include <rtl/format.hpp>
+
+    // NOTE: \msg is an rtl::format_to format string literal
+    #define RTL_LOG( msg, ... ) \
+        rtl::impl::log( __FUNCTION__, RTL_FMT_STRING( msg ), __VA_ARGS__ )
 #else
     #define RTL_LOG( msg, ... )
 #endif
@@ -27,6 +31,29 @@ namespace rtl
     namespace impl
     {
         void assert( bool condition, int code, const char* message, const char* file, int line );
-        void log( const char* function, const char* message... );
+
+#if RTL_ENABLE_LOG
+        void log( const char* message );
+
+        template<typename Format, typename... Args>
+        void log( const char* function, Format format, const Args&... args )
+        {
+            constexpr size_t length = 2048;
+            char             message[length];
+
+            // NOTE: Longer messages are truncated, the line end is always kept
+            format::writer<char> writer( message, message + length - 2 );
+            writer.put( '[' );
+            writer.write( function );
+            writer.put( "]: ", 3 );
+            writer.format( format, args... );
+
+            char* end = writer.out();
+            *end++ = '\n';
+            *end = 0;
+
+            log( message );
+        }
+#endif
     } // namespace impl
 } // namespace rtl
@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/int.hpp>
+
+#if RTL_ENABLE_HEAP_STATS
+
+namespace rtl
+{
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    /// Heap usage counters.
+    ////////////////////////////////////////////////////////////////////////////////////////////////
+    struct heap_statistics
+    {
+        /// Number of buckets in the size histogram.
+        static constexpr size_t histogram_size = 12;
+
+        /// Number of allocations.
+        size_t allocations;
+
+        /// Number of deallocations.
+        size_t frees;
+
+        /// @brief Total size of the allocated blocks in bytes.
+        /// Blocks are accounted with their actual size, which can be larger than requested.
+        uint64_t allocated_bytes;
+
+        /// Size of the blocks that are not freed yet in bytes.
+        uint64_t live_bytes;
+
+        /// Maximum of \p live_bytes.
+        uint64_t peak_bytes;
+
+        /// @brief Histogram of the requested sizes.
+        /// Bucket i counts sizes from 2^(i+3)+1 to 2^(i+4) bytes, the first bucket also counts the
+        /// smaller sizes and the last one counts the larger sizes.
+        size_t histogram[histogram_size];
+    };
+
+    /// @brief Heap counters since the start of the program.
+    /// @return Snapshot of the counters.
+    heap_statistics get_heap_statistics();
+} // namespace rtl
+
+#endif
@@ -16,16 +16,19 @@
 #include "impl/chrono.hpp"
 #include "impl/debug.hpp"
 #include "impl/filesystem.hpp"
+#include "impl/hash.hpp"
+#include "impl/jobs.hpp"
 #include "impl/memory.hpp"
-#include "impl/printf.hpp"
 #include "impl/startup.hpp"
 #include "impl/string.hpp"
 
 #include "impl/app/audio.hpp"
 #include "impl/app/environment.hpp"
+#include "impl/app/heap.hpp"
 #include "impl/app/opengl.hpp"
 #include "impl/app/osd.hpp"
 #include "impl/app/proc.hpp"
+#include "impl/app/render_thread.hpp"
 #include "impl/app/resize.hpp"
 #include "impl/app/resources.hpp"
 #include "impl/app/screen_buffer.hpp"
@@ -14,6 +14,12 @@
     #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
 #endif
 
+#include <rtl/algorithm.hpp>
+#include <rtl/atomic.hpp>
+#include <rtl/span.hpp>
+#include <rtl/wav.hpp>
+
+#include <rtl/sys/filesystem.hpp>
 #include <rtl/sys/impl/application.hpp>
 #include <rtl/sys/impl/win.hpp>
 
@@ -42,12 +48,26 @@ namespace rtl
 
                 if ( m_input.audio.samples_per_second > 0 )
                 {
-                    const size_t buffers_count
-                        = m_params.audio.max_latency_samples / m_input.audio.samples_per_frame;
+                    const auto& sink = m_params.audio.sink;
+
+                    if ( sink.type == Application::Params::Audio::Sink::Type::wav )
+                    {
+                        m_audio = new wav_audio( m_input.audio.samples_per_second,
+                                                 m_input.audio.samples_per_frame,
+                                                 sink.format,
+                                                 sink.path,
+                                                 sink.frames );
+                    }
+                    else
+                    {
+                        const size_t buffers_count
+                            = m_params.audio.max_latency_samples / m_input.audio.samples_per_frame;
 
-                    m_audio = new audio( m_input.audio.samples_per_second,
-                                         m_input.audio.samples_per_frame,
-                                         buffers_count > 1 ? buffers_count : 2 );
+                        m_audio = new wave_out_audio( m_input.audio.samples_per_second,
+                                                      m_input.audio.samples_per_frame,
+                                                      buffers_count > 1 ? buffers_count : 2,
+                                                      m_params.audio.target_underruns_per_minute );
+                    }
                 }
 
                 restart_audio();
@@ -58,12 +78,22 @@ namespace rtl
                 delete m_audio;
                 m_audio = nullptr;
                 m_input.audio.output_frame_pointer = nullptr;
+                m_input.audio.stats = {};
+                m_input.audio.wav_data = nullptr;
+                m_input.audio.wav_size = 0;
             }
 
             void window::commit_audio()
             {
                 if ( m_audio )
+                {
                     m_input.audio.output_frame_pointer = m_audio->commit();
+                    m_audio->get_stats( m_input.audio.stats );
+
+                    const span<const uint8_t> data = m_audio->wav_data();
+                    m_input.audio.wav_data = data.data();
+                    m_input.audio.wav_size = data.size();
+                }
             }
 
             void window::restart_audio()
@@ -88,12 +118,95 @@ namespace rtl
             }
         #endif
 
-            audio::audio( unsigned samples_per_second,
-                          unsigned samples_per_frame,
-                          unsigned frames_per_buffer )
+            audio::audio( unsigned samples_per_second, unsigned samples_per_frame )
+                : m_samples_per_second( samples_per_second )
+                , m_samples_per_frame( samples_per_frame )
             {
                 RTL_ASSERT( samples_per_second > 0 );
                 RTL_ASSERT( samples_per_frame > 0 );
+
+                m_frame.resize( Application::Input::Audio::channel_count * samples_per_frame );
+
+                [[maybe_unused]] BOOL result = ::QueryPerformanceFrequency( &m_counter_frequency );
+                RTL_WINAPI_CHECK( result );
+            }
+
+            [[nodiscard]] int16_t* audio::start()
+            {
+                return m_frame.data();
+            }
+
+            int16_t* audio::commit()
+            {
+                if ( m_committed_frames++ == 0 )
+                {
+                    [[maybe_unused]] BOOL result = ::QueryPerformanceCounter( &m_commit_start );
+                    RTL_WINAPI_CHECK( result );
+                }
+
+                write( m_frame.data(), m_frame.size() );
+                return m_frame.data();
+            }
+
+            bool audio::finished() const
+            {
+                return false;
+            }
+
+            span<const uint8_t> audio::wav_data() const
+            {
+                return {};
+            }
+
+            void audio::begin_wait()
+            {
+                [[maybe_unused]] BOOL result = ::QueryPerformanceCounter( &m_wait_start );
+                RTL_WINAPI_CHECK( result );
+            }
+
+            void audio::end_wait()
+            {
+                LARGE_INTEGER now;
+
+                [[maybe_unused]] BOOL result = ::QueryPerformanceCounter( &now );
+                RTL_WINAPI_CHECK( result );
+
+                m_wait_microseconds = static_cast<uint32_t>(
+                    ( now.QuadPart - m_wait_start.QuadPart ) * 1000000ll
+                    / m_counter_frequency.QuadPart );
+            }
+
+            void audio::get_stats( Application::Input::Audio::Stats& stats ) const
+            {
+                stats.wait_microseconds = m_wait_microseconds;
+                stats.realtime_factor = 0.f;
+
+                if ( m_committed_frames < 2 )
+                    return;
+
+                LARGE_INTEGER now;
+
+                [[maybe_unused]] BOOL result = ::QueryPerformanceCounter( &now );
+                RTL_WINAPI_CHECK( result );
+
+                // NOTE: The time is counted from the first commit, so the first frame is not
+                // counted either
+                const double samples
+                    = static_cast<double>( m_committed_frames - 1 ) * m_samples_per_frame;
+                const double seconds = static_cast<double>( now.QuadPart - m_commit_start.QuadPart )
+                                       / static_cast<double>( m_counter_frequency.QuadPart );
+
+                if ( seconds > 0 )
+                    stats.realtime_factor
+                        = static_cast<float>( samples / m_samples_per_second / seconds );
+            }
+
+            wave_out_audio::wave_out_audio( unsigned samples_per_second,
+                                            unsigned samples_per_frame,
+                                            unsigned frames_per_buffer,
+                                            unsigned target_underruns_per_minute )
+                : audio( samples_per_second, samples_per_frame )
+            {
                 RTL_ASSERT( frames_per_buffer > 1 );
 
                 constexpr size_t channels_count = Application::Input::Audio::channel_count;
@@ -108,24 +221,48 @@ namespace rtl
                 m_wave_format.nAvgBytesPerSec
                     = m_wave_format.nSamplesPerSec * m_wave_format.nBlockAlign;
 
+                // NOTE: The device signals the event when a buffer is done, so no work is done
+                // in the driver callback, where most of the waveOut functions can't be called
+                m_device_event = ::CreateEventW( nullptr, FALSE, FALSE, nullptr );
+                RTL_WINAPI_CHECK( m_device_event != nullptr );
+
+                m_demand_event = ::CreateEventW( nullptr, FALSE, FALSE, nullptr );
+                RTL_WINAPI_CHECK( m_demand_event != nullptr );
+
                 MMRESULT result = ::waveOutOpen( &m_wave_out,
                                                  WAVE_MAPPER,
                                                  &m_wave_format,
-                                                 reinterpret_cast<DWORD_PTR>( wave_out_proc ),
-                                                 reinterpret_cast<DWORD_PTR>( this ),
-                                                 CALLBACK_FUNCTION );
+                                                 reinterpret_cast<DWORD_PTR>( m_device_event ),
+                                                 0,
+                                                 CALLBACK_EVENT );
                 RTL_MM_WAVEOUT_CHECK( result );
 
                 m_wave_headers.resize( frames_per_buffer );
                 const unsigned block_size = m_wave_format.nChannels * samples_per_frame;
-                m_buffer.resize( block_size * frames_per_buffer );
+
+                RTL_ASSERT( block_size * ( audio_queue::min_frames + 1 ) <= ring_capacity );
+
+                constexpr unsigned block_alignment = frame_alignment / sizeof( int16_t );
+                const unsigned     block_stride
+                    = ( block_size + block_alignment - 1 ) / block_alignment * block_alignment;
+
+                m_buffer.resize( block_stride * frames_per_buffer );
+
+                // NOTE: The frames of the queue and the spare one may all wait in the ring, when
+                // the app fills it up at once. The underrun rate is checked once a second.
+                const unsigned ring_frames = static_cast<unsigned>( ring_capacity / block_size );
+                const unsigned max_frames = rtl::min( frames_per_buffer, ring_frames - 1 );
+
+                m_queue.init( max_frames,
+                              ( samples_per_second + samples_per_frame - 1 ) / samples_per_frame,
+                              target_underruns_per_minute );
 
                 for ( size_t i = 0; i < m_wave_headers.size(); ++i )
                 {
                     WAVEHDR& header = m_wave_headers[i];
                     memset( &header, 0, sizeof( header ) );
 
-                    header.lpData = reinterpret_cast<LPSTR>( m_buffer.data() + block_size * i );
+                    header.lpData = reinterpret_cast<LPSTR>( m_buffer.data() + block_stride * i );
                     header.dwBufferLength = block_size * sizeof( int16_t );
                     header.dwUser = i;
 
@@ -133,12 +270,31 @@ namespace rtl
                     RTL_MM_WAVEOUT_CHECK( result );
                 }
 
-                result = ::waveOutReset( m_wave_out );
-                RTL_MM_WAVEOUT_CHECK( result );
+                m_thread = ::CreateThread( nullptr, 0, thread_proc, this, 0, nullptr );
+                RTL_WINAPI_CHECK( m_thread != nullptr );
+
+                // NOTE: The device plays the silence until the app fills the queue, but it
+                // doesn't wait for the first frame
+                [[maybe_unused]] BOOL set = ::SetEvent( m_device_event );
+                RTL_WINAPI_CHECK( set );
             }
 
-            audio::~audio()
+            wave_out_audio::~wave_out_audio()
             {
+                if ( m_thread )
+                {
+                    m_stop.store( 1, memory_order_release );
+
+                    [[maybe_unused]] BOOL set = ::SetEvent( m_device_event );
+                    RTL_WINAPI_CHECK( set );
+
+                    [[maybe_unused]] DWORD code = ::WaitForSingleObject( m_thread, INFINITE );
+                    RTL_WINAPI_CHECK( code == WAIT_OBJECT_0 );
+
+                    [[maybe_unused]] BOOL result = ::CloseHandle( m_thread );
+                    RTL_WINAPI_CHECK( result );
+                }
+
                 if ( m_wave_out )
                 {
                     MMRESULT result = ::waveOutReset( m_wave_out );
@@ -153,94 +309,271 @@ namespace rtl
                     result = ::waveOutClose( m_wave_out );
                     RTL_MM_WAVEOUT_CHECK( result );
                 }
+
+                if ( m_device_event )
+                {
+                    [[maybe_unused]] BOOL result = ::CloseHandle( m_device_event );
+                    RTL_WINAPI_CHECK( result );
+                }
+
+                if ( m_demand_event )
+                {
+                    [[maybe_unused]] BOOL result = ::CloseHandle( m_demand_event );
+                    RTL_WINAPI_CHECK( result );
+                }
             }
 
-            void audio::wave_out_proc( HWAVEOUT /* hwo */,
-                                       UINT      msg,
-                                       DWORD_PTR instance,
-                                       DWORD_PTR param1,
-                                       DWORD_PTR /* param2 */ )
+            DWORD WINAPI wave_out_audio::thread_proc( LPVOID parameter )
             {
-                [[maybe_unused]] window* const that = reinterpret_cast<window*>( instance );
+                static_cast<wave_out_audio*>( parameter )->run();
+                return 0;
+            }
 
-                switch ( msg )
-                {
-                case WOM_DONE:
+            void wave_out_audio::run()
+            {
+                for ( ;; )
                 {
-                    // XXX: also whern reset
+                    [[maybe_unused]] DWORD code = ::WaitForSingleObject( m_device_event, INFINITE );
+                    RTL_WINAPI_CHECK( code == WAIT_OBJECT_0 );
 
-                    // RTL_APP_AUDIO_STATS
-                    // XXX: sample buffers counts
-                    // XXX: detect if no buffers left == underrun
+                    if ( m_stop.load( memory_order_acquire ) )
+                        break;
 
-                    // XXX: perform device restart
-                    [[maybe_unused]] WAVEHDR* header = reinterpret_cast<WAVEHDR*>( param1 );
-                    RTL_ASSERT( header->dwFlags & WHDR_DONE );
-                    break;
-                }
+                    const size_t count = m_wave_headers.size();
+
+                    // NOTE: The device returns the buffers in the order they were queued. The
+                    // event is signaled once for several buffers if the thread is late.
+                    while ( m_queue.in_flight() > 0 )
+                    {
+                        const size_t oldest
+                            = ( m_submit_index + count - m_queue.in_flight() ) % count;
+
+                        if ( m_wave_headers[oldest].dwFlags & WHDR_INQUEUE )
+                            break;
+
+                        m_queue.returned();
+                    }
+
+                    // NOTE: The buffers beyond the queue limit stay parked
+                    for ( ;; )
+                    {
+                        const audio_queue::action action
+                            = m_queue.next( m_ring.size() / m_frame.size() );
+
+                        if ( action == audio_queue::action::wait )
+                            break;
+
+                        submit( m_wave_headers[m_submit_index],
+                                action == audio_queue::action::submit_silence );
+                        m_submit_index = ( m_submit_index + 1 ) % count;
+                    }
+
+                    update_latency();
+
+                    if ( m_queue.wants_frame( m_ring.size() / m_frame.size() ) )
+                    {
+                        [[maybe_unused]] BOOL set = ::SetEvent( m_demand_event );
+                        RTL_WINAPI_CHECK( set );
+                    }
                 }
             }
 
-            [[nodiscard]] int16_t* audio::start()
+            void wave_out_audio::submit( WAVEHDR& header, bool silence )
             {
-                [[maybe_unused]] MMRESULT result = ::waveOutReset( m_wave_out );
+                int16_t* const samples = reinterpret_cast<int16_t*>( header.lpData );
+                const size_t   count = header.dwBufferLength / sizeof( int16_t );
+
+                // NOTE: The ring holds whole frames only
+                const size_t popped = silence ? 0 : m_ring.pop_n( samples, count );
+
+                if ( popped < count )
+                    rtl::fill_n( samples + popped, count - popped, int16_t( 0 ) );
+
+                m_written_samples += static_cast<uint32_t>( count / m_wave_format.nChannels );
+
+                [[maybe_unused]] MMRESULT result
+                    = ::waveOutWrite( m_wave_out, &header, sizeof( WAVEHDR ) );
                 RTL_MM_WAVEOUT_CHECK( result );
+            }
 
-                m_write_index = 0;
-                m_started = false;
+            void wave_out_audio::update_latency()
+            {
+                MMTIME time;
+                time.wType = TIME_SAMPLES;
 
-                return reinterpret_cast<int16_t*>( m_wave_headers.front().lpData );
+                // NOTE: Some drivers can't report the position in samples, then the latency is
+                // left as is
+                if ( ::waveOutGetPosition( m_wave_out, &time, sizeof( MMTIME ) ) != MMSYSERR_NOERROR
+                     || time.wType != TIME_SAMPLES )
+                    return;
+
+                // NOTE: The position is a 32-bit counter, the difference survives its wrap around
+                const uint32_t queued
+                    = static_cast<uint32_t>( m_ring.size() / m_wave_format.nChannels );
+                m_latency_samples.store( m_written_samples - time.u.sample + queued,
+                                         memory_order_relaxed );
             }
 
-            void audio::stop()
+            void wave_out_audio::write( const int16_t* samples, size_t count )
             {
-                [[maybe_unused]] MMRESULT result = ::waveOutReset( m_wave_out );
-                RTL_MM_WAVEOUT_CHECK( result );
+                const size_t frames = m_ring.size() / count;
+
+                // NOTE: The app runs ahead of the device if it renders frames on input events as
+                // well, then the frame is dropped to keep the latency bounded
+                if ( !m_queue.wants_frame( frames ) )
+                {
+                    ++m_overruns;
+                    return;
+                }
+
+                m_ring.push_n( samples, count );
 
-                m_write_index = 0;
-                m_started = false;
+                // NOTE: The device asks for a frame per returned buffer, so the queue is filled
+                // up to the limit by the app at once, at the start or when the limit grows
+                if ( m_queue.wants_frame( frames + 1 ) )
+                {
+                    [[maybe_unused]] BOOL set = ::SetEvent( m_demand_event );
+                    RTL_WINAPI_CHECK( set );
+                }
             }
 
-            int16_t* audio::commit()
+            HANDLE wave_out_audio::demand_event() const
             {
-                MMRESULT result = ::waveOutWrite(
-                    m_wave_out, &m_wave_headers[m_write_index], sizeof( WAVEHDR ) );
-                RTL_MM_WAVEOUT_CHECK( result );
+                return m_demand_event;
+            }
 
-                m_write_index = ( m_write_index + 1 ) % m_wave_headers.size();
+            void wave_out_audio::get_stats( Application::Input::Audio::Stats& stats ) const
+            {
+                audio::get_stats( stats );
+
+                stats.queued_frames = m_ring.size() / m_frame.size();
+                stats.queued_buffers = m_queue.in_flight();
+                stats.queue_limit = m_queue.limit();
+                stats.underruns = m_queue.underruns();
+                stats.overruns = m_overruns;
+                stats.latency_samples = m_latency_samples.load( memory_order_relaxed );
+            }
 
-                WAVEHDR* header = &m_wave_headers[m_write_index];
+            wav_audio::wav_audio( unsigned       samples_per_second,
+                                  unsigned       samples_per_frame,
+                                  wav::format    format,
+                                  const wchar_t* path,
+                                  size_t         frames )
+                : audio( samples_per_second, samples_per_frame )
+                , m_format( format )
+                , m_frames( frames )
+            {
+                // NOTE: The event is never reset, so Action::wait doesn't wait for the sink
+                m_demand_event = ::CreateEventW( nullptr, TRUE, TRUE, nullptr );
+                RTL_WINAPI_CHECK( m_demand_event != nullptr );
 
-                if ( !m_started )
+                if ( path )
                 {
-                    if ( m_write_index == m_wave_headers.size() - 1 )
-                    {
-                        result = ::waveOutRestart( m_wave_out );
-                        RTL_MM_WAVEOUT_CHECK( result );
+                    m_file = filesystem::file::open( path,
+                                                     filesystem::file::access::write_only,
+                                                     filesystem::file::mode::create_always );
+                    RTL_ASSERT( m_file );
 
-                        m_started = true;
-                    }
+                    m_data.reserve( flush_size + m_frame.size() * wav::sample_size( format ) );
                 }
-                else
+
+                // NOTE: The file gets the sizes and the frame count on close, the data in memory
+                // after every frame
+                m_data.resize( wav::header_size( m_format ), default_init );
+                wav::write_header( m_data.data(),
+                                   m_format,
+                                   Application::Input::Audio::channel_count,
+                                   m_samples_per_second,
+                                   m_data_size );
+            }
+
+            wav_audio::~wav_audio()
+            {
+                if ( m_file )
                 {
-                    // XXX: log wait time (SUMM, N)
+                    flush();
 
-                    // XXX: timeout with frame duration and detect buffer overrun after that?
-                    for ( ;; )
-                    {
-                        // XXX: really need this?
-                        // 20-90 CPU cycles
-                        ::MemoryBarrier();
+                    uint8_t header[wav::max_header_size];
+                    wav::write_header( header,
+                                       m_format,
+                                       Application::Input::Audio::channel_count,
+                                       m_samples_per_second,
+                                       m_data_size );
 
-                        if ( header->dwFlags & WHDR_DONE )
-                            break;
+                    m_file.seek( 0, filesystem::file::position::begin );
 
-                        // XXX: ????
-                        ::_mm_pause();
-                    }
+                    const size_t size = wav::header_size( m_format );
+
+                    [[maybe_unused]] const unsigned written
+                        = m_file.write( header, static_cast<unsigned>( size ) );
+                    RTL_ASSERT( written == size );
                 }
 
-                return reinterpret_cast<int16_t*>( header->lpData );
+                [[maybe_unused]] BOOL result = ::CloseHandle( m_demand_event );
+                RTL_WINAPI_CHECK( result );
+            }
+
+            HANDLE wav_audio::demand_event() const
+            {
+                return m_demand_event;
+            }
+
+            bool wav_audio::finished() const
+            {
+                return m_frames > 0 && m_committed_frames >= m_frames;
+            }
+
+            span<const uint8_t> wav_audio::wav_data() const
+            {
+                if ( m_file )
+                    return {};
+
+                return span<const uint8_t>( m_data.data(), m_data.size() );
+            }
+
+            void wav_audio::write( const int16_t* samples, size_t count )
+            {
+                if ( m_frames > 0 && m_committed_frames > m_frames )
+                    return;
+
+                const size_t offset = m_data.size();
+                const size_t size = count * wav::sample_size( m_format );
+
+                // NOTE: The vector grows to the exact size, so the data in memory would be
+                // copied on every frame
+                if ( offset + size > m_data.capacity() )
+                    m_data.reserve( rtl::max( offset + size, m_data.capacity() * 2 ) );
+
+                m_data.resize( offset + size, default_init );
+                wav::encode( samples, count, m_format, m_data.data() + offset );
+
+                m_data_size += static_cast<uint32_t>( size );
+
+                if ( m_file )
+                {
+                    if ( m_data.size() >= flush_size )
+                        flush();
+                }
+                else
+                {
+                    wav::write_header( m_data.data(),
+                                       m_format,
+                                       Application::Input::Audio::channel_count,
+                                       m_samples_per_second,
+                                       m_data_size );
+                }
+            }
+
+            void wav_audio::flush()
+            {
+                if ( m_data.empty() )
+                    return;
+
+                [[maybe_unused]] const unsigned written
+                    = m_file.write( m_data.data(), static_cast<unsigned>( m_data.size() ) );
+                RTL_ASSERT( written == m_data.size() );
+
+                m_data.clear();
             }
 
         } // namespace win
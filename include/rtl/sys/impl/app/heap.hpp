@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#include <rtl/sys/impl/application.hpp>
+#include <rtl/sys/impl/memory.hpp>
+
+#if RTL_ENABLE_APP
+    #if RTL_ENABLE_HEAP_STATS
+
+namespace rtl
+{
+    namespace impl
+    {
+        namespace win
+        {
+            void window::update_heap_statistics()
+            {
+                const heap_statistics  total = g_heap.counters().snapshot();
+                const heap_statistics& previous = m_input.heap.total;
+                heap_statistics&       frame = m_input.heap.frame;
+
+                frame.allocations = total.allocations - previous.allocations;
+                frame.frees = total.frees - previous.frees;
+                frame.allocated_bytes = total.allocated_bytes - previous.allocated_bytes;
+                frame.live_bytes = total.live_bytes;
+                frame.peak_bytes = g_heap.counters().exchange_frame_peak();
+
+                for ( size_t i = 0; i < heap_statistics::histogram_size; ++i )
+                    frame.histogram[i] = total.histogram[i] - previous.histogram[i];
+
+                m_input.heap.total = total;
+            }
+        } // namespace win
+    }     // namespace impl
+} // namespace rtl
+
+    #endif
+#endif
@@ -90,6 +90,19 @@ namespace rtl
                 ::SwapBuffers( m_opengl_window_dc );
             }
 
+        #if RTL_ENABLE_APP_RENDER_THREAD
+            void window::make_opengl_current( bool current )
+            {
+                if ( !m_opengl_rc_handle )
+                    return;
+
+                [[maybe_unused]] BOOL result
+                    = current ? ::wglMakeCurrent( m_opengl_window_dc, m_opengl_rc_handle )
+                              : ::wglMakeCurrent( nullptr, nullptr );
+                RTL_WINAPI_CHECK( result );
+            }
+        #endif
+
             void window::enable_opengl_vsync()
             {
                 typedef BOOL( APIENTRY * PFNWGLSWAPINTERVALPROC )( int );
@@ -61,7 +61,9 @@ namespace rtl
 
     #if RTL_ENABLE_APP_KEYS
                 case WM_ACTIVATE:
-                    rtl::fill_n( that->m_input.keys.state, (size_t)keyboard::Keys::count, false );
+                    rtl::fill_n(
+                        that->m_input_events.state, (size_t)keyboard::Keys::count, false );
+                    that->publish_input();
                     return 0;
 
                 case WM_SYSKEYDOWN:
@@ -69,10 +71,11 @@ namespace rtl
                 {
                     const unsigned key = static_cast<unsigned>( wParam );
 
-                    if ( !that->m_input.keys.state[key] )
-                        that->m_input.keys.pressed[key] = true;
+                    if ( !that->m_input_events.state[key] )
+                        ++that->m_input_events.presses[key];
 
-                    that->m_input.keys.state[key] = true;
+                    that->m_input_events.state[key] = true;
+                    that->publish_input();
                     return 0;
                 }
 
@@ -80,7 +83,8 @@ namespace rtl
                 case WM_KEYUP:
                 {
                     const unsigned key = static_cast<unsigned>( wParam );
-                    that->m_input.keys.state[key] = false;
+                    that->m_input_events.state[key] = false;
+                    that->publish_input();
                     return 0;
                 }
     #endif
@@ -92,15 +96,6 @@ namespace rtl
                     return 0;
                 }
 
-        #if RTL_ENABLE_APP_AUDIO_OUTPUT
-
-                case WM_ENTERSIZEMOVE:
-                {
-                    that->m_audio->stop();
-                    return 0;
-                }
-        #endif
-
                 case WM_EXITSIZEMOVE:
                 {
                     that->m_resize_sizing = false;
@@ -111,8 +106,12 @@ namespace rtl
                 {
                     if ( wParam != SIZE_MINIMIZED )
                     {
-                        that->m_resize_sized = that->m_window_inited;
-                        that->m_window_inited = true;
+                        if ( that->m_window_inited )
+                            ++that->m_input_events.resizes;
+                        else
+                            that->m_window_inited = true;
+
+                        that->publish_input();
                     }
 
                     return 0;
@@ -131,6 +130,10 @@ namespace rtl
     #if RTL_ENABLE_APP_SCREEN_BUFFER
                 case WM_PAINT:
                 {
+        #if RTL_ENABLE_APP_RENDER_THREAD
+                    if ( that->defer_paint() )
+                        return 0;
+        #endif
         #if RTL_ENABLE_APP_RESIZE
                     if ( that->m_resize_sizing )
                         break;
@@ -152,6 +155,10 @@ namespace rtl
     #else
                 case WM_PAINT:
                 {
+        #if RTL_ENABLE_APP_RENDER_THREAD
+                    if ( that->defer_paint() )
+                        return 0;
+        #endif
         #if RTL_ENABLE_APP_RESIZE
                     if ( that->m_resize_sizing )
                         break;
@@ -171,6 +178,29 @@ namespace rtl
                 }
     #endif
 
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                case render_action_message:
+                {
+        #if RTL_ENABLE_APP_OPENGL
+                    that->make_opengl_current( true );
+        #endif
+                    that->take_action( static_cast<Application::Action>( wParam ),
+                                       that->m_on_setup,
+                                       that->m_on_init );
+        #if RTL_ENABLE_APP_OPENGL
+                    that->make_opengl_current( false );
+        #endif
+                    // NOTE: Closing the window has stopped the thread already
+                    if ( that->m_render_resume_event )
+                    {
+                        [[maybe_unused]] BOOL result = ::SetEvent( that->m_render_resume_event );
+                        RTL_WINAPI_CHECK( result );
+                    }
+
+                    return 0;
+                }
+    #endif
+
                 case WM_SETCURSOR:
                     if constexpr ( !has_cursor || is_resizable )
                     {
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#include <rtl/sys/impl/application.hpp>
+
+#if RTL_ENABLE_APP
+    #if RTL_ENABLE_APP_RENDER_THREAD
+
+namespace rtl
+{
+    namespace impl
+    {
+        namespace win
+        {
+            // NOTE: The render thread owns the frame: \m_input, \m_output, the screen buffer or
+            // the OpenGL context, the audio device and the frame arena. The message thread owns
+            // the window and \m_input_events. Actions that change the window are taken by the
+            // message thread, while the render thread waits for them.
+
+            void window::start_render_thread( Application::setup_function*  on_setup,
+                                              Application::init_function*   on_init,
+                                              Application::update_function* on_update )
+            {
+                RTL_ASSERT( m_render_thread == nullptr );
+
+                m_on_setup = on_setup;
+                m_on_init = on_init;
+                m_on_update = on_update;
+
+                m_render_stop.store( 0, memory_order_relaxed );
+
+                m_render_wake_event = ::CreateEventW( nullptr, FALSE, FALSE, nullptr );
+                RTL_WINAPI_CHECK( m_render_wake_event != nullptr );
+
+                m_render_resume_event = ::CreateEventW( nullptr, FALSE, FALSE, nullptr );
+                RTL_WINAPI_CHECK( m_render_resume_event != nullptr );
+
+        #if RTL_ENABLE_APP_OPENGL
+                make_opengl_current( false );
+        #endif
+
+                m_render_thread
+                    = ::CreateThread( nullptr, 0, render_thread_proc, this, 0, nullptr );
+                RTL_WINAPI_CHECK( m_render_thread != nullptr );
+            }
+
+            void window::stop_render_thread()
+            {
+                if ( !m_render_thread )
+                    return;
+
+                m_render_stop.store( 1, memory_order_release );
+
+                [[maybe_unused]] BOOL result = ::SetEvent( m_render_wake_event );
+                RTL_WINAPI_CHECK( result );
+
+                result = ::SetEvent( m_render_resume_event );
+                RTL_WINAPI_CHECK( result );
+
+                [[maybe_unused]] DWORD code = ::WaitForSingleObject( m_render_thread, INFINITE );
+                RTL_WINAPI_CHECK( code == WAIT_OBJECT_0 );
+
+                result = ::CloseHandle( m_render_thread );
+                RTL_WINAPI_CHECK( result );
+
+                result = ::CloseHandle( m_render_wake_event );
+                RTL_WINAPI_CHECK( result );
+
+                result = ::CloseHandle( m_render_resume_event );
+                RTL_WINAPI_CHECK( result );
+
+                m_render_thread = nullptr;
+                m_render_wake_event = nullptr;
+                m_render_resume_event = nullptr;
+
+        #if RTL_ENABLE_APP_OPENGL
+                make_opengl_current( true );
+        #endif
+            }
+
+            void window::request_action( Application::Action action )
+            {
+        #if RTL_ENABLE_APP_OPENGL
+                make_opengl_current( false );
+        #endif
+
+                [[maybe_unused]] BOOL result = ::PostMessageW(
+                    m_window_handle, render_action_message, static_cast<WPARAM>( action ), 0 );
+                RTL_WINAPI_CHECK( result );
+
+                [[maybe_unused]] DWORD code
+                    = ::WaitForSingleObject( m_render_resume_event, INFINITE );
+                RTL_WINAPI_CHECK( code == WAIT_OBJECT_0 );
+
+                // NOTE: The window may be closed meanwhile, then the context is gone
+                if ( m_render_stop.load( memory_order_acquire ) )
+                    return;
+
+        #if RTL_ENABLE_APP_OPENGL
+                make_opengl_current( true );
+        #endif
+            }
+
+            bool window::defer_paint()
+            {
+                if ( !m_render_thread )
+                    return false;
+
+                // NOTE: The render thread presents every frame itself, so just validate the
+                // window and wake the thread up in case it waits for input
+                PAINTSTRUCT ps;
+
+                [[maybe_unused]] HDC hdc = ::BeginPaint( m_window_handle, &ps );
+                RTL_WINAPI_CHECK( hdc != nullptr );
+
+                [[maybe_unused]] BOOL result = ::EndPaint( m_window_handle, &ps );
+                RTL_WINAPI_CHECK( result );
+
+                publish_input();
+                return true;
+            }
+
+            DWORD WINAPI window::render_thread_proc( LPVOID parameter )
+            {
+                window* const that = static_cast<window*>( parameter );
+
+        #if RTL_ENABLE_APP_OPENGL
+                that->make_opengl_current( true );
+        #endif
+
+                while ( !that->m_render_stop.load( memory_order_acquire ) )
+                    that->update( that->m_on_setup, that->m_on_init, that->m_on_update );
+
+        #if RTL_ENABLE_APP_OPENGL
+                that->make_opengl_current( false );
+        #endif
+                return 0;
+            }
+
+        } // namespace win
+
+    } // namespace impl
+} // namespace rtl
+
+    #endif
+#endif
@@ -117,8 +117,18 @@ namespace rtl
 
             void window::commit_screen_buffer()
             {
-                [[maybe_unused]] BOOL result = ::InvalidateRect( m_window_handle, nullptr, FALSE );
-                RTL_WINAPI_CHECK( result );
+                // NOTE: Draws right away instead of invalidating the window. WM_PAINT is late or
+                // never comes while the message thread is busy, and it would wake up the wait for
+                // the next input event at once.
+                HDC hdc = ::GetDC( m_window_handle );
+                RTL_WINAPI_CHECK( hdc != nullptr );
+
+        #if RTL_ENABLE_APP_OSD
+                draw_osd_text( hdc );
+        #endif
+                draw_screen_buffer( hdc );
+
+                ::ReleaseDC( m_window_handle, hdc );
             }
         } // namespace win
 
@@ -20,11 +20,13 @@
     #endif
 
     #include <rtl/algorithm.hpp>
+    #include <rtl/atomic.hpp>
     #include <rtl/chrono.hpp>
     #include <rtl/limits.hpp>
     #include <rtl/memory.hpp>
     #include <rtl/sys/application.hpp>
     #include <rtl/sys/debug.hpp>
+    #include <rtl/triple_buffer.hpp>
     #include <rtl/vector.hpp>
 
     #include "audio.hpp"
@@ -52,9 +54,41 @@ namespace rtl
                 [[nodiscard]] int  height() const;
                 [[nodiscard]] bool fullscreen() const;
 
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                void start_render_thread( Application::setup_function*  on_setup,
+                                          Application::init_function*   on_init,
+                                          Application::update_function* on_update );
+                void stop_render_thread();
+    #endif
+
             private:
+                // Input state collected by the window procedure
+                struct input_events
+                {
+    #if RTL_ENABLE_APP_KEYS
+                    bool state[keyboard::Keys::count];
+
+                    // NOTE: Counters instead of flags, so the press is not lost if a frame skips
+                    // the snapshot with it
+                    uint8_t presses[keyboard::Keys::count];
+    #endif
+    #if RTL_ENABLE_APP_RESIZE
+                    uint32_t resizes;
+    #endif
+                    // Placeholder to avoid voidness of the structure.
+                    void* placeholder;
+                };
+
                 void init_environment();
 
+                void publish_input();
+                void receive_input( const input_events& events );
+                void wait_input();
+
+                void take_action( Application::Action          action,
+                                  Application::setup_function* on_setup,
+                                  Application::init_function*  on_init );
+
                 SIZE initial_size() const;
 
                 void destroy();
@@ -66,6 +100,10 @@ namespace rtl
                 void set_fullscreen_mode( bool fullscreen );
     #endif
 
+    #if RTL_ENABLE_HEAP_STATS
+                void update_heap_statistics();
+    #endif
+
     #if RTL_ENABLE_APP_AUDIO_OUTPUT
                 void create_audio();
                 void commit_audio();
@@ -73,6 +111,15 @@ namespace rtl
                 void destroy_audio();
     #endif
 
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                void request_action( Application::Action action );
+                bool defer_paint();
+
+                static DWORD WINAPI render_thread_proc( LPVOID parameter );
+
+                static constexpr UINT render_action_message = WM_APP;
+    #endif
+
     #if RTL_ENABLE_APP_SCREEN_BUFFER
                 void init_screen_buffer( int width, int height );
                 void draw_screen_buffer( HDC hdc );
@@ -89,6 +136,9 @@ namespace rtl
                 void  free_opengl();
                 void  commit_opengl();
                 void  enable_opengl_vsync();
+        #if RTL_ENABLE_APP_RENDER_THREAD
+                void make_opengl_current( bool current );
+        #endif
     #endif
                 static constexpr int  minimal_width = 600;
                 static constexpr int  minimal_height = 400;
@@ -119,11 +169,33 @@ namespace rtl
                 Application::Params      m_params{ 0 };
                 Application::Environment m_environment{ 0 };
 
+                input_events m_input_events{ 0 };
+
+    #if RTL_ENABLE_APP_KEYS
+                uint8_t m_key_presses[keyboard::Keys::count]{ 0 };
+    #endif
+
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                // NOTE: The message thread writes \m_input_events and publishes a copy of it,
+                // the render thread takes the latest one at the start of the frame
+                triple_buffer<input_events> m_input_buffer;
+
+                HANDLE           m_render_thread{ nullptr };
+                HANDLE           m_render_wake_event{ nullptr };
+                HANDLE           m_render_resume_event{ nullptr };
+                atomic<uint32_t> m_render_stop;
+
+                Application::setup_function*  m_on_setup{ nullptr };
+                Application::init_function*   m_on_init{ nullptr };
+                Application::update_function* m_on_update{ nullptr };
+    #endif
+
     #if RTL_ENABLE_APP_RESIZE
                 bool            m_resize_sizing{ false };
                 bool            m_resize_sized{ false };
                 bool            m_resize_fullscreen{ false };
                 bool            m_resize_pad{ false };
+                uint32_t        m_resizes{ 0 };
                 WINDOWPLACEMENT m_resize_placement{ 0 };
     #endif
 
@@ -133,6 +205,11 @@ namespace rtl
                 audio* m_audio{ nullptr };
     #endif
 
+    #if RTL_ENABLE_APP_FRAME_ARENA
+                // NOTE: same as \m_audio, the arena has a non-trivial destructor
+                allocators::monotonic_buffer* m_frame_arena{ nullptr };
+    #endif
+
     #if RTL_ENABLE_APP_SCREEN_BUFFER
                 HDC        m_screen_buffer_dc{ nullptr };
                 BITMAPINFO m_screen_buffer_bitmap_info{ 0 };
@@ -275,6 +352,10 @@ namespace rtl
 
     #if RTL_ENABLE_APP_AUDIO_OUTPUT
                 create_audio();
+    #endif
+    #if RTL_ENABLE_APP_FRAME_ARENA
+                m_frame_arena = new allocators::monotonic_buffer;
+                m_input.frame_arena = m_frame_arena;
     #endif
                 ::ShowWindow( m_window_handle, SW_SHOW );
 
@@ -324,6 +405,9 @@ namespace rtl
 
             void window::destroy()
             {
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                stop_render_thread();
+    #endif
                 m_window_inited = false;
 
                 destroy_resizable_components( false );
@@ -332,6 +416,12 @@ namespace rtl
                 destroy_audio();
     #endif
 
+    #if RTL_ENABLE_APP_FRAME_ARENA
+                m_input.frame_arena = nullptr;
+                delete m_frame_arena;
+                m_frame_arena = nullptr;
+    #endif
+
                 // NOTE: Non-critical for the application beying terminated
                 // ::UnregisterClassW( m_window_class.lpszClassName, m_window_class.hInstance );
             }
@@ -346,6 +436,13 @@ namespace rtl
                 [[maybe_unused]] BOOL result = ::GdiFlush();
                 RTL_WINAPI_CHECK( result );
 
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                m_input_buffer.update();
+                receive_input( m_input_buffer.read_buffer() );
+    #else
+                receive_input( m_input_events );
+    #endif
+
     #if RTL_ENABLE_APP_CLOCK
                 m_input.clock.third_ticks
                     = static_cast<signed>( ::GetTickCount() )
@@ -368,13 +465,98 @@ namespace rtl
                 }
     #endif
 
-                const auto action
+    #if RTL_ENABLE_HEAP_STATS
+                update_heap_statistics();
+    #endif
+
+                auto action
                     = on_update ? on_update( m_input, m_output ) : Application::Action::wait;
 
-    #if RTL_ENABLE_APP_KEYS
-                rtl::fill_n( m_input.keys.pressed, (size_t)keyboard::Keys::count, false );
+    #if RTL_ENABLE_APP_AUDIO_OUTPUT
+                // NOTE: The offline sink has rendered all of the requested frames
+                if ( m_audio && m_audio->finished() )
+                    action = Application::Action::close;
+    #endif
+
+    #if RTL_ENABLE_APP_FRAME_ARENA
+                m_frame_arena->reset();
     #endif
 
+                switch ( action )
+                {
+                case Application::Action::close:
+    #if RTL_ENABLE_APP_RESIZE
+                case Application::Action::toggle_fullscreen:
+    #endif
+    #if RTL_ENABLE_APP_RESET
+                case Application::Action::reset:
+    #endif
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                    request_action( action );
+    #else
+                    take_action( action, on_setup, on_init );
+    #endif
+                    break;
+
+                case Application::Action::none:
+                case Application::Action::wait:
+                default:
+    #if RTL_ENABLE_APP_SCREEN_BUFFER
+                    commit_screen_buffer();
+    #elif RTL_ENABLE_APP_OPENGL
+                    commit_opengl();
+    #endif
+    #if RTL_ENABLE_APP_AUDIO_OUTPUT
+                    commit_audio();
+    #endif
+                    if ( action == Application::Action::wait )
+                        wait_input();
+
+                    break;
+                }
+            }
+
+            void window::wait_input()
+            {
+                HANDLE handles[2]{ nullptr };
+                DWORD  count = 0;
+
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                handles[count++] = m_render_wake_event;
+    #endif
+    #if RTL_ENABLE_APP_AUDIO_OUTPUT
+                // NOTE: The audio thread asks for the next frame, so the app renders at the pace
+                // of the device without ever blocking in \commit_audio
+                if ( m_audio )
+                    handles[count++] = m_audio->demand_event();
+    #endif
+
+    #if RTL_ENABLE_APP_AUDIO_OUTPUT
+                if ( m_audio )
+                    m_audio->begin_wait();
+    #endif
+
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                [[maybe_unused]] DWORD code
+                    = ::WaitForMultipleObjects( count, handles, FALSE, INFINITE );
+    #else
+                [[maybe_unused]] DWORD code
+                    = ::MsgWaitForMultipleObjects( count, handles, FALSE, INFINITE, QS_ALLINPUT );
+    #endif
+                RTL_WINAPI_CHECK( code != WAIT_FAILED );
+
+    #if RTL_ENABLE_APP_AUDIO_OUTPUT
+                if ( m_audio )
+                    m_audio->end_wait();
+    #endif
+            }
+
+            void window::take_action( Application::Action                           action,
+                                      [[maybe_unused]] Application::setup_function* on_setup,
+                                      [[maybe_unused]] Application::init_function*  on_init )
+            {
+                [[maybe_unused]] BOOL result;
+
                 switch ( action )
                 {
                 case Application::Action::close:
@@ -426,19 +608,43 @@ namespace rtl
                 case Application::Action::none:
                 case Application::Action::wait:
                 default:
-    #if RTL_ENABLE_APP_SCREEN_BUFFER
-                    commit_screen_buffer();
-    #elif RTL_ENABLE_APP_OPENGL
-                    commit_opengl();
+                    break;
+                }
+            }
+
+            void window::publish_input()
+            {
+    #if RTL_ENABLE_APP_RENDER_THREAD
+                m_input_buffer.write_buffer() = m_input_events;
+                m_input_buffer.publish();
+
+                if ( m_render_wake_event )
+                {
+                    [[maybe_unused]] BOOL result = ::SetEvent( m_render_wake_event );
+                    RTL_WINAPI_CHECK( result );
+                }
     #endif
-    #if RTL_ENABLE_APP_AUDIO_OUTPUT
-                    commit_audio();
+            }
+
+            void window::receive_input( [[maybe_unused]] const input_events& events )
+            {
+    #if RTL_ENABLE_APP_KEYS
+                rtl::copy_n( events.state, (size_t)keyboard::Keys::count, m_input.keys.state );
+
+                for ( size_t key = 0; key < (size_t)keyboard::Keys::count; ++key )
+                {
+                    m_input.keys.pressed[key] = events.presses[key] != m_key_presses[key];
+                    m_key_presses[key] = events.presses[key];
+                }
     #endif
-                    if ( action == Application::Action::wait )
-                        ::WaitMessage();
 
-                    break;
+    #if RTL_ENABLE_APP_RESIZE
+                if ( events.resizes != m_resizes )
+                {
+                    m_resizes = events.resizes;
+                    m_resize_sized = true;
                 }
+    #endif
             }
 
             window g_window;
@@ -495,6 +701,17 @@ namespace rtl
 
         MSG msg{ 0 };
 
+    #if RTL_ENABLE_APP_RENDER_THREAD
+        impl::win::g_window.start_render_thread( on_setup, on_init, on_update );
+
+        // NOTE: The frames go on in the render thread while this one is stuck in the modal loops
+        // of moving and sizing the window or showing the window menu
+        while ( ::GetMessageW( &msg, nullptr, 0, 0 ) > 0 )
+        {
+            ::TranslateMessage( &msg );
+            ::DispatchMessageW( &msg );
+        }
+    #else
         for ( ; msg.message != WM_QUIT; )
         {
             while ( ::PeekMessageW( &msg, nullptr, 0, 0, PM_REMOVE ) )
@@ -506,9 +723,9 @@ namespace rtl
                 ::DispatchMessageW( &msg );
             }
 
-            // TODO: run processing in separate thread
             impl::win::g_window.update( on_setup, on_init, on_update );
         }
+    #endif
 
         if ( on_terminate )
             on_terminate();
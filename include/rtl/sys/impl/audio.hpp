@@ -17,9 +17,17 @@
 #if RTL_ENABLE_APP
     #if RTL_ENABLE_APP_AUDIO_OUTPUT
 
+        #include <rtl/allocator.hpp>
+        #include <rtl/atomic.hpp>
         #include <rtl/int.hpp>
+        #include <rtl/span.hpp>
+        #include <rtl/spsc_ring.hpp>
+        #include <rtl/sys/application.hpp>
+        #include <rtl/sys/filesystem.hpp>
+        #include <rtl/sys/impl/audio_queue.hpp>
         #include <rtl/sys/impl/win.hpp>
         #include <rtl/vector.hpp>
+        #include <rtl/wav.hpp>
 
 namespace rtl
 {
@@ -27,30 +35,152 @@ namespace rtl
     {
         namespace win
         {
-            class audio final
+            // Audio sink. The app fills the frame returned by \start or \commit, the sink takes
+            // the committed ones.
+            class audio
             {
             public:
-                audio( unsigned samples_per_second,
-                       unsigned samples_per_frame,
-                       unsigned frames_per_buffer );
-                ~audio();
+                audio( unsigned samples_per_second, unsigned samples_per_frame );
+                virtual ~audio() = default;
 
+                audio( const audio& ) = delete;
+                audio& operator=( const audio& ) = delete;
+
+                // Returns the frame to be filled by the app
                 [[nodiscard]] int16_t* start();
+
+                // Passes the frame to the sink and returns the next one
                 [[nodiscard]] int16_t* commit();
 
-                void stop();
+                // Signaled when the sink needs the next frame
+                [[nodiscard]] virtual HANDLE demand_event() const = 0;
+
+                // True if the sink takes no more frames
+                [[nodiscard]] virtual bool finished() const;
+
+                // The WAV data rendered in memory, if any
+                [[nodiscard]] virtual span<const uint8_t> wav_data() const;
+
+                // Measure the time the app waits for \demand_event
+                void begin_wait();
+                void end_wait();
+
+                virtual void get_stats( Application::Input::Audio::Stats& stats ) const;
+
+            protected:
+                // NOTE: Every frame starts at the cache line boundary, so it can be filled with
+                // the aligned SIMD stores
+                static constexpr size_t frame_alignment = 64;
+
+                using frame_allocator = allocators::aligned<int16_t, frame_alignment>;
+
+                virtual void write( const int16_t* samples, size_t count ) = 0;
+
+                unsigned m_samples_per_second{ 0 };
+                unsigned m_samples_per_frame{ 0 };
+
+                rtl::vector<int16_t, frame_allocator> m_frame;
+
+                uint32_t m_committed_frames{ 0 };
+
+            private:
+                uint32_t      m_wait_microseconds{ 0 };
+                LARGE_INTEGER m_wait_start{ 0 };
+                LARGE_INTEGER m_commit_start{ 0 };
+                LARGE_INTEGER m_counter_frequency{ 0 };
+            };
+
+            // Pull model of the audio output. The app commits frames to the ring, the audio
+            // thread takes the samples from the ring whenever the device returns a buffer. If the
+            // ring runs dry, the buffer is padded with silence.
+            class wave_out_audio final : public audio
+            {
+            public:
+                wave_out_audio( unsigned samples_per_second,
+                                unsigned samples_per_frame,
+                                unsigned frames_per_buffer,
+                                unsigned target_underruns_per_minute );
+                ~wave_out_audio() override;
+
+                wave_out_audio( const wave_out_audio& ) = delete;
+                wave_out_audio& operator=( const wave_out_audio& ) = delete;
+
+                [[nodiscard]] HANDLE demand_event() const override;
+
+                void get_stats( Application::Input::Audio::Stats& stats ) const override;
 
             private:
-                static void CALLBACK
-                    wave_out_proc( HWAVEOUT, UINT, DWORD_PTR, DWORD_PTR, DWORD_PTR );
+                static constexpr size_t ring_capacity = 32768;
+
+                static DWORD WINAPI thread_proc( LPVOID parameter );
+
+                // Queues the frame, never waits for the device. The frame is dropped if the
+                // queue is full.
+                void write( const int16_t* samples, size_t count ) override;
+
+                void run();
+                void submit( WAVEHDR& header, bool silence );
+                void update_latency();
 
                 WAVEFORMATEX         m_wave_format{ 0 };
-                bool                 m_started{ false };
-                bool                 m_pad{ false };
                 HWAVEOUT             m_wave_out{ nullptr };
                 rtl::vector<WAVEHDR> m_wave_headers;
-                rtl::vector<int16_t> m_buffer;
-                size_t               m_write_index{ 0 };
+                size_t               m_submit_index{ 0 };
+
+                rtl::vector<int16_t, frame_allocator> m_buffer;
+
+                HANDLE           m_thread{ nullptr };
+                HANDLE           m_device_event{ nullptr };
+                HANDLE           m_demand_event{ nullptr };
+                atomic<uint32_t> m_stop;
+
+                audio_queue m_queue;
+
+                // NOTE: Written by the audio thread, read by the app
+                atomic<uint32_t> m_latency_samples;
+                uint32_t         m_written_samples{ 0 };
+
+                // NOTE: The app state
+                uint32_t m_overruns{ 0 };
+
+                spsc_ring<int16_t, ring_capacity> m_ring;
+            };
+
+            // Offline audio output. The frames are encoded to a WAV file or to memory as soon as
+            // they are committed, so the app runs as fast as it can render them.
+            class wav_audio final : public audio
+            {
+            public:
+                wav_audio( unsigned       samples_per_second,
+                           unsigned       samples_per_frame,
+                           wav::format    format,
+                           const wchar_t* path,
+                           size_t         frames );
+                ~wav_audio() override;
+
+                wav_audio( const wav_audio& ) = delete;
+                wav_audio& operator=( const wav_audio& ) = delete;
+
+                [[nodiscard]] HANDLE demand_event() const override;
+                [[nodiscard]] bool   finished() const override;
+
+                [[nodiscard]] span<const uint8_t> wav_data() const override;
+
+            private:
+                // NOTE: The file is written in large blocks, so the system calls don't slow the
+                // rendering down
+                static constexpr size_t flush_size = 256 * 1024;
+
+                void write( const int16_t* samples, size_t count ) override;
+                void flush();
+
+                wav::format m_format;
+                size_t      m_frames;
+                uint32_t    m_data_size{ 0 };
+                HANDLE      m_demand_event{ nullptr };
+
+                filesystem::file     m_file;
+                rtl::vector<uint8_t> m_data;
             };
         } // namespace win
 
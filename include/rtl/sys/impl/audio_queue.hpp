@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#include <rtl/atomic.hpp>
+#include <rtl/int.hpp>
+
+namespace rtl
+{
+    namespace impl
+    {
+        // Length of the audio output queue. The frames committed by the app wait in the ring,
+        // then go to the device buffers. At most \limit buffers are given to the device, the rest
+        // of them is parked, and the app keeps one more frame ready in the ring for the buffer
+        // returned next, so the output latency is \limit + 1 frames. If the ring runs dry, the
+        // device still gets \min_frames buffers padded with silence, which is an underrun.
+        //
+        // NOTE: In the adaptive mode the limit starts at \min_frames. A second with more
+        // underruns than the target allows grows it by a frame. It shrinks by a frame when there
+        // was no underrun for as long as the target allows one, so the latency goes down while
+        // the app keeps up.
+        class audio_queue final
+        {
+        public:
+            enum class action
+            {
+                wait,
+                submit_frame,
+                submit_silence
+            };
+
+            static constexpr uint32_t min_frames = 2;
+
+            // NOTE: The limit is fixed at \max_frames, if \target_underruns_per_minute is 0
+            void init( uint32_t max_frames,
+                       uint32_t frames_per_second,
+                       uint32_t target_underruns_per_minute )
+            {
+                m_max_limit = max_frames > min_frames ? max_frames : min_frames;
+                m_target_underruns = target_underruns_per_minute;
+                m_period = frames_per_second > 0 ? frames_per_second : 1;
+
+                m_limit.store( m_target_underruns > 0 ? min_frames : m_max_limit,
+                               memory_order_relaxed );
+            }
+
+            [[nodiscard]] uint32_t limit() const
+            {
+                return m_limit.load( memory_order_relaxed );
+            }
+
+            // The buffers given to the device and not yet returned
+            [[nodiscard]] uint32_t in_flight() const
+            {
+                return m_in_flight.load( memory_order_relaxed );
+            }
+
+            [[nodiscard]] uint32_t underruns() const
+            {
+                return m_underruns.load( memory_order_relaxed );
+            }
+
+            // The audio thread: the device has returned the oldest buffer
+            void returned()
+            {
+                m_in_flight.store( in_flight() - 1, memory_order_relaxed );
+            }
+
+            // The audio thread: what goes to the next free device buffer, if anything
+            [[nodiscard]] action next( size_t ring_frames )
+            {
+                const uint32_t count = in_flight();
+
+                if ( ring_frames > 0 && count < limit() )
+                {
+                    m_playing = true;
+                    submitted( false );
+                    return action::submit_frame;
+                }
+
+                // NOTE: The silence before the first frame is not an underrun
+                if ( count < min_frames )
+                {
+                    submitted( m_playing );
+                    return action::submit_silence;
+                }
+
+                return action::wait;
+            }
+
+            // The app should commit one more frame
+            [[nodiscard]] bool wants_frame( size_t ring_frames ) const
+            {
+                return in_flight() + ring_frames <= limit();
+            }
+
+        private:
+            void submitted( bool underrun )
+            {
+                m_in_flight.store( in_flight() + 1, memory_order_relaxed );
+
+                if ( underrun )
+                    m_underruns.fetch_add( 1, memory_order_relaxed );
+
+                if ( m_target_underruns > 0 )
+                    adapt( underrun );
+            }
+
+            void adapt( bool underrun )
+            {
+                m_period_underruns += underrun ? 1 : 0;
+
+                if ( ++m_period_buffers < m_period )
+                    return;
+
+                const uint32_t current = limit();
+
+                if ( m_period_underruns * 60 > m_target_underruns )
+                {
+                    if ( current < m_max_limit )
+                        m_limit.store( current + 1, memory_order_relaxed );
+
+                    m_quiet_periods = 0;
+                }
+                else if ( m_period_underruns > 0 )
+                {
+                    m_quiet_periods = 0;
+                }
+                else if ( ++m_quiet_periods * m_target_underruns >= 60 )
+                {
+                    if ( current > min_frames )
+                        m_limit.store( current - 1, memory_order_relaxed );
+
+                    m_quiet_periods = 0;
+                }
+
+                m_period_buffers = 0;
+                m_period_underruns = 0;
+            }
+
+            // NOTE: Written by the audio thread, read by the app
+            atomic<uint32_t> m_limit;
+            atomic<uint32_t> m_in_flight;
+            atomic<uint32_t> m_underruns;
+
+            bool     m_playing{ false };
+            uint32_t m_max_limit{ min_frames };
+            uint32_t m_target_underruns{ 0 };
+            uint32_t m_period{ 1 };
+            uint32_t m_period_buffers{ 0 };
+            uint32_t m_period_underruns{ 0 };
+            uint32_t m_quiet_periods{ 0 };
+        };
+    } // namespace impl
+} // namespace rtl
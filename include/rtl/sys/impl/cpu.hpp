@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#if defined( _MSC_VER )
+    #include <intrin.h>
+#else
+    #include <cpuid.h>
+#endif
+
+namespace rtl
+{
+    namespace impl
+    {
+        // CPU features that are not guaranteed by the baseline (SSE2) and are checked at runtime
+        class cpu_features final
+        {
+        public:
+            void init()
+            {
+                int info[4];
+
+                cpuid( info, 0 );
+                const int max_leaf = info[0];
+
+                if ( max_leaf >= 1 )
+                {
+                    cpuid( info, 1 );
+                    m_sse42 = ( info[2] & ( 1 << 20 ) ) != 0;
+                }
+
+                if ( max_leaf >= 7 )
+                {
+                    cpuid( info, 7 );
+                    m_erms = ( info[1] & ( 1 << 9 ) ) != 0;
+                }
+            }
+
+            // NOTE: Enhanced REP MOVSB/STOSB
+            [[nodiscard]] bool erms() const
+            {
+                return m_erms;
+            }
+
+            [[nodiscard]] bool sse42() const
+            {
+                return m_sse42;
+            }
+
+        private:
+            // NOTE: The subleaf is always 0
+            static void cpuid( int info[4], int leaf )
+            {
+#if defined( _MSC_VER )
+                __cpuidex( info, leaf, 0 );
+#else
+                unsigned int registers[4];
+                __cpuid_count( static_cast<unsigned int>( leaf ),
+                               0,
+                               registers[0],
+                               registers[1],
+                               registers[2],
+                               registers[3] );
+
+                for ( int i = 0; i < 4; ++i )
+                    info[i] = static_cast<int>( registers[i] );
+#endif
+            }
+
+            // NOTE: all variables must be initialized to zero
+            //
+            bool m_erms{ false };
+            bool m_sse42{ false };
+            bool m_pad[2]{ false };
+        };
+
+        cpu_features g_cpu;
+    } // namespace impl
+} // namespace rtl
@@ -48,25 +48,8 @@ namespace rtl
 #endif
 
 #if RTL_ENABLE_LOG
-        void log( const char* function, const char* fmt... )
+        void log( const char* message )
         {
-            va_list args;
-            va_start( args, fmt );
-
-            // NOTE: wsprintfA outputs no more than 1024 symbols per call
-            CHAR message[2048];
-
-            CHAR* str = message;
-
-            // TODO: Use safer realization of printf or proove safity (NOTE: StringCbVPrintfA is
-            // inapplicable)
-            // TODO: %f support
-            str += ::wsprintfA( str, "[%s]: ", function );
-            str += ::wvsprintfA( str, fmt, args );
-            str += ::wsprintfA( str, "\n" );
-
-            va_end( args );
-
             ::OutputDebugStringA( message );
         }
 #endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#include <nmmintrin.h>
+
+#include <rtl/hash.hpp>
+#include <rtl/int.hpp>
+
+#include "cpu.hpp"
+
+namespace rtl
+{
+    namespace impl
+    {
+        namespace crc
+        {
+            // NOTE: Reflected Castagnoli polynomial
+            constexpr uint32_t polynomial = 0x82f63b78u;
+
+            struct table
+            {
+                uint32_t values[256];
+            };
+
+            [[nodiscard]] constexpr table make_table()
+            {
+                table result = {};
+
+                for ( uint32_t i = 0; i < 256; ++i )
+                {
+                    uint32_t crc = i;
+                    for ( int bit = 0; bit < 8; ++bit )
+                        crc = ( crc >> 1 ) ^ ( ( crc & 1 ) ? polynomial : 0 );
+
+                    result.values[i] = crc;
+                }
+
+                return result;
+            }
+
+            constexpr table crc32c_table = make_table();
+
+            [[nodiscard]] inline uint32_t crc32c_software( uint32_t       crc,
+                                                           const uint8_t* p,
+                                                           size_t         size )
+            {
+                for ( size_t i = 0; i < size; ++i )
+                    crc = crc32c_table.values[( crc ^ p[i] ) & 0xff] ^ ( crc >> 8 );
+
+                return crc;
+            }
+
+            // NOTE: Multiplication of polynomials modulo the CRC polynomial in the reflected
+            // bit order, where the highest bit is x^0
+            [[nodiscard]] constexpr uint32_t multiply( uint32_t a, uint32_t b )
+            {
+                uint32_t result = 0;
+
+                for ( uint32_t m = 1u << 31; m != 0; m >>= 1 )
+                {
+                    if ( a & m )
+                    {
+                        result ^= b;
+                        if ( ( a & ( m - 1 ) ) == 0 )
+                            break;
+                    }
+
+                    b = ( b & 1 ) ? ( b >> 1 ) ^ polynomial : b >> 1;
+                }
+
+                return result;
+            }
+
+            // NOTE: x^(8 * size) modulo the polynomial: multiplying a CRC by it appends \size
+            // zero bytes to the data
+            [[nodiscard]] constexpr uint32_t zeros_operator( size_t size )
+            {
+                uint32_t result = 1u << 31;
+                uint32_t power = 1u << 23; // x^8
+
+                for ( ; size > 0; size >>= 1 )
+                {
+                    if ( size & 1 )
+                        result = multiply( power, result );
+
+                    power = multiply( power, power );
+                }
+
+                return result;
+            }
+
+            // NOTE: The CRC32 instruction has a latency of 3 cycles and a throughput of 1, so
+            // the long buffers are split into three interleaved streams. The CRC of the first
+            // stream is shifted over the next one and joined with it, as CRC is linear.
+            constexpr size_t stream_size = 2048;
+
+            constexpr uint32_t stream_shift = zeros_operator( stream_size );
+
+            [[nodiscard]] inline uint32_t load( const uint8_t* p )
+            {
+                return *reinterpret_cast<const uint32_t*>( p );
+            }
+
+            [[nodiscard]] inline uint32_t crc32c_sse42( uint32_t       crc,
+                                                        const uint8_t* p,
+                                                        size_t         size )
+            {
+                for ( ; size > 0 && ( reinterpret_cast<size_t>( p ) & 3 ) != 0; --size )
+                    crc = _mm_crc32_u8( crc, *p++ );
+
+                for ( ; size >= 3 * stream_size; size -= 3 * stream_size )
+                {
+                    uint32_t crc1 = 0;
+                    uint32_t crc2 = 0;
+
+                    for ( const uint8_t* end = p + stream_size; p != end; p += 4 )
+                    {
+                        crc = _mm_crc32_u32( crc, load( p ) );
+                        crc1 = _mm_crc32_u32( crc1, load( p + stream_size ) );
+                        crc2 = _mm_crc32_u32( crc2, load( p + 2 * stream_size ) );
+                    }
+
+                    crc = multiply( stream_shift, multiply( stream_shift, crc ) ^ crc1 ) ^ crc2;
+                    p += 2 * stream_size;
+                }
+
+                for ( ; size >= 4; size -= 4, p += 4 )
+                    crc = _mm_crc32_u32( crc, load( p ) );
+
+                for ( ; size > 0; --size )
+                    crc = _mm_crc32_u8( crc, *p++ );
+
+                return crc;
+            }
+        } // namespace crc
+    }     // namespace impl
+
+    uint32_t crc32c( const void* data, size_t size, uint32_t crc )
+    {
+        const uint8_t* p = static_cast<const uint8_t*>( data );
+
+        if ( impl::g_cpu.sse42() )
+            return ~impl::crc::crc32c_sse42( ~crc, p, size );
+
+        return ~impl::crc::crc32c_software( ~crc, p, size );
+    }
+} // namespace rtl
@@ -14,12 +14,102 @@
     #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
 #endif
 
+#include <rtl/atomic.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/sys/heap.hpp>
+
+#include "heap_pools.hpp"
 #include "win.hpp"
 
 namespace rtl
 {
     namespace impl
     {
+#if RTL_ENABLE_HEAP_STATS
+        // Heap counters, updated atomically as the heap can be used by several threads
+        //
+        // NOTE: The byte counters are 64-bit, so they don't wrap around after a few gigabytes of
+        // the total traffic
+        class heap_counters final
+        {
+        public:
+            void on_allocate( size_t requested_size, size_t block_size )
+            {
+                m_allocations.fetch_add( 1, memory_order_relaxed );
+                m_allocated_bytes.fetch_add( block_size, memory_order_relaxed );
+                m_histogram[histogram_index( requested_size )].fetch_add( 1, memory_order_relaxed );
+
+                const uint64_t live_bytes
+                    = m_live_bytes.fetch_add( block_size, memory_order_relaxed ) + block_size;
+
+                update_peak( m_peak_bytes, live_bytes );
+                update_peak( m_frame_peak_bytes, live_bytes );
+            }
+
+            void on_free( size_t block_size )
+            {
+                m_frees.fetch_add( 1, memory_order_relaxed );
+                m_live_bytes.fetch_sub( block_size, memory_order_relaxed );
+            }
+
+            [[nodiscard]] heap_statistics snapshot() const
+            {
+                heap_statistics result;
+
+                result.allocations = m_allocations.load( memory_order_relaxed );
+                result.frees = m_frees.load( memory_order_relaxed );
+                result.allocated_bytes = m_allocated_bytes.load( memory_order_relaxed );
+                result.live_bytes = m_live_bytes.load( memory_order_relaxed );
+                result.peak_bytes = m_peak_bytes.load( memory_order_relaxed );
+
+                for ( size_t i = 0; i < heap_statistics::histogram_size; ++i )
+                    result.histogram[i] = m_histogram[i].load( memory_order_relaxed );
+
+                return result;
+            }
+
+            // NOTE: Returns the maximum of live bytes since the previous call
+            [[nodiscard]] uint64_t exchange_frame_peak()
+            {
+                return m_frame_peak_bytes.exchange( m_live_bytes.load( memory_order_relaxed ),
+                                                    memory_order_relaxed );
+            }
+
+        private:
+            [[nodiscard]] static size_t histogram_index( size_t size )
+            {
+                size_t index = 0;
+
+                for ( size = size > 16 ? ( size - 1 ) >> 4 : 0;
+                      size && index < heap_statistics::histogram_size - 1;
+                      size >>= 1 )
+                    ++index;
+
+                return index;
+            }
+
+            static void update_peak( atomic<uint64_t>& peak, uint64_t value )
+            {
+                uint64_t current = peak.load( memory_order_relaxed );
+
+                while ( current < value
+                        && !peak.compare_exchange_weak( current, value, memory_order_relaxed ) )
+                {
+                }
+            }
+
+            // NOTE: all variables must be initialized to zero
+            //
+            atomic<size_t>   m_allocations;
+            atomic<size_t>   m_frees;
+            atomic<uint64_t> m_allocated_bytes;
+            atomic<uint64_t> m_live_bytes;
+            atomic<uint64_t> m_peak_bytes;
+            atomic<uint64_t> m_frame_peak_bytes;
+            atomic<size_t>   m_histogram[heap_statistics::histogram_size];
+        };
+#endif
+
         class heap final
         {
         public:
@@ -27,13 +117,49 @@ namespace rtl
             {
                 m_heap = ::GetProcessHeap();
                 RTL_WINAPI_CHECK( m_heap != nullptr );
+
+#if RTL_ENABLE_HEAP_POOLS
+                m_pools.init();
+#endif
             }
 
+            [[nodiscard]] void* malloc( size_t size )
+            {
+                return allocate( size, false );
+            }
+
+            // NOTE: Returns nullptr if \num * \size doesn't fit size_t
             [[nodiscard]] void* calloc( size_t num, size_t size )
             {
-                LPVOID result = ::HeapAlloc( m_heap, HEAP_ZERO_MEMORY, size * num );
-                RTL_WINAPI_CHECK( result != nullptr );
-                return result;
+                if ( num != 0 && size > max_size / num )
+                    return nullptr;
+
+                return allocate( size * num, true );
+            }
+
+            // NOTE: Pointer to the underlying block is stored right before the aligned one
+            [[nodiscard]] void* aligned_malloc( size_t size, size_t alignment )
+            {
+                const size_t overhead = alignment - 1 + sizeof( void* );
+                if ( size > max_size - overhead )
+                    return nullptr;
+
+                uint8_t* block = static_cast<uint8_t*>( malloc( size + overhead ) );
+                if ( !block )
+                    return nullptr;
+
+                const size_t aligned
+                    = ( reinterpret_cast<size_t>( block ) + sizeof( void* ) + alignment - 1 )
+                      & ~( alignment - 1 );
+
+                reinterpret_cast<void**>( aligned )[-1] = block;
+                return reinterpret_cast<void*>( aligned );
+            }
+
+            void aligned_free( void* ptr )
+            {
+                if ( ptr )
+                    free( static_cast<void**>( ptr )[-1] );
             }
 
             void free( void* ptr )
@@ -41,12 +167,75 @@ namespace rtl
                 if ( !ptr )
                     return;
 
+#if RTL_ENABLE_HEAP_STATS
+                m_counters.on_free( size_of( ptr ) );
+#endif
+
+#if RTL_ENABLE_HEAP_POOLS
+                if ( m_pools.free( ptr ) )
+                    return;
+#endif
+
                 [[maybe_unused]] const BOOL result = ::HeapFree( m_heap, 0, ptr );
                 RTL_WINAPI_CHECK( result );
             }
 
+#if RTL_ENABLE_HEAP_STATS
+            [[nodiscard]] heap_counters& counters()
+            {
+                return m_counters;
+            }
+#endif
+
         private:
+            static constexpr size_t max_size = ~size_t( 0 );
+
+            [[nodiscard]] void* allocate( size_t size, bool zero )
+            {
+                void* result = nullptr;
+
+#if RTL_ENABLE_HEAP_POOLS
+                result = m_pools.allocate( size );
+
+                // NOTE: Recycled blocks keep the previous content
+                if ( result && zero )
+                    ::memset( result, 0, size );
+#endif
+
+                if ( !result )
+                {
+                    result = ::HeapAlloc( m_heap, zero ? HEAP_ZERO_MEMORY : 0, size );
+                    RTL_WINAPI_CHECK( result != nullptr );
+                }
+
+#if RTL_ENABLE_HEAP_STATS
+                if ( result )
+                    m_counters.on_allocate( size, size_of( result ) );
+#endif
+
+                return result;
+            }
+
+#if RTL_ENABLE_HEAP_STATS
+            [[nodiscard]] size_t size_of( const void* ptr ) const
+            {
+    #if RTL_ENABLE_HEAP_POOLS
+                if ( const size_t size = m_pools.size_of( ptr ) )
+                    return size;
+    #endif
+                return ::HeapSize( m_heap, 0, ptr );
+            }
+#endif
+
             HANDLE m_heap;
+
+#if RTL_ENABLE_HEAP_POOLS
+            heap_pools m_pools;
+#endif
+
+#if RTL_ENABLE_HEAP_STATS
+            heap_counters m_counters;
+#endif
         };
     } // namespace impl
 
@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#if RTL_ENABLE_HEAP_POOLS
+
+    #include <rtl/int.hpp>
+
+    // NOTE: The library uses the Win32 backend, the POSIX one lets the benchmark compare the pools
+    // with the C library allocator on Linux
+    #if defined( _WIN32 )
+        #include "win.hpp"
+    #else
+        #include <pthread.h>
+        #include <sys/mman.h>
+    #endif
+
+namespace rtl
+{
+    namespace impl
+    {
+        // Small object allocator. Blocks of the same size class are carved from the spans of
+        // one big address space reservation and recycled through the segregated free lists.
+        // Blocks larger than \max_block_size are not handled, as well as any requests after the
+        // reservation is exhausted.
+        class heap_pools final
+        {
+        public:
+            static constexpr size_t max_block_size = 4096;
+            static constexpr size_t span_size = 64 * 1024;
+            static constexpr size_t reserved_size = 64 * 1024 * 1024;
+
+            void init()
+            {
+                m_base = reserve( reserved_size );
+            }
+
+            // NOTE: Returns nullptr if the request can't be served by the pools
+            [[nodiscard]] void* allocate( size_t size )
+            {
+                if ( size > max_block_size || !m_base )
+                    return nullptr;
+
+                const size_t index = class_index( size );
+                size_class&  sc = m_classes[index];
+
+                void* result = nullptr;
+
+                lock();
+
+                if ( sc.free_list )
+                {
+                    result = sc.free_list;
+                    sc.free_list = sc.free_list->next;
+                }
+                else if ( sc.cursor != sc.end || grow( sc, index ) )
+                {
+                    result = sc.cursor;
+                    sc.cursor += class_sizes[index];
+                }
+
+                unlock();
+
+                return result;
+            }
+
+            // NOTE: Returns false if the block doesn't belong to the pools
+            [[nodiscard]] bool free( void* ptr )
+            {
+                uint8_t* p = static_cast<uint8_t*>( ptr );
+
+                if ( p < m_base || p >= m_base + reserved_size )
+                    return false;
+
+                const size_t index = m_span_classes[static_cast<size_t>( p - m_base ) / span_size];
+                size_class&  sc = m_classes[index];
+
+                free_block* block = static_cast<free_block*>( ptr );
+
+                lock();
+                block->next = sc.free_list;
+                sc.free_list = block;
+                unlock();
+
+                return true;
+            }
+
+            // NOTE: Returns zero if the block doesn't belong to the pools
+            [[nodiscard]] size_t size_of( const void* ptr ) const
+            {
+                const uint8_t* p = static_cast<const uint8_t*>( ptr );
+
+                if ( p < m_base || p >= m_base + reserved_size )
+                    return 0;
+
+                return class_sizes[m_span_classes[static_cast<size_t>( p - m_base ) / span_size]];
+            }
+
+            // NOTE: Size of the block that is actually reserved for the request of \size bytes
+            [[nodiscard]] static size_t block_size( size_t size )
+            {
+                return class_sizes[class_index( size )];
+            }
+
+        private:
+            struct free_block
+            {
+                free_block* next;
+            };
+
+            struct size_class
+            {
+                free_block* free_list;
+                uint8_t*    cursor;
+                uint8_t*    end;
+            };
+
+            // NOTE: 16 byte steps up to 128 bytes, then four steps per power of two
+            static constexpr size_t class_sizes[] = {
+                16,   32,   48,   64,   80,   96,   112,  128,  160,  192,  224,  256,  320,  384,
+                448,  512,  640,  768,  896,  1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096,
+            };
+
+            static constexpr size_t class_count = sizeof( class_sizes ) / sizeof( class_sizes[0] );
+            static constexpr size_t span_count = reserved_size / span_size;
+
+            static_assert( class_count < 256 );
+            static_assert( class_sizes[class_count - 1] == max_block_size );
+            static_assert( span_size % max_block_size == 0 );
+
+            [[nodiscard]] static size_t class_index( size_t size )
+            {
+                if ( size <= 128 )
+                    return size ? ( size - 1 ) / 16 : 0;
+
+                const size_t msb = most_significant_bit( size - 1 );
+
+                return 8 + ( msb - 7 ) * 4 + ( ( ( size - 1 ) >> ( msb - 2 ) ) & 3 );
+            }
+
+    #if defined( _WIN32 )
+            [[nodiscard]] static size_t most_significant_bit( size_t value )
+            {
+                DWORD msb;
+                ::BitScanReverse( &msb, value );
+                return msb;
+            }
+
+            [[nodiscard]] static uint8_t* reserve( size_t size )
+            {
+                void* result = ::VirtualAlloc( nullptr, size, MEM_RESERVE, PAGE_NOACCESS );
+                RTL_WINAPI_CHECK( result != nullptr );
+
+                return static_cast<uint8_t*>( result );
+            }
+
+            [[nodiscard]] static bool commit( uint8_t* ptr, size_t size )
+            {
+                return ::VirtualAlloc( ptr, size, MEM_COMMIT, PAGE_READWRITE ) != nullptr;
+            }
+
+            void lock()
+            {
+                ::AcquireSRWLockExclusive( &m_lock );
+            }
+
+            void unlock()
+            {
+                ::ReleaseSRWLockExclusive( &m_lock );
+            }
+    #else
+            [[nodiscard]] static size_t most_significant_bit( size_t value )
+            {
+                return sizeof( unsigned long long ) * 8 - 1
+                       - static_cast<size_t>( __builtin_clzll( value ) );
+            }
+
+            // NOTE: The pages are not backed by the swap until they are committed
+            [[nodiscard]] static uint8_t* reserve( size_t size )
+            {
+                void* result = ::mmap(
+                    nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0 );
+
+                return result != MAP_FAILED ? static_cast<uint8_t*>( result ) : nullptr;
+            }
+
+            [[nodiscard]] static bool commit( uint8_t* ptr, size_t size )
+            {
+                return ::mprotect( ptr, size, PROT_READ | PROT_WRITE ) == 0;
+            }
+
+            void lock()
+            {
+                ::pthread_mutex_lock( &m_lock );
+            }
+
+            void unlock()
+            {
+                ::pthread_mutex_unlock( &m_lock );
+            }
+    #endif
+
+            // NOTE: Commits the next span of the reservation to the size class
+            [[nodiscard]] bool grow( size_class& sc, size_t index )
+            {
+                if ( m_span_count == span_count )
+                    return false;
+
+                uint8_t* span = m_base + m_span_count * span_size;
+
+                if ( !commit( span, span_size ) )
+                    return false;
+
+                m_span_classes[m_span_count++] = static_cast<uint8_t>( index );
+
+                // NOTE: The tail of the span that doesn't fit a whole block is not used
+                sc.cursor = span;
+                sc.end = span + span_size / class_sizes[index] * class_sizes[index];
+                return true;
+            }
+
+            // NOTE: all variables must be initialized to zero
+            //
+    #if defined( _WIN32 )
+            SRWLOCK m_lock{ SRWLOCK_INIT };
+    #else
+            pthread_mutex_t m_lock = PTHREAD_MUTEX_INITIALIZER;
+    #endif
+            uint8_t*   m_base{ nullptr };
+            size_t     m_span_count{ 0 };
+            size_class m_classes[class_count]{};
+            uint8_t    m_span_classes[span_count]{};
+        };
+    } // namespace impl
+} // namespace rtl
+
+#endif
@@ -0,0 +1,680 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#include <rtl/atomic.hpp>
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+#include <rtl/sys/debug.hpp>
+#include <rtl/sys/jobs.hpp>
+
+#if RTL_ENABLE_JOBS
+    // NOTE: The rest of the library targets Windows only, the POSIX threads are here to run the
+    // scheduler benchmarks on Linux
+    #if defined( _WIN32 )
+        #include "win.hpp"
+
+        #define RTL_JOBS_THREAD_PROC WINAPI
+    #else
+        #include <pthread.h>
+        #include <sched.h>
+        #include <semaphore.h>
+        #include <unistd.h>
+
+        #define RTL_JOBS_THREAD_PROC
+    #endif
+
+namespace rtl
+{
+    namespace impl
+    {
+        namespace jobs
+        {
+            namespace os
+            {
+    #if defined( _WIN32 )
+                using thread_handle = HANDLE;
+                using thread_result = DWORD;
+
+                class semaphore final
+                {
+                public:
+                    void init()
+                    {
+                        m_handle = ::CreateSemaphoreW( nullptr, 0, MAXLONG, nullptr );
+                        RTL_WINAPI_CHECK( m_handle != nullptr );
+                    }
+
+                    void destroy()
+                    {
+                        [[maybe_unused]] const BOOL result = ::CloseHandle( m_handle );
+                        RTL_WINAPI_CHECK( result );
+                        m_handle = nullptr;
+                    }
+
+                    void post()
+                    {
+                        [[maybe_unused]] const BOOL result
+                            = ::ReleaseSemaphore( m_handle, 1, nullptr );
+                        RTL_WINAPI_CHECK( result );
+                    }
+
+                    void wait()
+                    {
+                        ::WaitForSingleObject( m_handle, INFINITE );
+                    }
+
+                private:
+                    HANDLE m_handle{ nullptr };
+                };
+
+                inline thread_handle start_thread( thread_result( WINAPI* proc )( void* ),
+                                                   void* argument )
+                {
+                    const HANDLE handle = ::CreateThread( nullptr, 0, proc, argument, 0, nullptr );
+                    RTL_WINAPI_CHECK( handle != nullptr );
+                    return handle;
+                }
+
+                inline void join_thread( thread_handle thread )
+                {
+                    ::WaitForSingleObject( thread, INFINITE );
+
+                    [[maybe_unused]] const BOOL result = ::CloseHandle( thread );
+                    RTL_WINAPI_CHECK( result );
+                }
+
+                inline void yield_thread()
+                {
+                    ::SwitchToThread();
+                }
+
+                [[nodiscard]] inline size_t cpu_count()
+                {
+                    SYSTEM_INFO info;
+                    ::GetSystemInfo( &info );
+                    return info.dwNumberOfProcessors;
+                }
+
+                class thread_local_pointer final
+                {
+                public:
+                    void init()
+                    {
+                        m_index = ::TlsAlloc();
+                        RTL_WINAPI_CHECK( m_index != TLS_OUT_OF_INDEXES );
+                    }
+
+                    void destroy()
+                    {
+                        [[maybe_unused]] const BOOL result = ::TlsFree( m_index );
+                        RTL_WINAPI_CHECK( result );
+                    }
+
+                    [[nodiscard]] void* get() const
+                    {
+                        return ::TlsGetValue( m_index );
+                    }
+
+                    void set( void* value )
+                    {
+                        ::TlsSetValue( m_index, value );
+                    }
+
+                private:
+                    DWORD m_index{ 0 };
+                };
+    #else
+                using thread_handle = pthread_t;
+                using thread_result = void*;
+
+                class semaphore final
+                {
+                public:
+                    void init()
+                    {
+                        [[maybe_unused]] const int result = sem_init( &m_handle, 0, 0 );
+                        RTL_ASSERT( result == 0 );
+                    }
+
+                    void destroy()
+                    {
+                        sem_destroy( &m_handle );
+                    }
+
+                    void post()
+                    {
+                        sem_post( &m_handle );
+                    }
+
+                    // NOTE: The wait is restarted if a signal interrupts it
+                    void wait()
+                    {
+                        while ( sem_wait( &m_handle ) != 0 )
+                        {
+                        }
+                    }
+
+                private:
+                    sem_t m_handle{};
+                };
+
+                inline thread_handle start_thread( thread_result ( *proc )( void* ),
+                                                   void* argument )
+                {
+                    pthread_t                  thread;
+                    [[maybe_unused]] const int result
+                        = pthread_create( &thread, nullptr, proc, argument );
+                    RTL_ASSERT( result == 0 );
+                    return thread;
+                }
+
+                inline void join_thread( thread_handle thread )
+                {
+                    pthread_join( thread, nullptr );
+                }
+
+                inline void yield_thread()
+                {
+                    sched_yield();
+                }
+
+                [[nodiscard]] inline size_t cpu_count()
+                {
+                    const long count = sysconf( _SC_NPROCESSORS_ONLN );
+                    return count > 0 ? static_cast<size_t>( count ) : 1;
+                }
+
+                class thread_local_pointer final
+                {
+                public:
+                    void init()
+                    {
+                        [[maybe_unused]] const int result = pthread_key_create( &m_key, nullptr );
+                        RTL_ASSERT( result == 0 );
+                    }
+
+                    void destroy()
+                    {
+                        pthread_key_delete( m_key );
+                    }
+
+                    [[nodiscard]] void* get() const
+                    {
+                        return pthread_getspecific( m_key );
+                    }
+
+                    void set( void* value )
+                    {
+                        pthread_setspecific( m_key, value );
+                    }
+
+                private:
+                    pthread_key_t m_key{};
+                };
+    #endif
+            } // namespace os
+
+            struct slot;
+
+            struct job
+            {
+                rtl::jobs::function    fn{ nullptr };
+                void*                  context{ nullptr };
+                rtl::jobs::task_group* group{ nullptr };
+                slot*                  owner{ nullptr };
+
+                // NOTE: Set while the job is in a deque, so its record is not reused before the
+                // thread that took it copies the fields
+                atomic<int> busy;
+            };
+
+            // Chase-Lev work-stealing deque of a fixed capacity. The owner thread pushes and pops
+            // the jobs at the bottom end, the other threads steal them from the top one.
+            //
+            // NOTE: The memory orders follow "Correct and Efficient Work-Stealing for Weak Memory
+            // Models" by N. M. Le et al. The deque does not grow, the owner checks \full before
+            // \push instead.
+            class deque final
+            {
+            public:
+                static constexpr ptrdiff_t capacity = 256;
+
+                [[nodiscard]] bool full() const
+                {
+                    const ptrdiff_t top = m_top.load( memory_order_acquire );
+                    return m_bottom.load( memory_order_relaxed ) - top >= capacity;
+                }
+
+                [[nodiscard]] bool empty() const
+                {
+                    const ptrdiff_t top = m_top.load( memory_order_acquire );
+                    return m_bottom.load( memory_order_acquire ) <= top;
+                }
+
+                void push( job* item )
+                {
+                    const ptrdiff_t bottom = m_bottom.load( memory_order_relaxed );
+
+                    m_items[bottom & mask].store( item, memory_order_relaxed );
+                    m_bottom.store( bottom + 1, memory_order_release );
+                }
+
+                [[nodiscard]] job* pop()
+                {
+                    const ptrdiff_t bottom = m_bottom.load( memory_order_relaxed ) - 1;
+
+                    // NOTE: The bottom must be published before the top is read, otherwise the
+                    // owner and a thief can take the last job both
+                    m_bottom.store( bottom, memory_order_relaxed );
+                    atomic_thread_fence( memory_order_seq_cst );
+
+                    ptrdiff_t top = m_top.load( memory_order_relaxed );
+
+                    if ( top > bottom )
+                    {
+                        m_bottom.store( bottom + 1, memory_order_relaxed );
+                        return nullptr;
+                    }
+
+                    job* item = m_items[bottom & mask].load( memory_order_relaxed );
+
+                    if ( top == bottom )
+                    {
+                        if ( !m_top.compare_exchange_strong(
+                                 top, top + 1, memory_order_seq_cst, memory_order_relaxed ) )
+                            item = nullptr;
+
+                        m_bottom.store( bottom + 1, memory_order_relaxed );
+                    }
+
+                    return item;
+                }
+
+                [[nodiscard]] job* steal()
+                {
+                    ptrdiff_t top = m_top.load( memory_order_acquire );
+                    atomic_thread_fence( memory_order_seq_cst );
+                    const ptrdiff_t bottom = m_bottom.load( memory_order_acquire );
+
+                    if ( top >= bottom )
+                        return nullptr;
+
+                    job* item = m_items[top & mask].load( memory_order_relaxed );
+
+                    if ( !m_top.compare_exchange_strong(
+                             top, top + 1, memory_order_seq_cst, memory_order_relaxed ) )
+                        return nullptr;
+
+                    return item;
+                }
+
+            private:
+                static constexpr ptrdiff_t mask = capacity - 1;
+
+                alignas( hardware_destructive_interference_size ) atomic<ptrdiff_t> m_top;
+                alignas( hardware_destructive_interference_size ) atomic<ptrdiff_t> m_bottom;
+                atomic<job*> m_items[capacity];
+            };
+
+            // Deque and job records of a thread, either a worker or one that came from outside
+            struct alignas( hardware_destructive_interference_size ) slot
+            {
+                deque    queue;
+                job      jobs[deque::capacity];
+                size_t   next_job{ 0 };
+                uint32_t random{ 0 };
+
+                // NOTE: The jobs pushed and not yet taken by any thread
+                atomic<size_t> queued;
+
+                // NOTE: An external slot is owned by a thread between the first \run and the end
+                // of the outermost \wait with no jobs left in the deque
+                atomic<int> owned;
+                unsigned    waits{ 0 };
+            };
+
+            class scheduler final
+            {
+            public:
+                // NOTE: Zero \thread_count means a thread per logical CPU
+                void init( size_t thread_count = 0 )
+                {
+                    RTL_ASSERT( m_worker_count == 0 );
+
+                    if ( thread_count == 0 )
+                        thread_count = os::cpu_count();
+
+                    m_worker_count = rtl::min( thread_count, max_workers + 1 ) - 1;
+                    m_running.store( 1 );
+
+                    m_semaphore.init();
+                    m_current_slot.init();
+
+                    for ( size_t i = 0; i < max_slots; ++i )
+                    {
+                        m_slots[i].random = static_cast<uint32_t>( i ) * 0x9e3779b9u + 1;
+
+                        for ( job& record : m_slots[i].jobs )
+                            record.owner = &m_slots[i];
+                    }
+
+                    for ( size_t i = 0; i < m_worker_count; ++i )
+                        m_threads[i] = os::start_thread( &worker_proc, &m_slots[max_external + i] );
+                }
+
+                // NOTE: All jobs must be done by then. The scheduler can be initialized again
+                // afterwards, with another number of threads.
+                void shutdown()
+                {
+                    m_running.store( 0 );
+
+                    // NOTE: A signal per worker, whether it sleeps or is about to. The ones left
+                    // over go away with the semaphore.
+                    for ( size_t i = 0; i < m_worker_count; ++i )
+                        m_semaphore.post();
+
+                    for ( size_t i = 0; i < m_worker_count; ++i )
+                        os::join_thread( m_threads[i] );
+
+                    m_worker_count = 0;
+                    m_sleeping.store( 0 );
+
+                    m_current_slot.destroy();
+                    m_semaphore.destroy();
+                }
+
+                [[nodiscard]] size_t thread_count() const
+                {
+                    return m_worker_count + 1;
+                }
+
+                // NOTE: If all external slots are taken by other threads, the job runs right
+                // away on the calling thread
+                void run( rtl::jobs::task_group& group, rtl::jobs::function fn, void* context )
+                {
+                    slot* const self = acquire_slot();
+
+                    if ( !self )
+                    {
+                        fn( context );
+                        return;
+                    }
+
+                    job& record = self->jobs[self->next_job++ % jobs_per_slot];
+
+                    if ( record.busy.load( memory_order_acquire ) || self->queue.full() )
+                    {
+                        fn( context );
+                        return;
+                    }
+
+                    record.fn = fn;
+                    record.context = context;
+                    record.group = &group;
+                    record.busy.store( 1, memory_order_relaxed );
+
+                    group.m_pending.fetch_add( 1, memory_order_relaxed );
+                    self->queued.fetch_add( 1, memory_order_relaxed );
+                    self->queue.push( &record );
+
+                    wake_one();
+                }
+
+                // NOTE: A thread without a slot only steals, the jobs of the group may have been
+                // started by the nested jobs of other threads
+                void wait( rtl::jobs::task_group& group )
+                {
+                    slot* const self = static_cast<slot*>( m_current_slot.get() );
+                    uint32_t    random = 0x9e3779b9u;
+
+                    if ( self )
+                        ++self->waits;
+
+                    for ( unsigned idle = 0; group.m_pending.load( memory_order_acquire ) != 0; )
+                    {
+                        if ( job* next = self ? find_job( *self ) : steal_job( random ) )
+                        {
+                            execute( next );
+                            idle = 0;
+                        }
+                        else if ( ++idle < spin_count )
+                        {
+                            cpu_relax();
+                        }
+                        else
+                        {
+                            os::yield_thread();
+                        }
+                    }
+
+                    if ( self && --self->waits == 0 )
+                        release_slot( *self );
+                }
+
+                // The external slots owned by threads at the moment
+                [[nodiscard]] size_t external_slots_in_use() const
+                {
+                    size_t count = 0;
+
+                    for ( size_t i = 0; i < max_external; ++i )
+                        count += m_slots[i].owned.load( memory_order_relaxed ) != 0;
+
+                    return count;
+                }
+
+            private:
+                // NOTE: Slots are allocated statically, so the number of threads is limited
+                static constexpr size_t max_workers = 28;
+                static constexpr size_t max_external = 4;
+                static constexpr size_t max_slots = max_workers + max_external;
+                static constexpr size_t jobs_per_slot = static_cast<size_t>( deque::capacity );
+
+                // NOTE: Tens of microseconds of polling before a worker goes to sleep
+                static constexpr unsigned spin_count = 4096;
+
+                static os::thread_result RTL_JOBS_THREAD_PROC worker_proc( void* argument );
+
+                // NOTE: Threads other than the workers take a free external slot on the first use,
+                // nullptr if there is none
+                slot* acquire_slot()
+                {
+                    if ( slot* self = static_cast<slot*>( m_current_slot.get() ) )
+                        return self;
+
+                    for ( size_t i = 0; i < max_external; ++i )
+                    {
+                        int free = 0;
+
+                        if ( m_slots[i].owned.compare_exchange_strong(
+                                 free, 1, memory_order_acquire, memory_order_relaxed ) )
+                        {
+                            m_current_slot.set( &m_slots[i] );
+                            return &m_slots[i];
+                        }
+                    }
+
+                    return nullptr;
+                }
+
+                // NOTE: The jobs of the groups that are not waited for yet keep the slot owned
+                // until their \wait
+                void release_slot( slot& self )
+                {
+                    if ( &self >= m_slots + max_external )
+                        return;
+
+                    if ( self.queued.load( memory_order_acquire ) != 0 )
+                        return;
+
+                    m_current_slot.set( nullptr );
+                    self.owned.store( 0, memory_order_release );
+                }
+
+                // NOTE: The own jobs are taken LIFO to stay in the cache, the stolen ones FIFO to
+                // take the largest pieces of work
+                job* find_job( slot& self )
+                {
+                    if ( job* own = self.queue.pop() )
+                        return own;
+
+                    return steal_job( self.random );
+                }
+
+                job* steal_job( uint32_t& random )
+                {
+                    const size_t count = max_external + m_worker_count;
+
+                    random ^= random << 13;
+                    random ^= random >> 17;
+                    random ^= random << 5;
+
+                    for ( size_t i = 0, victim = random % count; i < count; ++i )
+                    {
+                        if ( job* stolen = m_slots[victim].queue.steal() )
+                            return stolen;
+
+                        if ( ++victim == count )
+                            victim = 0;
+                    }
+
+                    return nullptr;
+                }
+
+                [[nodiscard]] bool any_jobs() const
+                {
+                    for ( size_t i = 0; i < max_external + m_worker_count; ++i )
+                    {
+                        if ( !m_slots[i].queue.empty() )
+                            return true;
+                    }
+
+                    return false;
+                }
+
+                static void execute( job* record )
+                {
+                    const rtl::jobs::function    fn = record->fn;
+                    void* const                  context = record->context;
+                    rtl::jobs::task_group* const group = record->group;
+
+                    record->busy.store( 0, memory_order_release );
+                    record->owner->queued.fetch_sub( 1, memory_order_release );
+
+                    fn( context );
+                    group->m_pending.fetch_sub( 1, memory_order_release );
+                }
+
+                // NOTE: The fence orders the push before the read of the sleeper count. It pairs
+                // with the increment of the count before the last check for jobs in \work, so
+                // either the worker sees the job or this thread sees the worker.
+                void wake_one()
+                {
+                    atomic_thread_fence( memory_order_seq_cst );
+
+                    for ( int sleeping = m_sleeping.load( memory_order_relaxed ); sleeping > 0; )
+                    {
+                        if ( m_sleeping.compare_exchange_weak( sleeping, sleeping - 1 ) )
+                        {
+                            m_semaphore.post();
+                            return;
+                        }
+                    }
+                }
+
+                void work( slot& self )
+                {
+                    m_current_slot.set( &self );
+
+                    for ( unsigned idle = 0; m_running.load( memory_order_relaxed ); )
+                    {
+                        if ( job* next = find_job( self ) )
+                        {
+                            execute( next );
+                            idle = 0;
+                            continue;
+                        }
+
+                        if ( ++idle < spin_count )
+                        {
+                            cpu_relax();
+                            continue;
+                        }
+
+                        m_sleeping.fetch_add( 1 );
+                        atomic_thread_fence( memory_order_seq_cst );
+
+                        if ( any_jobs() || !m_running.load() )
+                        {
+                            // NOTE: If a waker has already taken the count back, the semaphore
+                            // keeps its signal, and some worker will just wake up once in vain
+                            for ( int sleeping = m_sleeping.load(); sleeping > 0; )
+                            {
+                                if ( m_sleeping.compare_exchange_weak( sleeping, sleeping - 1 ) )
+                                    break;
+                            }
+                        }
+                        else
+                        {
+                            m_semaphore.wait();
+                        }
+
+                        idle = 0;
+                    }
+                }
+
+                // NOTE: all variables must be initialized to zero
+                //
+                slot                     m_slots[max_slots]{};
+                os::thread_handle        m_threads[max_workers]{};
+                size_t                   m_worker_count{ 0 };
+                atomic<int>              m_sleeping;
+                atomic<int>              m_running;
+                os::semaphore            m_semaphore;
+                os::thread_local_pointer m_current_slot;
+            };
+
+            scheduler g_scheduler;
+
+            os::thread_result RTL_JOBS_THREAD_PROC scheduler::worker_proc( void* argument )
+            {
+                g_scheduler.work( *static_cast<slot*>( argument ) );
+                return 0;
+            }
+
+    #undef RTL_JOBS_THREAD_PROC
+        } // namespace jobs
+    }     // namespace impl
+
+    namespace jobs
+    {
+        size_t thread_count()
+        {
+            return impl::jobs::g_scheduler.thread_count();
+        }
+
+        void task_group::run( function fn, void* context )
+        {
+            impl::jobs::g_scheduler.run( *this, fn, context );
+        }
+
+        void task_group::wait()
+        {
+            impl::jobs::g_scheduler.wait( *this );
+        }
+    } // namespace jobs
+} // namespace rtl
+
+#endif
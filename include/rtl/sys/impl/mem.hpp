@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#if RTL_ENABLE_MEMSET || RTL_ENABLE_MEMCPY
+    #include <rtl/int.hpp>
+
+    #include <emmintrin.h>
+
+    #include "cpu.hpp"
+
+// Bodies of the memset, memcpy and memmove of the runtime. They are kept apart from the C
+// functions, so the benchmark can compare them with the C library of the host.
+namespace rtl
+{
+    namespace impl
+    {
+        namespace mem
+        {
+            // NOTE: Starting from this size the string instructions outperform the SSE2 loops on
+            // the CPUs with ERMSB
+            constexpr size_t rep_threshold = 2048;
+
+            // NOTE: Starting from this size the destination won't stay in cache anyway, so it is
+            // written with the non-temporal stores
+            constexpr size_t streaming_threshold = 4 * 1024 * 1024;
+
+            // NOTE: x86 allows unaligned access
+            [[nodiscard]] inline uint32_t load32( const uint8_t* p )
+            {
+                return *reinterpret_cast<const uint32_t*>( p );
+            }
+
+            inline void store32( uint8_t* p, uint32_t value )
+            {
+                *reinterpret_cast<uint32_t*>( p ) = value;
+            }
+
+            [[nodiscard]] inline __m128i load64( const uint8_t* p )
+            {
+                return _mm_loadl_epi64( reinterpret_cast<const __m128i*>( p ) );
+            }
+
+            inline void store64( uint8_t* p, __m128i value )
+            {
+                _mm_storel_epi64( reinterpret_cast<__m128i*>( p ), value );
+            }
+
+            [[nodiscard]] inline __m128i load128( const uint8_t* p )
+            {
+                return _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+            }
+
+            inline void store128( uint8_t* p, __m128i value )
+            {
+                _mm_storeu_si128( reinterpret_cast<__m128i*>( p ), value );
+            }
+
+            inline void store128_aligned( uint8_t* p, __m128i value )
+            {
+                _mm_store_si128( reinterpret_cast<__m128i*>( p ), value );
+            }
+
+            inline void stream128( uint8_t* p, __m128i value )
+            {
+                _mm_stream_si128( reinterpret_cast<__m128i*>( p ), value );
+            }
+
+            [[nodiscard]] inline uint8_t* align_up( uint8_t* p )
+            {
+                const size_t address = reinterpret_cast<size_t>( p );
+                return reinterpret_cast<uint8_t*>( ( address + 15 ) & ~size_t( 15 ) );
+            }
+
+            [[nodiscard]] inline uint8_t* align_down( uint8_t* p )
+            {
+                return reinterpret_cast<uint8_t*>( reinterpret_cast<size_t>( p ) & ~size_t( 15 ) );
+            }
+
+            // NOTE: GCC and Clang have no intrinsics for the string instructions
+            inline void rep_stosb( uint8_t* dst, uint8_t value, size_t count )
+            {
+    #if defined( _MSC_VER )
+                __stosb( dst, value, count );
+    #else
+                __asm__ volatile( "rep stosb"
+                                  : "+D"( dst ), "+c"( count )
+                                  : "a"( value )
+                                  : "memory" );
+    #endif
+            }
+
+            inline void rep_movsb( uint8_t* dst, const uint8_t* src, size_t count )
+            {
+    #if defined( _MSC_VER )
+                __movsb( dst, src, count );
+    #else
+                __asm__ volatile( "rep movsb"
+                                  : "+D"( dst ), "+S"( src ), "+c"( count )
+                                  :
+                                  : "memory" );
+    #endif
+            }
+
+    #if RTL_ENABLE_MEMSET
+            inline void fill( uint8_t* dst, uint8_t value, size_t count )
+            {
+                if ( count < 16 )
+                {
+                    // NOTE: Overlapping stores cover any size without a loop
+                    if ( count >= 4 )
+                    {
+                        const uint32_t value32 = value * 0x01010101u;
+
+                        store32( dst, value32 );
+                        store32( dst + count - 4, value32 );
+
+                        if ( count > 8 )
+                        {
+                            store32( dst + 4, value32 );
+                            store32( dst + count - 8, value32 );
+                        }
+                    }
+                    else if ( count > 0 )
+                    {
+                        dst[0] = value;
+                        dst[count / 2] = value;
+                        dst[count - 1] = value;
+                    }
+
+                    return;
+                }
+
+                if ( count >= rep_threshold && count < streaming_threshold && g_cpu.erms() )
+                {
+                    rep_stosb( dst, value, count );
+                    return;
+                }
+
+                const __m128i  value128 = _mm_set1_epi8( static_cast<char>( value ) );
+                uint8_t* const last = dst + count - 16;
+                uint8_t*       p = align_up( dst + 1 );
+
+                store128( dst, value128 );
+
+                if ( count >= streaming_threshold )
+                {
+                    for ( ; p < last; p += 16 )
+                        stream128( p, value128 );
+
+                    _mm_sfence();
+                }
+                else
+                {
+                    for ( ; p + 64 <= last; p += 64 )
+                    {
+                        store128_aligned( p, value128 );
+                        store128_aligned( p + 16, value128 );
+                        store128_aligned( p + 32, value128 );
+                        store128_aligned( p + 48, value128 );
+                    }
+
+                    for ( ; p < last; p += 16 )
+                        store128_aligned( p, value128 );
+                }
+
+                store128( last, value128 );
+            }
+    #endif
+
+    #if RTL_ENABLE_MEMCPY
+            // NOTE: All the source bytes are loaded before the first store, so the ranges may
+            // overlap. Handles up to 32 bytes.
+            inline void copy_small( uint8_t* dst, const uint8_t* src, size_t count )
+            {
+                if ( count >= 16 )
+                {
+                    const __m128i head = load128( src );
+                    const __m128i tail = load128( src + count - 16 );
+                    store128( dst, head );
+                    store128( dst + count - 16, tail );
+                }
+                else if ( count >= 8 )
+                {
+                    const __m128i head = load64( src );
+                    const __m128i tail = load64( src + count - 8 );
+                    store64( dst, head );
+                    store64( dst + count - 8, tail );
+                }
+                else if ( count >= 4 )
+                {
+                    const uint32_t head = load32( src );
+                    const uint32_t tail = load32( src + count - 4 );
+                    store32( dst, head );
+                    store32( dst + count - 4, tail );
+                }
+                else if ( count > 0 )
+                {
+                    const uint8_t first = src[0];
+                    const uint8_t middle = src[count / 2];
+                    const uint8_t last = src[count - 1];
+                    dst[0] = first;
+                    dst[count / 2] = middle;
+                    dst[count - 1] = last;
+                }
+            }
+
+            // NOTE: Copies more than 32 bytes in ascending order. Destination is written by the
+            // aligned stores, unaligned head and tail are loaded in advance and stored last.
+            // So the ranges may overlap if \dst is below \src.
+            inline void copy_forward( uint8_t* dst, const uint8_t* src, size_t count )
+            {
+                const __m128i head = load128( src );
+                const __m128i tail = load128( src + count - 16 );
+
+                uint8_t* const last = dst + count - 16;
+                uint8_t*       d = align_up( dst + 1 );
+                const uint8_t* s = src + ( d - dst );
+
+                if ( count >= streaming_threshold )
+                {
+                    for ( ; d < last; d += 16, s += 16 )
+                        stream128( d, load128( s ) );
+
+                    _mm_sfence();
+                }
+                else
+                {
+                    for ( ; d + 64 <= last; d += 64, s += 64 )
+                    {
+                        const __m128i a = load128( s );
+                        const __m128i b = load128( s + 16 );
+                        const __m128i c = load128( s + 32 );
+                        const __m128i e = load128( s + 48 );
+                        store128_aligned( d, a );
+                        store128_aligned( d + 16, b );
+                        store128_aligned( d + 32, c );
+                        store128_aligned( d + 48, e );
+                    }
+
+                    for ( ; d < last; d += 16, s += 16 )
+                        store128_aligned( d, load128( s ) );
+                }
+
+                store128( dst, head );
+                store128( last, tail );
+            }
+
+            // NOTE: The same as \copy_forward, but in descending order. The ranges may overlap
+            // if \dst is above \src.
+            inline void copy_backward( uint8_t* dst, const uint8_t* src, size_t count )
+            {
+                const __m128i head = load128( src );
+                const __m128i tail = load128( src + count - 16 );
+
+                uint8_t*       d = align_down( dst + count ) - 16;
+                const uint8_t* s = src + ( d - dst );
+
+                for ( ; d > dst + 48; d -= 64, s -= 64 )
+                {
+                    const __m128i a = load128( s );
+                    const __m128i b = load128( s - 16 );
+                    const __m128i c = load128( s - 32 );
+                    const __m128i e = load128( s - 48 );
+                    store128_aligned( d, a );
+                    store128_aligned( d - 16, b );
+                    store128_aligned( d - 32, c );
+                    store128_aligned( d - 48, e );
+                }
+
+                for ( ; d > dst; d -= 16, s -= 16 )
+                    store128_aligned( d, load128( s ) );
+
+                store128( dst + count - 16, tail );
+                store128( dst, head );
+            }
+
+            inline void copy( uint8_t* dst, const uint8_t* src, size_t count )
+            {
+                if ( count <= 32 )
+                    copy_small( dst, src, count );
+                else if ( count >= rep_threshold && count < streaming_threshold
+                          && rtl::impl::g_cpu.erms() )
+                    rep_movsb( dst, src, count );
+                else
+                    copy_forward( dst, src, count );
+            }
+
+            inline void move( uint8_t* dst, const uint8_t* src, size_t count )
+            {
+                // NOTE: Ascending copy is safe unless the destination starts inside the src range.
+                // Both rep movsb and \copy_forward read every byte before the byte below it is written.
+                if ( reinterpret_cast<size_t>( dst ) - reinterpret_cast<size_t>( src ) >= count )
+                    copy( dst, src, count );
+                else if ( count <= 32 )
+                    copy_small( dst, src, count );
+                else
+                    copy_backward( dst, src, count );
+            }
+    #endif
+        } // namespace mem
+    }     // namespace impl
+} // namespace rtl
+
+#endif
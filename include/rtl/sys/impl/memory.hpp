@@ -17,19 +17,39 @@
 #include <rtl/int.hpp>
 
 #include "heap.hpp"
+#include "mem.hpp"
 
 #if RTL_ENABLE_MEMSET
 
 extern "C" void* __cdecl memset( void* dest, int ch, size_t count )
 {
-    char* dst = static_cast<char*>( dest );
+    rtl::impl::mem::fill(
+        static_cast<rtl::uint8_t*>( dest ), static_cast<rtl::uint8_t>( ch ), count );
+    return dest;
+}
+
+#endif
 
-    for ( ; count; --count )
-        *dst++ = static_cast<char>( ch );
+#if RTL_ENABLE_MEMCPY
 
+extern "C" void* __cdecl memcpy( void* dest, const void* src, size_t count )
+{
+    rtl::impl::mem::copy(
+        static_cast<rtl::uint8_t*>( dest ), static_cast<const rtl::uint8_t*>( src ), count );
     return dest;
 }
 
+extern "C" void* __cdecl memmove( void* dest, const void* src, size_t count )
+{
+    rtl::impl::mem::move(
+        static_cast<rtl::uint8_t*>( dest ), static_cast<const rtl::uint8_t*>( src ), count );
+    return dest;
+}
+
+#endif
+
+#if RTL_ENABLE_HEAP_STATS && !RTL_ENABLE_HEAP
+    #error "RTL_ENABLE_HEAP_STATS=1 needs RTL_ENABLE_HEAP=1"
 #endif
 
 #if RTL_ENABLE_HEAP
@@ -40,13 +60,35 @@ namespace rtl
     {
         heap g_heap;
     }
-} // namespace rtl
 
-// TODO: Implement placement new
+    void* malloc( size_t size )
+    {
+        return impl::g_heap.malloc( size );
+    }
+
+    void* calloc( size_t num, size_t size )
+    {
+        return impl::g_heap.calloc( num, size );
+    }
+
+    void free( void* ptr )
+    {
+        impl::g_heap.free( ptr );
+    }
+
+    #if RTL_ENABLE_HEAP_STATS
+    heap_statistics get_heap_statistics()
+    {
+        return impl::g_heap.counters().snapshot();
+    }
+    #endif
+} // namespace rtl
 
+// NOTE: As required by the standard, new-expressions do not zero the memory. Use value
+// initialization or \rtl::calloc when zeroes are needed.
 [[nodiscard]] void* operator new( size_t count )
 {
-    return rtl::impl::g_heap.calloc( 1, count );
+    return rtl::impl::g_heap.malloc( count );
 }
 
 void operator delete( void* p )
@@ -61,7 +103,7 @@ void operator delete( void* p, size_t )
 
 [[nodiscard]] void* operator new[]( size_t count )
 {
-    return rtl::impl::g_heap.calloc( count, 1 );
+    return rtl::impl::g_heap.malloc( count );
 }
 
 void operator delete[]( void* p )
@@ -74,4 +116,34 @@ void operator delete[]( void* p, size_t )
     rtl::impl::g_heap.free( p );
 }
 
+[[nodiscard]] void* operator new( size_t count, std::align_val_t alignment )
+{
+    return rtl::impl::g_heap.aligned_malloc( count, static_cast<size_t>( alignment ) );
+}
+
+void operator delete( void* p, std::align_val_t )
+{
+    rtl::impl::g_heap.aligned_free( p );
+}
+
+void operator delete( void* p, size_t, std::align_val_t )
+{
+    rtl::impl::g_heap.aligned_free( p );
+}
+
+[[nodiscard]] void* operator new[]( size_t count, std::align_val_t alignment )
+{
+    return rtl::impl::g_heap.aligned_malloc( count, static_cast<size_t>( alignment ) );
+}
+
+void operator delete[]( void* p, std::align_val_t )
+{
+    rtl::impl::g_heap.aligned_free( p );
+}
+
+void operator delete[]( void* p, size_t, std::align_val_t )
+{
+    rtl::impl::g_heap.aligned_free( p );
+}
+
 #endif
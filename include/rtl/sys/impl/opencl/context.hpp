@@ -145,7 +145,7 @@ namespace rtl
                         program_object, device_id, CL_PROGRAM_BUILD_LOG, 0, nullptr, &log_size );
                     RTL_OPENCL_CHECK( status );
 
-                    rtl::string log( log_size, 0 );
+                    rtl::string log( log_size, rtl::default_init );
                     status = ::clGetProgramBuildInfo( program_object,
                                                       device_id,
                                                       CL_PROGRAM_BUILD_LOG,
@@ -154,7 +154,7 @@ namespace rtl
                                                       nullptr );
                     RTL_OPENCL_CHECK( status );
 
-                    RTL_LOG( "OpenCL program build log:\r\n%s", log.c_str() );
+                    RTL_LOG( "OpenCL program build log:\r\n{}", log.c_str() );
 
                     return program();
                 }
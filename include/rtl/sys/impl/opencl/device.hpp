@@ -36,7 +36,7 @@ namespace rtl
                     = ::clGetDeviceInfo( device_id, CL_DEVICE_NAME, 0, nullptr, &name_byte_count );
                 RTL_OPENCL_CHECK( result );
 
-                m_name = string( name_byte_count - 1, 0 );
+                m_name = string( name_byte_count - 1, rtl::default_init );
 
                 result = ::clGetDeviceInfo(
                     device_id, CL_DEVICE_NAME, name_byte_count, m_name.data(), nullptr );
@@ -49,7 +49,7 @@ namespace rtl
                     device_id, CL_DEVICE_VERSION, 0, nullptr, &version_byte_count );
                 RTL_OPENCL_CHECK( result );
 
-                m_version = string( version_byte_count - 1, 0 );
+                m_version = string( version_byte_count - 1, rtl::default_init );
 
                 result = ::clGetDeviceInfo(
                     device_id, CL_DEVICE_VERSION, version_byte_count, m_version.data(), nullptr );
@@ -62,7 +62,7 @@ namespace rtl
                     device_id, CL_DEVICE_EXTENSIONS, 0, nullptr, &extensions_byte_count );
                 RTL_OPENCL_CHECK( result );
 
-                m_extensions = string( extensions_byte_count - 1, 0 );
+                m_extensions = string( extensions_byte_count - 1, rtl::default_init );
 
                 result = ::clGetDeviceInfo( device_id,
                                             CL_DEVICE_EXTENSIONS,
@@ -78,7 +78,7 @@ namespace rtl
                     device_id, CL_DEVICE_VENDOR, 0, nullptr, &vendor_byte_count );
                 RTL_OPENCL_CHECK( result );
 
-                m_vendor = string( vendor_byte_count, 0 );
+                m_vendor = string( vendor_byte_count, rtl::default_init );
 
                 result = ::clGetDeviceInfo(
                     device_id, CL_DEVICE_VENDOR, m_vendor.size(), m_vendor.data(), nullptr );
@@ -124,7 +124,7 @@ namespace rtl
                                            &device_count );
                 RTL_OPENCL_CHECK( result );
 
-                rtl::vector<cl_device_id> device_ids( device_count );
+                rtl::small_vector<cl_device_id, 8> device_ids( device_count, rtl::default_init );
 
                 result = ::clGetDeviceIDs( static_cast<cl_platform_id>( platform.m_id ),
                                            CL_DEVICE_TYPE_ALL,
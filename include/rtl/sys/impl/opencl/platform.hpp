@@ -34,7 +34,7 @@ namespace rtl
             result = ::clGetPlatformIDs( 0, nullptr, &platform_count );
             RTL_OPENCL_CHECK( result );
 
-            rtl::unique_ptr<cl_platform_id[]> platforms( new cl_platform_id[platform_count] );
+            auto platforms = rtl::make_unique_for_overwrite<cl_platform_id[]>( platform_count );
             result = ::clGetPlatformIDs( platform_count, platforms.get(), &platform_count );
             RTL_OPENCL_CHECK( result );
 
@@ -49,7 +49,7 @@ namespace rtl
                     platforms[i], CL_PLATFORM_EXTENSIONS, 0, nullptr, &ext_bytes_count );
                 RTL_OPENCL_CHECK( result );
 
-                rtl::string ext( ext_bytes_count, 0 );
+                rtl::string ext( ext_bytes_count, rtl::default_init );
 
                 result = ::clGetPlatformInfo(
                     platforms[i], CL_PLATFORM_EXTENSIONS, ext.size(), ext.data(), nullptr );
@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#ifndef RTL_IMPLEMENTATION
+    #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
+#endif
+
+#include <emmintrin.h>
+
+#if defined( _MSC_VER )
+    #include <intrin.h>
+#endif
+
+#include <rtl/int.hpp>
+#include <rtl/string.hpp>
+
+// Bodies of the narrow string search. They are kept apart from the Windows parts of the strings,
+// so the benchmark can compare them with the C library of the host.
+namespace rtl
+{
+    namespace impl
+    {
+        namespace search
+        {
+            constexpr size_t npos = (size_t)-1;
+
+            // NOTE: Patterns longer than this are searched by Horspool, as the SSE2 filter
+            // produces too many false candidates on them in repetitive texts
+            constexpr size_t long_pattern_size = 32;
+
+            // NOTE: Sets of up to this many characters are matched by SSE2 in \find_first_of
+            constexpr size_t small_set_size = 8;
+
+            [[nodiscard]] inline __m128i load( const char* p )
+            {
+                return _mm_loadu_si128( reinterpret_cast<const __m128i*>( p ) );
+            }
+
+            [[nodiscard]] inline unsigned match( const char* p, __m128i ch )
+            {
+                const __m128i equal = _mm_cmpeq_epi8( load( p ), ch );
+                return static_cast<unsigned>( _mm_movemask_epi8( equal ) );
+            }
+
+            // NOTE: Whether any of the 64 characters at \p matches
+            [[nodiscard]] inline bool match_any( const char* p, __m128i ch )
+            {
+                const __m128i a = _mm_cmpeq_epi8( load( p ), ch );
+                const __m128i b = _mm_cmpeq_epi8( load( p + 16 ), ch );
+                const __m128i c = _mm_cmpeq_epi8( load( p + 32 ), ch );
+                const __m128i d = _mm_cmpeq_epi8( load( p + 48 ), ch );
+
+                const __m128i any = _mm_or_si128( _mm_or_si128( a, b ), _mm_or_si128( c, d ) );
+                return _mm_movemask_epi8( any ) != 0;
+            }
+
+            [[nodiscard]] inline size_t lowest_bit( unsigned mask )
+            {
+#if defined( _MSC_VER )
+                unsigned long index;
+                _BitScanForward( &index, mask );
+                return index;
+#else
+                return static_cast<size_t>( __builtin_ctz( mask ) );
+#endif
+            }
+
+            [[nodiscard]] inline size_t highest_bit( unsigned mask )
+            {
+#if defined( _MSC_VER )
+                unsigned long index;
+                _BitScanReverse( &index, mask );
+                return index;
+#else
+                return static_cast<size_t>( 31 - __builtin_clz( mask ) );
+#endif
+            }
+
+            [[nodiscard]] inline bool equal( const char* a, const char* b, size_t size )
+            {
+                for ( size_t i = 0; i < size; ++i )
+                    if ( a[i] != b[i] )
+                        return false;
+
+                return true;
+            }
+
+            [[nodiscard]] inline size_t horspool( const char* str,
+                                                  size_t      size,
+                                                  const char* pattern,
+                                                  size_t      pattern_size )
+            {
+                const size_t last = pattern_size - 1;
+
+                size_t shift[256];
+                for ( size_t& s : shift )
+                    s = pattern_size;
+
+                for ( size_t i = 0; i < last; ++i )
+                    shift[static_cast<unsigned char>( pattern[i] )] = last - i;
+
+                for ( size_t i = 0; i <= size - pattern_size; )
+                {
+                    const char ch = str[i + last];
+
+                    if ( ch == pattern[last] && equal( str + i, pattern, last ) )
+                        return i;
+
+                    i += shift[static_cast<unsigned char>( ch )];
+                }
+
+                return npos;
+            }
+
+            // NOTE: The mirror of \horspool, the window moves from the end and the shift is taken
+            // by its first character
+            [[nodiscard]] inline size_t reverse_horspool( const char* str,
+                                                          size_t      size,
+                                                          const char* pattern,
+                                                          size_t      pattern_size )
+            {
+                size_t shift[256];
+                for ( size_t& s : shift )
+                    s = pattern_size;
+
+                for ( size_t i = pattern_size - 1; i > 0; --i )
+                    shift[static_cast<unsigned char>( pattern[i] )] = i;
+
+                for ( size_t i = size - pattern_size;; )
+                {
+                    const char ch = str[i];
+
+                    if ( ch == pattern[0] && equal( str + i + 1, pattern + 1, pattern_size - 1 ) )
+                        return i;
+
+                    const size_t step = shift[static_cast<unsigned char>( ch )];
+                    if ( step > i )
+                        return npos;
+
+                    i -= step;
+                }
+            }
+        } // namespace search
+
+        // NOTE: 64 characters are checked per step, the block with a match is searched 16 at a time
+        size_t find( const char* str, size_t size, char ch )
+        {
+            const __m128i needle = _mm_set1_epi8( ch );
+
+            size_t i = 0;
+            for ( ; i + 64 <= size; i += 64 )
+                if ( search::match_any( str + i, needle ) )
+                    break;
+
+            for ( ; i + 16 <= size; i += 16 )
+                if ( const unsigned mask = search::match( str + i, needle ) )
+                    return i + search::lowest_bit( mask );
+
+            for ( ; i < size; ++i )
+                if ( str[i] == ch )
+                    return i;
+
+            return search::npos;
+        }
+
+        // NOTE: Positions whose first and last characters both match the pattern are found 16 at
+        // a time, only they are compared in full
+        size_t find( const char* str, size_t size, const char* pattern, size_t pattern_size )
+        {
+            if ( pattern_size == 0 )
+                return 0;
+
+            if ( pattern_size > size )
+                return search::npos;
+
+            if ( pattern_size == 1 )
+                return find( str, size, pattern[0] );
+
+            if ( pattern_size > search::long_pattern_size )
+                return search::horspool( str, size, pattern, pattern_size );
+
+            const size_t  last = pattern_size - 1;
+            const size_t  count = size - last;
+            const __m128i first_ch = _mm_set1_epi8( pattern[0] );
+            const __m128i last_ch = _mm_set1_epi8( pattern[last] );
+
+            size_t i = 0;
+            for ( ; i + 16 <= count; i += 16 )
+            {
+                unsigned mask = search::match( str + i, first_ch )
+                                & search::match( str + i + last, last_ch );
+
+                for ( ; mask; mask &= mask - 1 )
+                {
+                    const size_t index = i + search::lowest_bit( mask );
+
+                    if ( search::equal( str + index + 1, pattern + 1, last - 1 ) )
+                        return index;
+                }
+            }
+
+            for ( ; i < count; ++i )
+                if ( search::equal( str + i, pattern, pattern_size ) )
+                    return i;
+
+            return search::npos;
+        }
+
+        // NOTE: The mirror of \find
+        size_t rfind( const char* str, size_t size, char ch )
+        {
+            const __m128i needle = _mm_set1_epi8( ch );
+
+            size_t i = size;
+            for ( ; i >= 64; i -= 64 )
+                if ( search::match_any( str + i - 64, needle ) )
+                    break;
+
+            for ( ; i >= 16; i -= 16 )
+                if ( const unsigned mask = search::match( str + i - 16, needle ) )
+                    return i - 16 + search::highest_bit( mask );
+
+            while ( i-- > 0 )
+                if ( str[i] == ch )
+                    return i;
+
+            return search::npos;
+        }
+
+        // NOTE: The same filter as in \find, going from the end
+        size_t rfind( const char* str, size_t size, const char* pattern, size_t pattern_size )
+        {
+            if ( pattern_size == 0 )
+                return size;
+
+            if ( pattern_size > size )
+                return search::npos;
+
+            if ( pattern_size == 1 )
+                return rfind( str, size, pattern[0] );
+
+            if ( pattern_size > search::long_pattern_size )
+                return search::reverse_horspool( str, size, pattern, pattern_size );
+
+            const size_t  last = pattern_size - 1;
+            const __m128i first_ch = _mm_set1_epi8( pattern[0] );
+            const __m128i last_ch = _mm_set1_epi8( pattern[last] );
+
+            size_t i = size - last;
+            for ( ; i >= 16; i -= 16 )
+            {
+                const size_t block = i - 16;
+
+                unsigned mask = search::match( str + block, first_ch )
+                                & search::match( str + block + last, last_ch );
+
+                while ( mask )
+                {
+                    const size_t bit = search::highest_bit( mask );
+
+                    if ( search::equal( str + block + bit + 1, pattern + 1, last - 1 ) )
+                        return block + bit;
+
+                    mask &= ~( 1u << bit );
+                }
+            }
+
+            while ( i-- > 0 )
+                if ( search::equal( str + i, pattern, pattern_size ) )
+                    return i;
+
+            return search::npos;
+        }
+
+        size_t find_first_of( const char* str, size_t size, const char* chars, size_t chars_size )
+        {
+            if ( chars_size == 1 )
+                return find( str, size, chars[0] );
+
+            size_t i = 0;
+
+            // NOTE: Small sets, such as the separators, are matched 16 characters at a time by a
+            // comparison per character of the set
+            if ( chars_size <= search::small_set_size )
+            {
+                __m128i needles[search::small_set_size];
+                for ( size_t j = 0; j < chars_size; ++j )
+                    needles[j] = _mm_set1_epi8( chars[j] );
+
+                for ( ; i + 16 <= size; i += 16 )
+                {
+                    const __m128i block = search::load( str + i );
+                    __m128i       equal = _mm_setzero_si128();
+
+                    for ( size_t j = 0; j < chars_size; ++j )
+                        equal = _mm_or_si128( equal, _mm_cmpeq_epi8( block, needles[j] ) );
+
+                    if ( const unsigned mask = static_cast<unsigned>( _mm_movemask_epi8( equal ) ) )
+                        return i + search::lowest_bit( mask );
+                }
+            }
+
+            unsigned set[256 / 32] = {};
+            for ( size_t j = 0; j < chars_size; ++j )
+            {
+                const unsigned char ch = static_cast<unsigned char>( chars[j] );
+                set[ch / 32] |= 1u << ( ch % 32 );
+            }
+
+            for ( ; i < size; ++i )
+            {
+                const unsigned char ch = static_cast<unsigned char>( str[i] );
+                if ( set[ch / 32] & ( 1u << ( ch % 32 ) ) )
+                    return i;
+            }
+
+            return search::npos;
+        }
+    } // namespace impl
+} // namespace rtl
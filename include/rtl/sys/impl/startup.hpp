@@ -15,7 +15,9 @@
 #endif
 
 #include "chrono.hpp"
+#include "cpu.hpp"
 #include "heap.hpp"
+#include "jobs.hpp"
 #include "memory.hpp"
 #include "tests.hpp"
 #include "win.hpp"
@@ -31,6 +33,8 @@ extern void main( void );
 
 extern "C" void __stdcall rtl_entry_point( void )
 {
+    rtl::impl::g_cpu.init();
+
 #if RTL_ENABLE_CHRONO_CLOCK
     rtl::impl::g_performance_counter.init();
 #endif
@@ -39,10 +43,19 @@ extern "C" void __stdcall rtl_entry_point( void )
     rtl::impl::g_heap.init();
 #endif
 
+#if RTL_ENABLE_JOBS
+    rtl::impl::jobs::g_scheduler.init();
+#endif
+
 #if RTL_ENABLE_RUNTIME_TESTS
     rtl::impl::runtime_tests::run();
 #endif
 
     main();
+
+#if RTL_ENABLE_JOBS
+    rtl::impl::jobs::g_scheduler.shutdown();
+#endif
+
     ::ExitProcess( 0 );
 }
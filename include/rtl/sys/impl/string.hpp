@@ -14,34 +14,77 @@
     #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
 #endif
 
+#include <rtl/charconv.hpp>
 #include <rtl/string.hpp>
-#include <rtl/sys/printf.hpp>
+#include <rtl/utf.hpp>
+#include <rtl/sys/debug.hpp>
+
+#include "search.hpp"
+#include "win.hpp"
 
 namespace rtl
 {
     wstring to_wstring( int value )
     {
         wchar_t buffer[16];
-        wsprintf_s( buffer, "%i", value );
+        const auto result = to_chars( buffer, buffer + 16, value );
+        RTL_ASSERT( result.ec == errc::ok );
 
-        return wstring( buffer );
+        return wstring( wstring_view( buffer, static_cast<size_t>( result.ptr - buffer ) ) );
     }
 
     wstring to_wstring( unsigned value )
     {
         wchar_t buffer[16];
-        wsprintf_s( buffer, "%u", value );
+        const auto result = to_chars( buffer, buffer + 16, value );
+        RTL_ASSERT( result.ec == errc::ok );
 
-        return wstring( buffer );
+        return wstring( wstring_view( buffer, static_cast<size_t>( result.ptr - buffer ) ) );
+    }
+
+    wstring to_wstring( double value )
+    {
+        // NOTE: At most 24 characters, e.g. "-2.2250738585072014e-308"
+        wchar_t buffer[32];
+        const auto result = to_chars( buffer, buffer + 32, value );
+        RTL_ASSERT( result.ec == errc::ok );
+
+        return wstring( wstring_view( buffer, static_cast<size_t>( result.ptr - buffer ) ) );
     }
 
     wstring to_wstring( const rtl::string& string )
     {
-        rtl::vector<wchar_t> buffer( string.size() + 1 );
+        if ( string.empty() )
+            return wstring();
+
+        const int size = ::MultiByteToWideChar(
+            CP_ACP, 0, string.data(), static_cast<int>( string.size() ), nullptr, 0 );
+        RTL_WINAPI_CHECK( size != 0 );
+
+        wstring result( static_cast<size_t>( size ), default_init );
+
+        [[maybe_unused]] const int converted = ::MultiByteToWideChar(
+            CP_ACP, 0, string.data(), static_cast<int>( string.size() ), result.data(), size );
+        RTL_WINAPI_CHECK( converted == size );
+
+        return result;
+    }
+
+    wstring from_utf8( string_view string )
+    {
+        const char* first = string.data();
+        const char* last = first + string.size();
+
+        const auto length = utf16_length( first, last );
+        if ( length.ec != errc::ok )
+            return wstring();
+
+        wstring result( length.length, default_init );
 
-        // TODO: Remove %S hack and use explicit conversion
-        wsprintf_s( buffer.data(), buffer.size(), "%S", string.c_str() );
+        [[maybe_unused]] const auto converted
+            = utf8_to_utf16( first, last, result.data(), result.data() + length.length );
+        RTL_ASSERT( converted.ec == errc::ok );
 
-        return wstring( buffer.data() );
+        return result;
     }
 } // namespace rtl
@@ -14,11 +14,31 @@
     #error "Do not include implementation header directly, use <rtl/sys/impl.hpp>"
 #endif
 
+#include <rtl/algorithm.hpp>
+#include <rtl/atomic.hpp>
+#include <rtl/charconv.hpp>
+#include <rtl/flat_hash_map.hpp>
+#include <rtl/format.hpp>
+#include <rtl/functional.hpp>
+#include <rtl/hash.hpp>
 #include <rtl/math.hpp>
+#include <rtl/small_vector.hpp>
+#include <rtl/span.hpp>
+#include <rtl/spsc_ring.hpp>
 #include <rtl/string.hpp>
+#include <rtl/triple_buffer.hpp>
+#include <rtl/utf.hpp>
+#include <rtl/vector.hpp>
+#include <rtl/wav.hpp>
 
 #include <rtl/sys/debug.hpp>
 #include <rtl/sys/filesystem.hpp>
+#include <rtl/sys/jobs.hpp>
+
+#include "audio_queue.hpp"
+#include "heap.hpp"
+#include "jobs.hpp"
+#include "win.hpp"
 
 #if RTL_ENABLE_RUNTIME_TESTS
     #define RTL_TEST( expr ) rtl::impl::assert( expr, 0, #expr, __FILE__, __LINE__ )
@@ -47,6 +67,275 @@ namespace rtl
                 static_assert( pow_i( 2, -2 ) == 0 );
             } // namespace math
 
+            namespace algorithm
+            {
+                [[nodiscard]] constexpr int copy_and_fill()
+                {
+                    int src[4] = { 1, 2, 3, 4 };
+                    int dst[4] = {};
+
+                    rtl::copy_n( src, 4, dst );
+                    rtl::fill_n( src, 4, 5 );
+                    rtl::fill( dst, dst + 2, 6 );
+
+                    return src[3] + dst[1] + dst[2];
+                }
+
+                // NOTE: The bulk paths must not break the constant evaluation
+                static_assert( copy_and_fill() == 5 + 6 + 3 );
+
+                static_assert( rtl::impl::is_bitwise_copyable<const float*, float*> );
+                static_assert( !rtl::impl::is_bitwise_copyable<float*, int*> );
+                static_assert( rtl::impl::is_bitwise_fillable<bool*, bool> );
+                static_assert( !rtl::impl::is_bitwise_fillable<float*, int> );
+            } // namespace algorithm
+
+            namespace string
+            {
+                // NOTE: Partial match must not skip the next candidate
+                static_assert( rtl::string_view( "aaab" ).find( "aab" ) == 1 );
+                static_assert( rtl::string_view( "abab" ).rfind( "ab" ) == 2 );
+                static_assert( rtl::string_view( "abab" ).rfind( "ab", 1 ) == 0 );
+                static_assert( rtl::string_view( "abc" ).find( "" ) == 0 );
+                static_assert( rtl::string_view( "abc" ).find( "abcd" ) == rtl::string_view::npos );
+                static_assert( rtl::string_view( "abc" ).find( 'c' ) == 2 );
+                static_assert( rtl::string_view( "abc" ).find_first_of( "xcb" ) == 1 );
+                static_assert( rtl::wstring_view( L"aaab" ).find( L"aab" ) == 1 );
+            } // namespace string
+
+            namespace functional
+            {
+                static_assert( rtl::hash<rtl::string>()( "key" )
+                               == rtl::hash<rtl::string_view>()( rtl::string_view( "key" ) ) );
+                static_assert( rtl::hash<rtl::string>()( "key" )
+                               != rtl::hash<rtl::string>()( "kex" ) );
+                static_assert( rtl::hash<int>()( -1 ) == rtl::hash<unsigned>()( ~0u ) );
+                static_assert( rtl::equal_to<rtl::string>()( "key", rtl::string_view( "key" ) ) );
+            } // namespace functional
+
+            namespace hash
+            {
+                static_assert( rtl::fnv1a_32( "" ) == 0x811c9dc5u );
+                static_assert( rtl::fnv1a_32( "a" ) == 0xe40c292cu );
+                static_assert( rtl::fnv1a_64( "a" ) == 0xaf63dc4c8601ec8cull );
+
+                // NOTE: Keys of 1-3, 4-16, 17-48 and more bytes take different paths
+                static_assert( rtl::wyhash( "" ) != rtl::wyhash( rtl::string_view( "" ), 1 ) );
+                static_assert( rtl::wyhash( "ab" ) != rtl::wyhash( "ba" ) );
+                static_assert( rtl::wyhash( "resource" ) != rtl::wyhash( "resourcf" ) );
+                static_assert( rtl::wyhash( "kernels/blur.cl" )
+                               != rtl::wyhash( "kernels/blur.cm" ) );
+                static_assert( rtl::wyhash( "The quick brown fox jumps over the lazy dog" )
+                               != rtl::wyhash( "The quick brown fox jumps over the lazy cog" ) );
+            } // namespace hash
+
+            namespace atomic
+            {
+                static_assert( rtl::atomic<int>::is_always_lock_free );
+                static_assert( sizeof( rtl::atomic<char> ) == 1 );
+                static_assert( alignof( rtl::atomic<rtl::int64_t> ) == 8 );
+                static_assert(
+                    rtl::is_same<rtl::atomic<int*>::difference_type, rtl::ptrdiff_t>::value );
+            } // namespace atomic
+
+            namespace charconv
+            {
+                template<typename T>
+                [[nodiscard]] constexpr bool to_chars_equals( T value, int base, const char* str )
+                {
+                    char       buffer[72] = {};
+                    const auto result = rtl::to_chars( buffer, buffer + 72, value, base );
+
+                    return result.ec == rtl::errc::ok
+                           && rtl::string_view( buffer, static_cast<size_t>( result.ptr - buffer ) )
+                                  == str;
+                }
+
+                static_assert( to_chars_equals( 0, 10, "0" ) );
+                static_assert( to_chars_equals( -2147483647 - 1, 10, "-2147483648" ) );
+                static_assert( to_chars_equals( 4294967295u, 10, "4294967295" ) );
+                static_assert( to_chars_equals( 100000000ull, 10, "100000000" ) );
+                static_assert( to_chars_equals( ~0ull, 10, "18446744073709551615" ) );
+                static_assert(
+                    to_chars_equals( ~0x7FFFFFFFFFFFFFFFll, 10, "-9223372036854775808" ) );
+                static_assert( to_chars_equals( 255, 16, "ff" ) );
+                static_assert( to_chars_equals( -5, 2, "-101" ) );
+
+                // NOTE: Too small buffer
+                constexpr bool to_chars_overflows()
+                {
+                    char       buffer[2] = {};
+                    const auto result = rtl::to_chars( buffer, buffer + 2, 100 );
+
+                    return result.ec == rtl::errc::value_too_large && result.ptr == buffer + 2;
+                }
+
+                static_assert( to_chars_overflows() );
+
+                using rtl::impl::charconv::ryu::d2d;
+                using rtl::impl::charconv::ryu::f2d;
+
+                // NOTE: 0.1, 1.0, 5e-324, DBL_MAX
+                static_assert( d2d( 0x999999999999Au, 0x3FB ).mantissa == 1 );
+                static_assert( d2d( 0x999999999999Au, 0x3FB ).exponent == -1 );
+                static_assert( d2d( 0, 0x3FF ).mantissa == 1 && d2d( 0, 0x3FF ).exponent == 0 );
+                static_assert( d2d( 1, 0 ).mantissa == 5 && d2d( 1, 0 ).exponent == -324 );
+                static_assert( d2d( 0xFFFFFFFFFFFFFu, 0x7FE ).mantissa == 17976931348623157u );
+                static_assert( d2d( 0xFFFFFFFFFFFFFu, 0x7FE ).exponent == 292 );
+
+                // NOTE: 0.1f, 3.4028235e38f
+                static_assert( f2d( 0x4CCCCDu, 0x7B ).mantissa == 1 );
+                static_assert( f2d( 0x4CCCCDu, 0x7B ).exponent == -1 );
+                static_assert( f2d( 0x7FFFFFu, 0xFE ).mantissa == 34028235 );
+                static_assert( f2d( 0x7FFFFFu, 0xFE ).exponent == 31 );
+
+                template<typename T>
+                [[nodiscard]] constexpr bool
+                from_chars_equals( const char* str, int base, T expected )
+                {
+                    T          value = {};
+                    const auto result = rtl::from_chars( rtl::string_view( str ), value, base );
+
+                    return result.ec == rtl::errc::ok && value == expected && *result.ptr == 0;
+                }
+
+                static_assert( from_chars_equals( "0", 10, 0 ) );
+                static_assert( from_chars_equals( "-2147483648", 10, -2147483647 - 1 ) );
+                static_assert( from_chars_equals( "18446744073709551615", 10, ~0ull ) );
+                static_assert(
+                    from_chars_equals( "-9223372036854775808", 10, ~0x7FFFFFFFFFFFFFFFll ) );
+                static_assert( from_chars_equals( "fF", 16, 255u ) );
+                static_assert( from_chars_equals( "-101", 2, -5 ) );
+
+                // NOTE: Out of range, no digits, no minus sign for unsigned
+                constexpr bool from_chars_fails()
+                {
+                    int         value = 7;
+                    const char  str[] = "2147483648";
+                    const auto  out_of_range = rtl::from_chars( str, str + 10, value );
+                    unsigned    unsigned_value = 7;
+                    const char  negative[] = "-1";
+                    const auto  invalid = rtl::from_chars( negative, negative + 2, unsigned_value );
+
+                    return out_of_range.ec == rtl::errc::result_out_of_range
+                           && out_of_range.ptr == str + 10 && value == 7
+                           && invalid.ec == rtl::errc::invalid_argument && invalid.ptr == negative
+                           && unsigned_value == 7;
+                }
+
+                static_assert( from_chars_fails() );
+
+                using fix16 = rtl::fix<int, 16>;
+
+                [[nodiscard]] constexpr bool from_chars_equals( const char* str, int raw )
+                {
+                    fix16      value = fix16::from_raw( 0 );
+                    const auto result = rtl::from_chars( rtl::string_view( str ), value );
+
+                    return result.ec == rtl::errc::ok && value == fix16::from_raw( raw )
+                           && *result.ptr == 0;
+                }
+
+                // NOTE: 0.1 * 65536 = 6553.6, ties go to even
+                static_assert( from_chars_equals( "1.5", 0x18000 ) );
+                static_assert( from_chars_equals( "-0.1", -6554 ) );
+                static_assert( from_chars_equals( "0.0000076293945312", 0 ) );
+                static_assert( from_chars_equals( "0.0000228881835937500", 2 ) );
+                static_assert( from_chars_equals( "-32768", -2147483647 - 1 ) );
+                static_assert( from_chars_equals( "32767.99999", 2147483647 ) );
+            } // namespace charconv
+
+            namespace format
+            {
+                [[nodiscard]] constexpr bool format_to_fits()
+                {
+                    char        buffer[32] = {};
+                    const char* end = rtl::format_to(
+                        buffer, RTL_FMT_STRING( "{{{}}} {:x} {}" ), -12, 255u, "str" );
+
+                    return rtl::string_view( buffer ) == "{-12} ff str" && end == buffer + 12;
+                }
+
+                [[nodiscard]] constexpr bool format_to_truncates()
+                {
+                    char       buffer[4] = {};
+                    const auto result
+                        = rtl::format_to_n( buffer, 4, RTL_FMT_STRING( "{}{}" ), 123, true );
+
+                    return rtl::string_view( buffer, 4 ) == "123t" && result.size == 7;
+                }
+
+                static_assert( format_to_fits() );
+                static_assert( format_to_truncates() );
+            } // namespace format
+
+            namespace utf
+            {
+                // NOTE: "z", "ß", "水", "😀" take 1, 2, 3 and 4 bytes in UTF-8
+                constexpr char     utf8_text[] = "z\xC3\x9F\xE6\xB0\xB4\xF0\x9F\x98\x80";
+                constexpr char16_t utf16_text[] = u"z\u00DF\u6C34\U0001F600";
+
+                [[nodiscard]] constexpr bool utf8_to_utf16_converts()
+                {
+                    char16_t   buffer[8] = {};
+                    const auto result
+                        = rtl::utf8_to_utf16( utf8_text, utf8_text + 10, buffer, buffer + 8 );
+
+                    return result.ec == rtl::errc::ok && result.in == utf8_text + 10
+                           && result.out == buffer + 5
+                           && rtl::basic_string_view<char16_t>( buffer, 5 ) == utf16_text;
+                }
+
+                [[nodiscard]] constexpr bool utf16_to_utf8_converts()
+                {
+                    char       buffer[16] = {};
+                    const auto result
+                        = rtl::utf16_to_utf8( utf16_text, utf16_text + 5, buffer, buffer + 16 );
+
+                    return result.ec == rtl::errc::ok && result.out == buffer + 10
+                           && rtl::string_view( buffer, 10 ) == utf8_text;
+                }
+
+                [[nodiscard]] constexpr bool utf8_is_invalid( const char* str )
+                {
+                    const char* last = str;
+                    while ( *last )
+                        ++last;
+
+                    const auto result = rtl::utf16_length( str, last );
+                    return result.ec == rtl::errc::invalid_argument && result.in == str + 1;
+                }
+
+                [[nodiscard]] constexpr bool output_is_too_small()
+                {
+                    char16_t   buffer[4] = {};
+                    const auto result
+                        = rtl::utf8_to_utf16( utf8_text, utf8_text + 10, buffer, buffer + 4 );
+
+                    return result.ec == rtl::errc::value_too_large && result.in == utf8_text + 6
+                           && result.out == buffer + 3;
+                }
+
+                static_assert( utf8_to_utf16_converts() );
+                static_assert( utf16_to_utf8_converts() );
+                static_assert( output_is_too_small() );
+                static_assert( rtl::utf16_length( utf8_text, utf8_text + 10 ).length == 5 );
+                static_assert( rtl::utf8_length( utf16_text, utf16_text + 5 ).length == 10 );
+
+                // NOTE: Overlong, surrogate, above U+10FFFF, truncated, stray continuation
+                static_assert( utf8_is_invalid( "a\xC0\xAF" ) );
+                static_assert( utf8_is_invalid( "a\xE0\x80\xAF" ) );
+                static_assert( utf8_is_invalid( "a\xED\xA0\x80" ) );
+                static_assert( utf8_is_invalid( "a\xF4\x90\x80\x80" ) );
+                static_assert( utf8_is_invalid( "a\xE6\xB0" ) );
+                static_assert( utf8_is_invalid( "a\x80" ) );
+
+                // NOTE: Unpaired surrogates
+                static_assert( rtl::utf8_length( u"a\xD800", u"a\xD800" + 2 ).ec
+                               == rtl::errc::invalid_argument );
+                static_assert( rtl::utf8_length( u"\xDC00" u"a", u"\xDC00" u"a" + 2 ).ec
+                               == rtl::errc::invalid_argument );
+            } // namespace utf
         } // namespace static_tests
 
 #if RTL_ENABLE_RUNTIME_TESTS
@@ -64,13 +353,1172 @@ namespace rtl
                     RTL_TEST( s == "name.ext" );
                     RTL_TEST( s.size() == 8 );
                     RTL_TEST( s.rfind( ".ext" ) == 4 );
+                    RTL_TEST( s.find( 'e' ) == 3 );
+                    RTL_TEST( s.rfind( 'e' ) == 5 );
+                    RTL_TEST( s.find_first_of( "._" ) == 4 );
 
-                    rtl::string_view sext = s.substr( 4, rtl::string::npos );
+                    // NOTE: Runtime versions go through the SSE2 blocks and the scalar tails
+                    rtl::string text( 100, 'a' );
+                    text += "aab";
+                    text += rtl::string( 40, 'a' );
+                    RTL_TEST( text.find( "aab" ) == 100 );
+                    RTL_TEST( text.rfind( "aab" ) == 100 );
+                    RTL_TEST( text.find( 'b' ) == 102 );
+                    RTL_TEST( text.rfind( 'b' ) == 102 );
+                    RTL_TEST( text.find( "aab", 101 ) == rtl::string::npos );
+                    RTL_TEST( text.rfind( "ab" ) == 101 );
+                    RTL_TEST( text.rfind( "ba" ) == 102 );
+
+                    // NOTE: Long pattern takes the Horspool path
+                    rtl::string pattern( 40, 'a' );
+                    pattern += 'c';
+                    RTL_TEST( text.find( pattern ) == rtl::string::npos );
+                    RTL_TEST( ( pattern + text ).find( pattern ) == 0 );
+                    RTL_TEST( ( text + pattern ).find( pattern ) == text.size() );
+                    RTL_TEST( text.rfind( pattern ) == rtl::string::npos );
+                    RTL_TEST( ( pattern + text ).rfind( pattern ) == 0 );
+                    RTL_TEST( ( text + pattern + text ).rfind( pattern ) == text.size() );
+                    RTL_TEST( ( pattern + text + pattern ).rfind( pattern, text.size() )
+                              == 0 );
+
+                    rtl::string sext = s.substr( 4, rtl::string::npos );
                     RTL_TEST( sext.size() == 4 );
                     RTL_TEST( sext == ".ext" );
+
+                    rtl::string empty;
+                    RTL_TEST( empty.c_str()[0] == 0 );
+
+                    // NOTE: Capacity grows geometrically, so it changes only a few times
+                    rtl::string path;
+                    [[maybe_unused]] size_t reallocations = 0;
+
+                    for ( int i = 0; i < 1000; ++i )
+                    {
+                        const size_t capacity = path.capacity();
+                        path += "dir/";
+                        path += 'x';
+
+                        if ( path.capacity() != capacity )
+                            ++reallocations;
+                    }
+
+                    RTL_TEST( path.size() == 5000 );
+                    RTL_TEST( reallocations < 16 );
+                    RTL_TEST( path.c_str()[path.size()] == 0 );
+                    RTL_TEST( rtl::string_view( path.data() + 4995, 5 ) == "dir/x" );
+
+                    // NOTE: Appending a part of itself, with and without reallocation
+                    rtl::string self( "abc" );
+                    self.append( self );
+                    self.reserve( 64 );
+                    self.append( rtl::string_view( self.data() + 1, 2 ) );
+                    RTL_TEST( self == "abcabcbc" );
+                    RTL_TEST( self.capacity() >= 64 );
+
+                    rtl::string moved( rtl::move( self ) );
+                    RTL_TEST( moved == "abcabcbc" && self.empty() );
+
+                    self = moved + rtl::string_view( "!" );
+                    RTL_TEST( self == "abcabcbc!" );
+
+                    self.clear();
+                    self.append( 3, '-' );
+                    RTL_TEST( self == "---" );
                 }
             } // namespace string
 
+            namespace charconv
+            {
+                template<typename Char, typename T, typename... Format>
+                [[nodiscard]] bool to_chars_equals( T value, const Char* str, Format... format )
+                {
+                    Char       buffer[32] = {};
+                    const auto result = rtl::to_chars( buffer, buffer + 32, value, format... );
+
+                    return result.ec == rtl::errc::ok
+                           && rtl::basic_string_view<Char>(
+                                  buffer, static_cast<size_t>( result.ptr - buffer ) )
+                                  == str;
+                }
+
+                template<typename Char, typename T>
+                [[nodiscard]] bool from_chars_equals( const Char* str, T expected )
+                {
+                    T          value = {};
+                    const auto result
+                        = rtl::from_chars( rtl::basic_string_view<Char>( str ), value );
+
+                    // NOTE: Bitwise, to tell -0 from 0
+                    using bits_type =
+                        typename rtl::conditional<sizeof( T ) == 8, uint64_t, uint32_t>::type;
+
+                    bits_type value_bits = 0;
+                    bits_type expected_bits = 0;
+                    memcpy( &value_bits, &value, sizeof( T ) );
+                    memcpy( &expected_bits, &expected, sizeof( T ) );
+
+                    return result.ec == rtl::errc::ok && *result.ptr == 0
+                           && value_bits == expected_bits;
+                }
+
+                void run()
+                {
+                    RTL_TEST( to_chars_equals( 0.0, "0" ) );
+                    RTL_TEST( to_chars_equals( -0.0, "-0" ) );
+                    RTL_TEST( to_chars_equals( 0.3, "0.3" ) );
+                    RTL_TEST( to_chars_equals( 123456789.0, "123456789" ) );
+                    RTL_TEST( to_chars_equals( 1e22, "1e+22" ) );
+                    RTL_TEST( to_chars_equals( 1e-7, "1e-07" ) );
+                    RTL_TEST( to_chars_equals( 1234.5678, "1234.5678" ) );
+                    RTL_TEST( to_chars_equals( 5e-324, "5e-324" ) );
+                    RTL_TEST(
+                        to_chars_equals( 1.7976931348623157e308, "1.7976931348623157e+308" ) );
+                    RTL_TEST( to_chars_equals( 0.1f, "0.1" ) );
+                    RTL_TEST( to_chars_equals( 16777216.0f, "16777216" ) );
+                    RTL_TEST( to_chars_equals( 1e-45f, "1e-45" ) );
+                    RTL_TEST( to_chars_equals( -2.5, L"-2.5" ) );
+
+                    // NOTE: 1 / 0 and 0 / 0 without the compile time division by zero
+                    [[maybe_unused]] volatile double zero = 0.0;
+                    RTL_TEST( to_chars_equals( 1.0 / zero, "inf" ) );
+                    RTL_TEST( to_chars_equals( -1.0 / zero, "-inf" ) );
+                    RTL_TEST( to_chars_equals( zero / zero, "nan" )
+                              || to_chars_equals( zero / zero, "-nan" ) );
+
+                    [[maybe_unused]] constexpr auto fixed = rtl::chars_format::fixed;
+                    [[maybe_unused]] constexpr auto scientific = rtl::chars_format::scientific;
+                    RTL_TEST( to_chars_equals( 1e21, "1000000000000000000000", fixed ) );
+                    RTL_TEST( to_chars_equals( 0.001, "0.001", fixed ) );
+                    RTL_TEST( to_chars_equals( 100.0, "1e+02", scientific ) );
+                    RTL_TEST( to_chars_equals( 1.5f, "1.5e+00", scientific ) );
+
+                    [[maybe_unused]] char buffer[4] = {};
+                    RTL_TEST( rtl::to_chars( buffer, buffer + 4, 0.125 ).ec
+                              == rtl::errc::value_too_large );
+
+                    RTL_TEST( rtl::to_wstring( -42 ) == L"-42" );
+                    RTL_TEST( rtl::to_wstring( 4294967295u ) == L"4294967295" );
+                    RTL_TEST( rtl::to_wstring( 0.25 ) == L"0.25" );
+
+                    RTL_TEST( from_chars_equals( "0.1", 0.1 ) );
+                    RTL_TEST( from_chars_equals( "-0", -0.0 ) );
+                    RTL_TEST( from_chars_equals( "1234.5678e-3", 1.2345678 ) );
+                    RTL_TEST( from_chars_equals( "123456789012345678901", 1.2345678901234568e20 ) );
+                    RTL_TEST(
+                        from_chars_equals( "1.7976931348623157e308", 1.7976931348623157e308 ) );
+                    RTL_TEST( from_chars_equals( "4.9406564584124654e-324", 5e-324 ) );
+                    RTL_TEST(
+                        from_chars_equals( "2.2250738585072011e-308", 2.225073858507201e-308 ) );
+                    RTL_TEST( from_chars_equals( "3.4028235e38", 3.4028235e38f ) );
+                    RTL_TEST( from_chars_equals( L"-INFINITY", -1.0 / zero ) );
+
+                    // NOTE: Exactly halfway between 1 and the next double, and just above it
+                    RTL_TEST( from_chars_equals(
+                        "1.00000000000000011102230246251565404236316680908203125", 1.0 ) );
+                    RTL_TEST( from_chars_equals(
+                        "1.00000000000000011102230246251565404236316680908203126",
+                        1.0000000000000002 ) );
+
+                    [[maybe_unused]] double     value = 0.0;
+                    [[maybe_unused]] const char text[] = "1e309 5e-400 .e1 nan(x)";
+                    RTL_TEST( rtl::from_chars( text, text + 5, value ).ec
+                              == rtl::errc::result_out_of_range );
+                    RTL_TEST( rtl::from_chars( text + 6, text + 12, value ).ec
+                              == rtl::errc::result_out_of_range );
+                    RTL_TEST( rtl::from_chars( text + 13, text + 16, value ).ec
+                              == rtl::errc::invalid_argument );
+                    RTL_TEST( rtl::from_chars( text + 17, text + 23, value ).ptr == text + 23
+                              && value != value );
+                }
+            } // namespace charconv
+
+            namespace format
+            {
+                void run()
+                {
+                    [[maybe_unused]] wchar_t wide[32] = {};
+                    rtl::format_to( wide, RTL_FMT_STRING( L"{} {} {}" ), "narrow", L"wide", 0.5f );
+                    RTL_TEST( rtl::wstring_view( wide ) == L"narrow wide 0.5" );
+
+                    [[maybe_unused]] char narrow[8] = {};
+                    rtl::format_to( narrow, RTL_FMT_STRING( "{}: {}" ), rtl::string( "pi" ), 3.14 );
+                    RTL_TEST( rtl::string_view( narrow ) == "pi: 3.1" );
+                }
+            } // namespace format
+
+            namespace utf
+            {
+                void run()
+                {
+                    // NOTE: Long enough for the SSE2 blocks, with non-ASCII text in the middle of
+                    // a block and at the end
+                    rtl::string text( 40, 'a' );
+                    text += "\xD0\x96\xE6\xB0\xB4";
+                    text += rtl::string( 37, 'b' );
+                    text += "\xF0\x9F\x98\x80";
+
+                    const char* first = text.data();
+                    const char* last = first + text.size();
+
+                    [[maybe_unused]] const auto length = rtl::utf16_length( first, last );
+                    RTL_TEST( length.ec == rtl::errc::ok && length.length == 81 );
+
+                    [[maybe_unused]] wchar_t wide[81] = {};
+                    [[maybe_unused]] const auto wide_result
+                        = rtl::utf8_to_utf16( first, last, wide, wide + 81 );
+                    RTL_TEST( wide_result.ec == rtl::errc::ok && wide_result.out == wide + 81 );
+                    RTL_TEST( wide[39] == L'a' && wide[40] == 0x416 && wide[41] == 0x6C34 );
+                    RTL_TEST( wide[42] == L'b' && wide[79] == 0xD83D && wide[80] == 0xDE00 );
+
+                    [[maybe_unused]] char narrow[86] = {};
+                    [[maybe_unused]] const auto narrow_result
+                        = rtl::utf16_to_utf8( wide, wide + 81, narrow, narrow + 86 );
+                    RTL_TEST( narrow_result.ec == rtl::errc::ok
+                              && narrow_result.out == narrow + 86 );
+                    RTL_TEST( rtl::string_view( narrow, 86 ) == text );
+                    RTL_TEST( rtl::utf8_length( wide, wide + 81 ).length == 86 );
+
+                    text.data()[60] = '\xFF';
+                    RTL_TEST( rtl::utf16_length( text.data(), text.data() + text.size() ).in
+                              == text.data() + 60 );
+
+                    RTL_TEST( rtl::from_utf8( "\xD0\x96z" ) == L"\x0416z" );
+                    RTL_TEST( rtl::from_utf8( "\xD0z" ).empty() );
+                    RTL_TEST( rtl::to_wstring( rtl::string( "path" ) ) == L"path" );
+                    RTL_TEST( rtl::to_wstring( rtl::string() ).empty() );
+                }
+            } // namespace utf
+
+            namespace hash
+            {
+                void run()
+                {
+                    const char digits[] = "123456789";
+                    RTL_TEST( rtl::crc32c( digits, 9 ) == 0xe3069283u );
+                    RTL_TEST( rtl::crc32c( digits + 4, 5, rtl::crc32c( digits, 4 ) )
+                              == 0xe3069283u );
+                    RTL_TEST( rtl::crc32c( digits, 0 ) == 0 );
+
+                    // NOTE: Long buffers are split into interleaved streams
+                    rtl::vector<uint8_t> buffer( 20000, default_init );
+                    for ( size_t i = 0; i < buffer.size(); ++i )
+                        buffer[i] = static_cast<uint8_t>( i * 7 + ( i >> 8 ) );
+
+                    [[maybe_unused]] const uint32_t head = rtl::crc32c( buffer.data(), 12345 );
+                    RTL_TEST( rtl::crc32c( buffer.data() + 1, buffer.size() - 1 )
+                              == rtl::crc32c( buffer.data() + 1000,
+                                              buffer.size() - 1000,
+                                              rtl::crc32c( buffer.data() + 1, 999 ) ) );
+                    RTL_TEST( rtl::crc32c( buffer.data() + 12345, buffer.size() - 12345, head )
+                              == rtl::crc32c( buffer.data(), buffer.size() ) );
+
+                    RTL_TEST( rtl::xxhash64( "", 0 ) == 0xef46db3751d8e999ull );
+                    RTL_TEST( rtl::xxhash64( "abc", 3 ) == 0x44bc2cf5ad770999ull );
+
+                    for ( size_t i = 0; i < 100; ++i )
+                        buffer[i] = static_cast<uint8_t>( i );
+
+                    RTL_TEST( rtl::xxhash64( buffer.data(), 100 ) == 0x6ac1e58032166597ull );
+                    RTL_TEST( rtl::xxhash64( buffer.data(), 100, 42 ) == 0x819d2b726001d507ull );
+
+                    rtl::xxhash64_state state( 42 );
+                    for ( size_t i = 0; i < 100; i += 7 )
+                        state.update( buffer.data() + i, rtl::min<size_t>( 7, 100 - i ) );
+
+                    RTL_TEST( state.digest() == 0x819d2b726001d507ull );
+
+                    // NOTE: Runtime loads must give the same hash as the constant evaluation
+                    constexpr char     text[] = "The quick brown fox jumps over the lazy dog";
+                    constexpr uint64_t long_hash = rtl::wyhash( text );
+                    constexpr uint64_t short_hash = rtl::wyhash( rtl::string_view( text, 13 ), 7 );
+
+                    [[maybe_unused]] const rtl::string copy( text );
+                    RTL_TEST( rtl::wyhash( copy.data(), copy.size() ) == long_hash );
+                    RTL_TEST( rtl::wyhash( copy.data(), 13, 7 ) == short_hash );
+                }
+            } // namespace hash
+
+            namespace algorithm
+            {
+                void run()
+                {
+                    // NOTE: Sizes around the doubling steps of the pattern fill
+                    for ( size_t size = 0; size < 40; ++size )
+                    {
+                        int buffer[42];
+                        rtl::fill_n( buffer, 42, -1 );
+                        rtl::fill_n( buffer + 1, size, 0x12345678 );
+
+                        [[maybe_unused]] bool filled = buffer[0] == -1 && buffer[size + 1] == -1;
+                        for ( size_t i = 1; i <= size; ++i )
+                            filled = filled && buffer[i] == 0x12345678;
+
+                        RTL_TEST( filled );
+                    }
+
+                    // NOTE: Overlapping copy towards the beginning, as the element loop allows
+                    int values[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+                    rtl::copy_n( values + 2, 6, values );
+                    RTL_TEST( values[0] == 2 && values[5] == 7 && values[6] == 6 );
+                }
+            } // namespace algorithm
+
+            namespace vector
+            {
+                void run()
+                {
+                    rtl::vector<int> vi;
+                    for ( int i = 0; i < 100; ++i )
+                        vi.push_back( i );
+
+                    RTL_TEST( vi.size() == 100 );
+                    RTL_TEST( vi.capacity() >= 100 );
+                    RTL_TEST( vi.front() == 0 );
+                    RTL_TEST( vi.back() == 99 );
+
+                    vi.resize( 10 );
+                    RTL_TEST( vi.size() == 10 );
+                    vi.resize( 20 );
+                    RTL_TEST( vi[9] == 9 );
+                    RTL_TEST( vi[19] == 0 );
+
+                    rtl::vector<rtl::string> vs;
+                    for ( int i = 0; i < 20; ++i )
+                        vs.emplace_back( "name.ext" );
+
+                    vs.push_back( vs.front() );
+                    RTL_TEST( vs.size() == 21 );
+                    RTL_TEST( vs.back() == "name.ext" );
+
+                    rtl::vector<rtl::string> copy( vs );
+                    RTL_TEST( copy.size() == vs.size() );
+                    RTL_TEST( copy[10] == "name.ext" );
+
+                    vs.pop_back();
+                    vs.clear();
+                    RTL_TEST( vs.empty() );
+
+                    using arena_type = rtl::allocators::grow_only<int, 64>;
+                    using arena_ref = rtl::allocators::reference<arena_type>;
+
+                    arena_type                  arena;
+                    rtl::vector<int, arena_ref> va{ arena_ref( arena ) };
+                    for ( int i = 0; i < 16; ++i )
+                        va.push_back( i );
+
+                    RTL_TEST( va.size() == 16 );
+                    RTL_TEST( va[15] == 15 );
+                    RTL_TEST( va.get_allocator() == arena_ref( arena ) );
+                }
+            } // namespace vector
+
+            namespace small_vector
+            {
+                void run()
+                {
+                    rtl::small_vector<rtl::string, 4> vs;
+                    for ( int i = 0; i < 4; ++i )
+                        vs.emplace_back( "name.ext" );
+
+                    RTL_TEST( vs.is_inline() );
+
+                    rtl::small_vector<rtl::string, 4> moved( rtl::move( vs ) );
+                    RTL_TEST( vs.empty() );
+                    RTL_TEST( moved.size() == 4 );
+                    RTL_TEST( moved.is_inline() );
+
+                    moved.push_back( moved.front() );
+                    RTL_TEST( !moved.is_inline() );
+                    RTL_TEST( moved.size() == 5 );
+                    RTL_TEST( moved.back() == "name.ext" );
+
+                    vs = moved;
+                    RTL_TEST( vs.size() == 5 );
+                    RTL_TEST( vs[4] == "name.ext" );
+
+                    vs.resize( 2 );
+                    RTL_TEST( vs.size() == 2 );
+                }
+            } // namespace small_vector
+
+            namespace flat_hash_map
+            {
+                void run()
+                {
+                    rtl::flat_hash_map<int, int> map;
+                    RTL_TEST( map.capacity() == 0 );
+                    RTL_TEST( map.begin() == map.end() );
+                    RTL_TEST( map.find( 1 ) == map.end() );
+
+                    for ( int i = 0; i < 1000; ++i )
+                        map[i * 7] = i;
+
+                    RTL_TEST( map.size() == 1000 );
+                    RTL_TEST( !map.try_emplace( 14, 0 ).second );
+                    RTL_TEST( map.find( 14 )->second == 2 );
+                    RTL_TEST( !map.contains( 15 ) );
+
+                    // NOTE: Erase every other element, then reuse the deleted slots
+                    for ( int i = 0; i < 1000; i += 2 )
+                        RTL_TEST( map.erase( i * 7 ) == 1 );
+
+                    RTL_TEST( map.erase( 0 ) == 0 );
+                    RTL_TEST( map.size() == 500 );
+
+                    for ( int i = 0; i < 1000; i += 2 )
+                        RTL_TEST( map.insert( { i * 7 + 1, i } ).second );
+
+                    size_t count = 0;
+                    for ( const auto& item : map )
+                    {
+                        RTL_TEST( item.first % 7 == 0 ? item.first == item.second * 7
+                                                      : item.first == item.second * 7 + 1 );
+                        ++count;
+                    }
+
+                    RTL_TEST( count == 1000 );
+
+                    rtl::flat_hash_map<int, int> copy( map );
+                    RTL_TEST( copy.size() == 1000 );
+                    RTL_TEST( copy.find( 7 )->second == 1 );
+
+                    for ( auto it = copy.begin(); it != copy.end(); ++it )
+                        copy.erase( it );
+
+                    RTL_TEST( copy.empty() );
+                    RTL_TEST( copy.begin() == copy.end() );
+
+                    // NOTE: String keys are looked up by views and literals
+                    rtl::flat_hash_map<rtl::string, int> names;
+                    names["kernel"] = 1;
+                    names[rtl::string( "resource" )] = 2;
+                    names[rtl::string_view( "blur" )] = 3;
+
+                    RTL_TEST( names.size() == 3 );
+                    RTL_TEST( names.find( rtl::string_view( "blur" ) )->second == 3 );
+                    RTL_TEST( names.contains( "resource" ) );
+                    RTL_TEST( names.erase( "kernel" ) == 1 );
+                    RTL_TEST( names.find( "kernel" ) == names.end() );
+
+                    rtl::flat_hash_map<rtl::string, int> moved( rtl::move( names ) );
+                    RTL_TEST( names.empty() );
+                    RTL_TEST( moved.size() == 2 );
+
+                    rtl::flat_hash_set<rtl::string> strings;
+                    RTL_TEST( strings.insert( "name.ext" ).second );
+                    RTL_TEST( !strings.insert( rtl::string_view( "name.ext" ) ).second );
+                    RTL_TEST( strings.size() == 1 );
+                    RTL_TEST( *strings.find( "name.ext" ) == "name.ext" );
+
+                    using arena_allocator = rtl::allocators::monotonic<int>;
+                    using arena_set = rtl::
+                        flat_hash_set<int, rtl::hash<int>, rtl::equal_to<int>, arena_allocator>;
+
+                    rtl::allocators::monotonic_buffer arena;
+                    arena_set                         set{ arena_allocator( arena ) };
+
+                    set.reserve( 100 );
+                    [[maybe_unused]] const size_t capacity = set.capacity();
+
+                    for ( int i = 0; i < 100; ++i )
+                        set.insert( i );
+
+                    RTL_TEST( set.capacity() == capacity );
+                    RTL_TEST( set.contains( 99 ) );
+                }
+            } // namespace flat_hash_map
+
+            namespace atomic
+            {
+                // NOTE: Threads hammer the same variables with every kind of the read-modify-write
+                // operations. A lost update shows in the totals, a torn 64-bit access in the
+                // halves of \wide, which are always equal.
+                struct contention
+                {
+                    static constexpr int thread_count = 4;
+                    static constexpr int iterations = 20000;
+
+                    rtl::atomic<int>           counter;
+                    rtl::atomic<int>           cas_counter;
+                    rtl::atomic<rtl::uint64_t> wide;
+                    rtl::atomic<int>           lock;
+                    rtl::atomic<int>           torn;
+                    int                        guarded{ 0 };
+
+                    static DWORD WINAPI proc( void* context )
+                    {
+                        contention& self = *static_cast<contention*>( context );
+
+                        for ( int i = 0; i < iterations; ++i )
+                        {
+                            self.counter.fetch_add( 1, rtl::memory_order_relaxed );
+
+                            int expected = self.cas_counter.load( rtl::memory_order_relaxed );
+                            while ( !self.cas_counter.compare_exchange_weak( expected,
+                                                                             expected + 1 ) )
+                                ;
+
+                            self.wide.fetch_add( 0x100000001ull );
+
+                            const rtl::uint64_t seen = self.wide.load( rtl::memory_order_acquire );
+                            if ( ( seen >> 32 ) != ( seen & 0xffffffffu ) )
+                                self.torn.fetch_add( 1, rtl::memory_order_relaxed );
+
+                            // NOTE: The plain counter is only consistent if the acquire and the
+                            // release of the lock order the accesses
+                            while ( self.lock.exchange( 1, rtl::memory_order_acquire ) != 0 )
+                                rtl::cpu_relax();
+
+                            ++self.guarded;
+                            self.lock.store( 0, rtl::memory_order_release );
+                        }
+
+                        return 0;
+                    }
+
+                    void run()
+                    {
+                        HANDLE threads[thread_count];
+
+                        for ( HANDLE& thread : threads )
+                        {
+                            thread = ::CreateThread( nullptr, 0, &proc, this, 0, nullptr );
+                            RTL_TEST( thread != nullptr );
+                        }
+
+                        for ( HANDLE thread : threads )
+                        {
+                            ::WaitForSingleObject( thread, INFINITE );
+                            ::CloseHandle( thread );
+                        }
+
+                        constexpr int total = thread_count * iterations;
+
+                        RTL_TEST( counter == total );
+                        RTL_TEST( cas_counter == total );
+                        RTL_TEST( wide == 0x100000001ull * static_cast<rtl::uint64_t>( total ) );
+                        RTL_TEST( torn == 0 );
+                        RTL_TEST( guarded == total );
+                    }
+                };
+
+                void run()
+                {
+                    rtl::atomic<int> value( 5 );
+                    RTL_TEST( value.load( rtl::memory_order_relaxed ) == 5 );
+                    RTL_TEST( value.exchange( 7 ) == 5 );
+                    RTL_TEST( value.fetch_add( 3, rtl::memory_order_acq_rel ) == 7 );
+                    RTL_TEST( value.fetch_sub( 20 ) == 10 && value == -10 );
+                    RTL_TEST( ++value == -9 && value-- == -9 && ( value += 4 ) == -6 );
+
+                    int expected = 0;
+                    RTL_TEST( !value.compare_exchange_strong( expected, 1 ) && expected == -6 );
+                    RTL_TEST( value.compare_exchange_strong( expected, 1 ) && value == 1 );
+
+                    while ( !value.compare_exchange_weak( expected, 2, rtl::memory_order_release ) )
+                        ;
+                    RTL_TEST( value.load( rtl::memory_order_acquire ) == 2 );
+
+                    // NOTE: Unsigned and narrow values wrap around
+                    rtl::atomic<rtl::uint8_t> byte( 250 );
+                    RTL_TEST( byte.fetch_add( 10 ) == 250 && byte == 4 );
+                    RTL_TEST( byte.fetch_sub( 5 ) == 4 && byte == 255 );
+
+                    rtl::atomic<rtl::uint64_t> wide( 0xffffffffull );
+                    RTL_TEST( ++wide == 0x100000000ull );
+                    RTL_TEST( wide.exchange( 1ull << 63 ) == 0x100000000ull );
+
+                    rtl::uint64_t wide_expected = 1ull << 63;
+                    RTL_TEST( wide.compare_exchange_strong( wide_expected, 3 ) && wide == 3 );
+
+                    // NOTE: Pointers move by elements
+                    int               items[4] = {};
+                    rtl::atomic<int*> cursor( items );
+                    RTL_TEST( cursor.fetch_add( 3 ) == items && cursor == items + 3 );
+                    RTL_TEST( --cursor == items + 2 );
+
+                    rtl::atomic_thread_fence( rtl::memory_order_seq_cst );
+                    rtl::atomic_thread_fence( rtl::memory_order_acquire );
+                    rtl::cpu_relax();
+
+                    static contention shared;
+                    shared.run();
+                }
+            } // namespace atomic
+
+            namespace spsc_ring
+            {
+                void run()
+                {
+                    rtl::spsc_ring<int, 8> ring;
+                    RTL_TEST( ring.empty() );
+
+                    int value = 0;
+                    RTL_TEST( !ring.try_pop( value ) );
+
+                    for ( int i = 0; i < 8; ++i )
+                        RTL_TEST( ring.try_push( i ) );
+
+                    RTL_TEST( !ring.try_push( 8 ) );
+                    RTL_TEST( ring.size() == 8 );
+                    RTL_TEST( ring.try_pop( value ) && value == 0 );
+
+                    // NOTE: The free slots wrap around, so the bulk copy goes in two parts
+                    int values[8] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+                    RTL_TEST( ring.push_n( values, 8 ) == 1 );
+
+                    int popped[8] = {};
+                    RTL_TEST( ring.pop_n( popped, 8 ) == 8 );
+                    RTL_TEST( popped[0] == 1 && popped[6] == 7 && popped[7] == 10 );
+                    RTL_TEST( ring.empty() );
+
+                    RTL_TEST( ring.push_n( values, 6 ) == 6 );
+                    RTL_TEST( ring.pop_n( popped, 6 ) == 6 && popped[5] == 15 );
+
+                    // NOTE: Both indices are at 15 now, so only one slot follows in memory
+                    rtl::span<int> slots = ring.write_span();
+                    RTL_TEST( slots.size() == 1 );
+                    slots[0] = 20;
+                    ring.commit_write( 1 );
+
+                    slots = ring.write_span( 4 );
+                    RTL_TEST( slots.size() == 4 );
+                    for ( size_t i = 0; i < slots.size(); ++i )
+                        slots[i] = 21 + static_cast<int>( i );
+                    ring.commit_write( 4 );
+
+                    rtl::span<const int> items = ring.read_span();
+                    RTL_TEST( items.size() == 1 && items[0] == 20 );
+                    ring.commit_read( 1 );
+
+                    items = ring.read_span();
+                    RTL_TEST( items.size() == 4 && items[3] == 24 );
+                    ring.commit_read( items.size() );
+                    RTL_TEST( ring.read_span().empty() );
+
+                    rtl::uint8_t data[56];
+                    for ( size_t i = 0; i < 56; ++i )
+                        data[i] = static_cast<rtl::uint8_t>( i );
+
+                    rtl::spsc_byte_ring<64> bytes;
+                    RTL_TEST( bytes.front().data() == nullptr );
+                    RTL_TEST( !bytes.push( data, 57 ) );
+
+                    RTL_TEST( bytes.push( "abc", 3 ) );
+                    RTL_TEST( bytes.push( "", 0 ) );
+                    RTL_TEST( bytes.push( data, 20 ) );
+                    RTL_TEST( !bytes.push( data, 20 ) );
+
+                    rtl::span<const rtl::uint8_t> record = bytes.front();
+                    RTL_TEST( record.size() == 3 && record[2] == 'c' );
+                    bytes.pop();
+
+                    record = bytes.front();
+                    RTL_TEST( record.data() != nullptr && record.empty() );
+                    bytes.pop();
+
+                    // NOTE: The failed push has left a wrap marker at the end of the buffer, so
+                    // the record goes to the beginning, which is free now
+                    rtl::span<rtl::uint8_t> payload = bytes.begin_write( 16 );
+                    RTL_TEST( payload.size() == 16 );
+                    rtl::fill_n( payload.data(), payload.size(), rtl::uint8_t( 0x5a ) );
+                    bytes.commit_write();
+
+                    record = bytes.front();
+                    RTL_TEST( record.size() == 20 && record[0] == 0 && record[19] == 19 );
+                    bytes.pop();
+
+                    record = bytes.front();
+                    RTL_TEST( record.size() == 16 && record[0] == 0x5a && record[15] == 0x5a );
+                    bytes.pop();
+
+                    // NOTE: The largest record fits only after the consumer skips the marker
+                    RTL_TEST( bytes.front().data() == nullptr );
+                    RTL_TEST( !bytes.push( data, bytes.max_record_size() ) );
+                    RTL_TEST( bytes.front().data() == nullptr );
+                    RTL_TEST( bytes.push( data, bytes.max_record_size() ) );
+
+                    record = bytes.front();
+                    RTL_TEST( record.size() == 56 && record[55] == 55 );
+                    bytes.pop();
+                }
+            } // namespace spsc_ring
+
+            namespace triple_buffer
+            {
+                void run()
+                {
+                    rtl::triple_buffer<int> buffer;
+                    RTL_TEST( !buffer.update() );
+                    RTL_TEST( buffer.read_buffer() == 0 );
+
+                    // NOTE: The reader gets the latest value only
+                    buffer.write_buffer() = 1;
+                    buffer.publish();
+                    buffer.write_buffer() = 2;
+                    buffer.publish();
+                    RTL_TEST( buffer.update() && buffer.read_buffer() == 2 );
+                    RTL_TEST( !buffer.update() && buffer.read_buffer() == 2 );
+
+                    // NOTE: The writer goes on while the reader holds its value
+                    for ( int i = 3; i < 10; ++i )
+                    {
+                        buffer.write_buffer() = i;
+                        buffer.publish();
+                        RTL_TEST( buffer.read_buffer() == 2 );
+                    }
+
+                    RTL_TEST( buffer.update() && buffer.read_buffer() == 9 );
+                    RTL_TEST( !buffer.update() );
+                }
+            } // namespace triple_buffer
+
+            namespace wav
+            {
+                void run()
+                {
+                    uint8_t header[rtl::wav::max_header_size];
+
+                    rtl::wav::write_header( header, rtl::wav::format::pcm16, 2, 48000, 8 );
+                    RTL_TEST( header[0] == 'R' && header[3] == 'F' && header[8] == 'W' );
+                    RTL_TEST( header[4] == 44 && header[5] == 0 );
+                    RTL_TEST( header[12] == 'f' && header[16] == 16 );
+                    RTL_TEST( header[20] == 1 && header[22] == 2 );
+
+                    // NOTE: 48000 is 0xbb80 and 4 bytes per sample make 0x2ee00 bytes per second
+                    RTL_TEST( header[24] == 0x80 && header[25] == 0xbb && header[26] == 0 );
+                    RTL_TEST( header[28] == 0 && header[29] == 0xee && header[30] == 0x02 );
+                    RTL_TEST( header[32] == 4 && header[34] == 16 );
+                    RTL_TEST( header[36] == 'd' && header[40] == 8 && header[41] == 0 );
+
+                    // NOTE: The float format has the 18-byte format chunk and the fact chunk
+                    rtl::wav::write_header( header, rtl::wav::format::float32, 2, 48000, 16 );
+                    RTL_TEST( header[4] == 66 && header[16] == 18 && header[20] == 3 );
+                    RTL_TEST( header[32] == 8 && header[34] == 32 && header[36] == 0 );
+                    RTL_TEST( header[38] == 'f' && header[41] == 't' && header[42] == 4 );
+                    RTL_TEST( header[46] == 2 && header[47] == 0 );
+                    RTL_TEST( header[50] == 'd' && header[54] == 16 );
+
+                    const int16_t samples[2] = { -32768, 16384 };
+
+                    uint8_t pcm[4];
+                    rtl::wav::encode( samples, 2, rtl::wav::format::pcm16, pcm );
+                    RTL_TEST( pcm[0] == 0 && pcm[1] == 0x80 && pcm[2] == 0 && pcm[3] == 0x40 );
+
+                    // NOTE: -1.0f is 0xbf800000, 0.5f is 0x3f000000
+                    uint8_t ieee[8];
+                    rtl::wav::encode( samples, 2, rtl::wav::format::float32, ieee );
+                    RTL_TEST( ieee[0] == 0 && ieee[2] == 0x80 && ieee[3] == 0xbf );
+                    RTL_TEST( ieee[4] == 0 && ieee[6] == 0 && ieee[7] == 0x3f );
+                }
+            } // namespace wav
+
+            namespace audio_queue
+            {
+                using action = rtl::impl::audio_queue::action;
+
+                // NOTE: Simulates a frame period: the device returns a buffer, the audio thread
+                // fills the free ones, and the app commits as many frames as it is asked for,
+                // unless it is late. Returns the latency in frames.
+                uint32_t step( rtl::impl::audio_queue& queue, size_t& ring, bool late )
+                {
+                    if ( queue.in_flight() > 0 )
+                        queue.returned();
+
+                    for ( action a = queue.next( ring ); a != action::wait; a = queue.next( ring ) )
+                    {
+                        if ( a == action::submit_frame )
+                            --ring;
+                    }
+
+                    while ( !late && queue.wants_frame( ring ) )
+                        ++ring;
+
+                    return queue.in_flight() + static_cast<uint32_t>( ring );
+                }
+
+                void run()
+                {
+                    constexpr uint32_t frames_per_second = 10;
+
+                    {
+                        rtl::impl::audio_queue queue;
+                        queue.init( 8, frames_per_second, 0 );
+                        RTL_TEST( queue.limit() == 8 );
+
+                        size_t ring = 0;
+                        for ( uint32_t i = 0; i < 100; ++i )
+                            step( queue, ring, false );
+
+                        RTL_TEST( queue.underruns() == 0 );
+                        RTL_TEST( step( queue, ring, false ) == 8 + 1 );
+                    }
+
+                    // NOTE: One underrun per 10 seconds is allowed
+                    rtl::impl::audio_queue queue;
+                    queue.init( 8, frames_per_second, 6 );
+                    RTL_TEST( queue.limit() == rtl::impl::audio_queue::min_frames );
+
+                    size_t ring = 0;
+
+                    // NOTE: The app misses every third frame for 5 seconds, so the queue grows
+                    // until a late frame is covered by the buffers in flight
+                    for ( uint32_t i = 0; i < 5 * frames_per_second; ++i )
+                        step( queue, ring, i % 3 == 0 );
+
+                    const uint32_t grown_limit = queue.limit();
+                    RTL_TEST( queue.underruns() > 0 );
+                    RTL_TEST( grown_limit > rtl::impl::audio_queue::min_frames );
+                    RTL_TEST( grown_limit <= 8 );
+
+                    const uint32_t grown_latency = step( queue, ring, false );
+                    RTL_TEST( grown_latency == grown_limit + 1 );
+
+                    // NOTE: The app keeps up for 2 minutes, so the latency goes down to the minimum
+                    const uint32_t underruns = queue.underruns();
+
+                    uint32_t latency = 0;
+                    for ( uint32_t i = 0; i < 120 * frames_per_second; ++i )
+                        latency = step( queue, ring, false );
+
+                    RTL_TEST( queue.underruns() == underruns );
+                    RTL_TEST( queue.limit() == rtl::impl::audio_queue::min_frames );
+                    RTL_TEST( latency == rtl::impl::audio_queue::min_frames + 1 );
+                    RTL_TEST( latency < grown_latency );
+                }
+            } // namespace audio_queue
+
+            namespace allocators
+            {
+                void run()
+                {
+                    rtl::allocators::monotonic_buffer arena( 64 );
+
+                    for ( int cycle = 0; cycle < 2; ++cycle )
+                    {
+                        rtl::vector<int, rtl::allocators::monotonic<int>> v{
+                            rtl::allocators::monotonic<int>( arena ) };
+
+                        for ( int i = 0; i < 100; ++i )
+                            v.push_back( i );
+
+                        RTL_TEST( v[99] == 99 );
+
+                        [[maybe_unused]] void* p = arena.allocate( 3, 16 );
+                        RTL_TEST( ( reinterpret_cast<size_t>( p ) & 15 ) == 0 );
+
+                        arena.reset();
+                    }
+
+                    RTL_TEST( arena.capacity() >= 100 * sizeof( int ) );
+
+                    arena.release();
+                    RTL_TEST( arena.capacity() == 0 );
+
+                    struct alignas( 64 ) cache_line
+                    {
+                        uint8_t data[64];
+                    };
+
+                    rtl::vector<cache_line> lines( 3 );
+                    RTL_TEST( ( reinterpret_cast<size_t>( lines.data() ) & 63 ) == 0 );
+
+                    auto line_array = rtl::make_unique<cache_line[]>( 3 );
+                    RTL_TEST( ( reinterpret_cast<size_t>( line_array.get() ) & 63 ) == 0 );
+
+                    rtl::vector<int16_t, rtl::allocators::aligned<int16_t, 32>> samples( 5 );
+                    RTL_TEST( ( reinterpret_cast<size_t>( samples.data() ) & 31 ) == 0 );
+                }
+            } // namespace allocators
+
+    #if RTL_ENABLE_HEAP
+            namespace heap
+            {
+                void run()
+                {
+                    // NOTE: The sizes that wrap around must not give a short block
+                    constexpr size_t max_size = ~size_t( 0 );
+
+                    RTL_TEST( rtl::calloc( max_size / 2 + 1, 2 ) == nullptr );
+                    RTL_TEST( rtl::calloc( 2, max_size / 2 + 1 ) == nullptr );
+                    RTL_TEST( rtl::impl::g_heap.aligned_malloc( max_size - 8, 64 ) == nullptr );
+
+                    void* block = rtl::calloc( 0, max_size );
+                    rtl::free( block );
+
+                    block = rtl::impl::g_heap.aligned_malloc( 100, 64 );
+                    RTL_TEST( block && ( reinterpret_cast<size_t>( block ) & 63 ) == 0 );
+                    rtl::impl::g_heap.aligned_free( block );
+                }
+            } // namespace heap
+    #endif
+
+    #if RTL_ENABLE_HEAP_POOLS
+            namespace heap_pools
+            {
+                void run()
+                {
+                    constexpr size_t sizes[] = { 1, 16, 17, 100, 129, 1000, 4096, 4097, 10000 };
+
+                    for ( size_t size : sizes )
+                    {
+                        RTL_TEST( size > impl::heap_pools::max_block_size
+                                  || impl::heap_pools::block_size( size ) >= size );
+
+                        uint8_t* block = static_cast<uint8_t*>( rtl::malloc( size ) );
+                        rtl::fill_n( block, size, static_cast<uint8_t>( 0xcc ) );
+                        rtl::free( block );
+
+                        // NOTE: The same block is expected to be recycled, it must come zeroed
+                        block = static_cast<uint8_t*>( rtl::calloc( size, 1 ) );
+                        RTL_TEST( block[0] == 0 && block[size - 1] == 0 );
+                        rtl::free( block );
+                    }
+                }
+            } // namespace heap_pools
+    #endif
+
+    #if RTL_ENABLE_HEAP_STATS
+            namespace heap_stats
+            {
+                void run()
+                {
+                    // NOTE: The blocks may be larger than requested, the histogram counts the
+                    // requested sizes
+                    rtl::impl::heap_counters counters;
+                    counters.on_allocate( 1, 16 );
+                    counters.on_allocate( 16, 16 );
+                    counters.on_allocate( 17, 32 );
+                    counters.on_allocate( 100, 112 );
+                    counters.on_allocate( 5000, 5008 );
+                    counters.on_allocate( 1 << 20, 1 << 20 );
+                    counters.on_free( 32 );
+                    counters.on_free( 5008 );
+
+                    constexpr size_t allocated = 16 + 16 + 32 + 112 + 5008 + ( 1 << 20 );
+                    constexpr size_t live = allocated - 32 - 5008;
+
+                    const rtl::heap_statistics stats = counters.snapshot();
+                    RTL_TEST( stats.allocations == 6 );
+                    RTL_TEST( stats.frees == 2 );
+                    RTL_TEST( stats.allocated_bytes == allocated );
+                    RTL_TEST( stats.live_bytes == live );
+                    RTL_TEST( stats.peak_bytes == allocated );
+
+                    constexpr size_t histogram[rtl::heap_statistics::histogram_size]
+                        = { 2, 1, 0, 1, 0, 0, 0, 0, 0, 1, 0, 1 };
+
+                    for ( size_t i = 0; i < rtl::heap_statistics::histogram_size; ++i )
+                        RTL_TEST( stats.histogram[i] == histogram[i] );
+
+                    RTL_TEST( counters.exchange_frame_peak() == allocated );
+                    RTL_TEST( counters.exchange_frame_peak() == live );
+
+                    // NOTE: The byte counters must not wrap around at 2 or 4 GB of the traffic
+                    constexpr size_t   huge_block = size_t( 1 ) << 30;
+                    constexpr uint32_t huge_blocks = 5;
+
+                    for ( uint32_t i = 0; i < huge_blocks; ++i )
+                        counters.on_allocate( huge_block, huge_block );
+
+                    const rtl::heap_statistics huge = counters.snapshot();
+
+                    for ( uint32_t i = 0; i < huge_blocks; ++i )
+                        counters.on_free( huge_block );
+
+                    constexpr uint64_t huge_bytes = uint64_t( huge_block ) * huge_blocks;
+
+                    RTL_TEST( huge.allocated_bytes == allocated + huge_bytes );
+                    RTL_TEST( huge.live_bytes == live + huge_bytes );
+                    RTL_TEST( huge.peak_bytes == live + huge_bytes );
+                    RTL_TEST( counters.exchange_frame_peak() == live + huge_bytes );
+                    RTL_TEST( counters.snapshot().live_bytes == live );
+
+                    // NOTE: The global heap counts the blocks of the allocator itself
+                    const rtl::heap_statistics before = rtl::get_heap_statistics();
+
+                    void* const blocks[]
+                        = { rtl::malloc( 8 ), rtl::malloc( 40 ), rtl::malloc( 3000 ) };
+
+                    const rtl::heap_statistics during = rtl::get_heap_statistics();
+
+                    for ( void* block : blocks )
+                        rtl::free( block );
+
+                    const rtl::heap_statistics after = rtl::get_heap_statistics();
+
+                    RTL_TEST( during.allocations - before.allocations == 3 );
+                    RTL_TEST( during.live_bytes - before.live_bytes >= 8 + 40 + 3000 );
+                    RTL_TEST( during.histogram[0] - before.histogram[0] == 1 );
+                    RTL_TEST( during.histogram[2] - before.histogram[2] == 1 );
+                    RTL_TEST( during.histogram[8] - before.histogram[8] == 1 );
+                    RTL_TEST( after.frees - before.frees == 3 );
+                    RTL_TEST( after.live_bytes == before.live_bytes );
+                    RTL_TEST( after.peak_bytes >= during.live_bytes );
+                }
+            } // namespace heap_stats
+    #endif
+
+    #if RTL_ENABLE_JOBS
+            namespace jobs
+            {
+                void run()
+                {
+                    constexpr size_t count = 10000;
+
+                    // NOTE: Every item must be visited exactly once, whatever the grain
+                    static uint8_t visits[count];
+
+                    constexpr size_t grains[] = { 1, 7, 64, count + 1 };
+
+                    for ( size_t grain : grains )
+                    {
+                        rtl::fill_n( visits, count, uint8_t( 0 ) );
+
+                        rtl::jobs::parallel_for( 0,
+                                                 count,
+                                                 grain,
+                                                 []( size_t first, size_t last )
+                                                 {
+                                                     for ( size_t i = first; i < last; ++i )
+                                                         ++visits[i];
+                                                 } );
+
+                        size_t visited_once = 0;
+                        for ( uint8_t v : visits )
+                            visited_once += v == 1;
+
+                        RTL_TEST( visited_once == count );
+                    }
+
+                    rtl::atomic<size_t> sum;
+                    rtl::jobs::parallel_for( 5, 5, 1, [&]( size_t, size_t ) { ++sum; } );
+                    RTL_TEST( sum == 0 );
+
+                    // NOTE: Nested loops run inside the jobs and wait for their own groups
+                    rtl::jobs::parallel_for( 0,
+                                             64,
+                                             1,
+                                             [&]( size_t outer, size_t )
+                                             {
+                                                 rtl::jobs::parallel_for(
+                                                     0,
+                                                     100,
+                                                     10,
+                                                     [&]( size_t first, size_t last )
+                                                     {
+                                                         for ( size_t i = first; i < last; ++i )
+                                                             sum += outer * 100 + i;
+                                                     } );
+                                             } );
+
+                    RTL_TEST( sum == 6400 * 6399 / 2 );
+
+                    rtl::atomic<int> done;
+                    auto             job = [&]() { ++done; };
+
+                    {
+                        rtl::jobs::task_group group;
+
+                        for ( int i = 0; i < 1000; ++i )
+                            group.run( job );
+                    }
+
+                    RTL_TEST( done == 1000 );
+
+                    // NOTE: More threads start jobs than there are external slots, the rest of
+                    // them run their jobs inline. The slots are free again when the groups end.
+                    struct external
+                    {
+                        static DWORD WINAPI proc( void* context )
+                        {
+                            auto& total = *static_cast<rtl::atomic<size_t>*>( context );
+
+                            for ( int round = 0; round < 10; ++round )
+                            {
+                                rtl::jobs::parallel_for( 0,
+                                                         1000,
+                                                         10,
+                                                         [&]( size_t first, size_t last )
+                                                         { total += last - first; } );
+                            }
+
+                            return 0;
+                        }
+                    };
+
+                    constexpr size_t thread_count = 8;
+
+                    HANDLE              threads[thread_count];
+                    rtl::atomic<size_t> total;
+
+                    for ( HANDLE& thread : threads )
+                        thread = rtl::impl::jobs::os::start_thread( &external::proc, &total );
+
+                    for ( HANDLE thread : threads )
+                        rtl::impl::jobs::os::join_thread( thread );
+
+                    RTL_TEST( total == thread_count * 10 * 1000 );
+                    RTL_TEST( rtl::impl::jobs::g_scheduler.external_slots_in_use() == 0 );
+                }
+            } // namespace jobs
+    #endif
+
+    #if RTL_ENABLE_MEMSET || RTL_ENABLE_MEMCPY
+            namespace memory
+            {
+                [[nodiscard]] uint8_t pattern( size_t index )
+                {
+                    return static_cast<uint8_t>( index * 7 + 3 );
+                }
+
+                void run()
+                {
+                    // NOTE: Every size class of the dispatch, each with the unaligned ends
+                    constexpr size_t sizes[]
+                        = { 0, 1, 3, 4, 9, 16, 31, 33, 100, 2047, 2049, 70000 };
+                    constexpr size_t margin = 64;
+
+                    rtl::vector<uint8_t> buffer( 70000 + margin * 2, rtl::default_init );
+
+                    for ( size_t size : sizes )
+                    {
+                        for ( size_t offset = 0; offset < 16; offset += 5 )
+                        {
+        #if RTL_ENABLE_MEMSET
+                            rtl::fill_n( buffer.data(), buffer.size(), static_cast<uint8_t>( 0 ) );
+                            memset( buffer.data() + offset + 1, 0xcc, size );
+
+                            RTL_TEST( buffer[offset] == 0 );
+                            RTL_TEST( size == 0 || buffer[offset + 1] == 0xcc );
+                            RTL_TEST( size == 0 || buffer[offset + size] == 0xcc );
+                            RTL_TEST( buffer[offset + size + 1] == 0 );
+        #endif
+        #if RTL_ENABLE_MEMCPY
+                            // NOTE: Overlapping moves in both directions
+                            for ( size_t src = offset; src <= offset + margin; src += margin )
+                            {
+                                const size_t dst = offset + margin - src + offset;
+
+                                for ( size_t i = 0; i < buffer.size(); ++i )
+                                    buffer[i] = pattern( i );
+
+                                memmove( buffer.data() + dst, buffer.data() + src, size );
+
+                                [[maybe_unused]] bool equal = true;
+                                for ( size_t i = 0; i < size; ++i )
+                                    equal = equal && buffer[dst + i] == pattern( src + i );
+
+                                RTL_TEST( equal );
+                                RTL_TEST( buffer[dst + size] == pattern( dst + size ) );
+                            }
+        #endif
+                        }
+                    }
+                }
+            } // namespace memory
+    #endif
+
             namespace filesystem
             {
                 void run()
@@ -89,6 +1537,35 @@ namespace rtl
             void run()
             {
                 string::run();
+                charconv::run();
+                format::run();
+                utf::run();
+                hash::run();
+                algorithm::run();
+                vector::run();
+                small_vector::run();
+                flat_hash_map::run();
+                atomic::run();
+                spsc_ring::run();
+                triple_buffer::run();
+                wav::run();
+                audio_queue::run();
+                allocators::run();
+    #if RTL_ENABLE_HEAP
+                heap::run();
+    #endif
+    #if RTL_ENABLE_HEAP_POOLS
+                heap_pools::run();
+    #endif
+    #if RTL_ENABLE_HEAP_STATS
+                heap_stats::run();
+    #endif
+    #if RTL_ENABLE_MEMSET || RTL_ENABLE_MEMCPY
+                memory::run();
+    #endif
+    #if RTL_ENABLE_JOBS
+                jobs::run();
+    #endif
                 filesystem::run();
             }
         } // namespace runtime_tests
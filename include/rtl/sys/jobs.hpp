@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/algorithm.hpp>
+#include <rtl/atomic.hpp>
+#include <rtl/int.hpp>
+
+#if RTL_ENABLE_JOBS
+
+namespace rtl
+{
+    namespace impl
+    {
+        namespace jobs
+        {
+            class scheduler;
+        } // namespace jobs
+    }     // namespace impl
+
+    namespace jobs
+    {
+        /// @brief Job entry point.
+        /// @param context Pointer passed along with the job.
+        using function = void ( * )( void* context );
+
+        /// @brief Number of threads that run the jobs.
+        /// The pool has a worker thread per logical CPU, except the one of the calling thread,
+        /// which runs the jobs while it waits for them.
+        size_t thread_count();
+
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        /// @brief Fork/join set of jobs.
+        /// Jobs started by a group go to the deque of the calling thread, from where idle workers
+        /// steal them. \p wait returns after all of them, including the nested ones, are done.
+        ////////////////////////////////////////////////////////////////////////////////////////////
+        class task_group final
+        {
+        public:
+            task_group() = default;
+            task_group( const task_group& ) = delete;
+            task_group& operator=( const task_group& ) = delete;
+
+            ~task_group()
+            {
+                wait();
+            }
+
+            /// @brief Starts a job.
+            /// If the deque of the thread is full, the job runs right away on the calling thread.
+            /// So does it on a thread other than the workers, when four such threads already
+            /// have jobs in flight.
+            void run( function fn, void* context );
+
+            /// @brief Starts a job that calls \p fn().
+            /// The callable must stay alive until \p wait returns.
+            template<typename Function>
+            void run( Function& fn )
+            {
+                run( []( void* context ) { ( *static_cast<Function*>( context ) )(); }, &fn );
+            }
+
+            /// @brief Waits for the jobs of the group.
+            /// The calling thread runs the jobs of its own deque and steals others' meanwhile.
+            void wait();
+
+        private:
+            friend class impl::jobs::scheduler;
+
+            atomic<size_t> m_pending;
+        };
+
+        /// @brief Calls \p fn(first, last) for the subranges of [begin, end) of \p grain items,
+        /// the last one may be shorter, on all threads of the pool. Returns when all subranges are
+        /// done.
+        /// @note Threads take the subranges from a shared counter one by one, so a slow subrange
+        /// does not hold up the others. The grain should be large enough to amortize an atomic
+        /// increment, e.g. several screen rows.
+        template<typename Function>
+        void parallel_for( size_t begin, size_t end, size_t grain, const Function& fn )
+        {
+            if ( begin >= end )
+                return;
+
+            if ( grain == 0 )
+                grain = 1;
+
+            struct range
+            {
+                const Function* fn;
+                size_t          begin;
+                size_t          size;
+                size_t          grain;
+                atomic<size_t>  next;
+
+                static void run( void* context )
+                {
+                    range& self = *static_cast<range*>( context );
+
+                    for ( ;; )
+                    {
+                        const size_t offset = self.next.fetch_add( self.grain );
+                        if ( offset >= self.size )
+                            break;
+
+                        const size_t first = self.begin + offset;
+                        ( *self.fn )( first, first + rtl::min( self.grain, self.size - offset ) );
+                    }
+                }
+            };
+
+            const size_t size = end - begin;
+            range        work{ &fn, begin, size, grain, 0 };
+
+            const size_t chunks = size / grain + ( size % grain != 0 );
+            const size_t helpers = rtl::min( chunks, thread_count() ) - 1;
+
+            task_group group;
+
+            for ( size_t i = 0; i < helpers; ++i )
+                group.run( &range::run, &work );
+
+            range::run( &work );
+            group.wait();
+        }
+    } // namespace jobs
+} // namespace rtl
+
+#endif
@@ -13,15 +13,15 @@
 #if RTL_ENABLE_OPENCL
 
     #include <rtl/memory.hpp>
+    #include <rtl/small_vector.hpp>
     #include <rtl/string.hpp>
-    #include <rtl/vector.hpp>
 
 namespace rtl
 {
     namespace opencl
     {
         class platform;
-        using platform_list = rtl::vector<platform>;
+        using platform_list = rtl::small_vector<platform, 4>;
 
         class platform final
         {
@@ -44,7 +44,7 @@ namespace rtl
         };
 
         class device;
-        using device_list = rtl::vector<device>;
+        using device_list = rtl::small_vector<device, 4>;
 
         class device final
         {
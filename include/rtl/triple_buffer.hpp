@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/atomic.hpp>
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+
+namespace rtl
+{
+    // Lock-free exchange of the latest value between one writer thread and one reader thread.
+    // The writer fills \write_buffer and calls \publish, the reader calls \update and reads
+    // \read_buffer. Neither side ever waits for the other.
+    //
+    // NOTE: It is a double buffer with a spare slot. The writer and the reader each own one
+    // buffer, the third one is swapped by an atomic exchange, so the writer can publish while
+    // the reader still holds the previous value. Of the values published between two \update
+    // calls the reader gets only the last one.
+    template<typename T>
+    class triple_buffer final
+    {
+    public:
+        constexpr triple_buffer()
+            : m_writer{ 0 }
+            , m_middle{ 1 }
+            , m_reader{ 2 }
+            , m_buffers{}
+        {
+        }
+
+        triple_buffer( const triple_buffer& ) = delete;
+        triple_buffer& operator=( const triple_buffer& ) = delete;
+
+        // NOTE: The content is undefined until the writer fills it, it is not the last
+        // published value
+        [[nodiscard]] T& write_buffer()
+        {
+            return m_buffers[m_writer.index].value;
+        }
+
+        // Makes the content of \write_buffer the latest value
+        void publish()
+        {
+            m_writer.index
+                = m_middle.index.exchange( m_writer.index | fresh_flag, memory_order_acq_rel )
+                  & index_mask;
+        }
+
+        // Takes the latest published value, returns false if there is no new one
+        bool update()
+        {
+            if ( ( m_middle.index.load( memory_order_relaxed ) & fresh_flag ) == 0 )
+                return false;
+
+            m_reader.index
+                = m_middle.index.exchange( m_reader.index, memory_order_acq_rel ) & index_mask;
+            return true;
+        }
+
+        [[nodiscard]] const T& read_buffer() const
+        {
+            return m_buffers[m_reader.index].value;
+        }
+
+    private:
+        static constexpr size_t index_mask = 3;
+        static constexpr size_t fresh_flag = 4;
+
+        struct alignas( hardware_destructive_interference_size ) side
+        {
+            size_t index;
+        };
+
+        struct alignas( hardware_destructive_interference_size ) shared_side
+        {
+            atomic<size_t> index;
+        };
+
+        struct alignas( hardware_destructive_interference_size ) slot
+        {
+            T value;
+        };
+
+        side        m_writer;
+        shared_side m_middle;
+        side        m_reader;
+        slot        m_buffers[3];
+    };
+} // namespace rtl
@@ -71,6 +71,16 @@ namespace rtl
     {
     };
 
+    template<typename T>
+    struct is_volatile : false_type
+    {
+    };
+
+    template<typename T>
+    struct is_volatile<volatile T> : true_type
+    {
+    };
+
     template<typename T>
     struct is_reference : false_type
     {
@@ -86,6 +96,21 @@ namespace rtl
     {
     };
 
+    template<typename T>
+    struct is_pointer : false_type
+    {
+    };
+
+    template<typename T>
+    struct is_pointer<T*> : true_type
+    {
+    };
+
+    template<typename T>
+    struct is_pointer<T* const> : true_type
+    {
+    };
+
     template<typename T>
     struct is_function
         : integral_constant<bool, !is_const<const T>::value && !is_reference<T>::value>
@@ -215,6 +240,97 @@ namespace rtl
     {
     };
 
+    namespace impl
+    {
+        template<typename T>
+        struct is_integral : false_type
+        {
+        };
+
+        template<typename T>
+        struct make_unsigned
+        {
+        };
+
+#define RTL_INTEGRAL_TYPE( Signed, Unsigned )                                                      \
+        template<>                                                                                 \
+        struct is_integral<Signed> : true_type                                                     \
+        {                                                                                          \
+        };                                                                                         \
+        template<>                                                                                 \
+        struct is_integral<Unsigned> : true_type                                                   \
+        {                                                                                          \
+        };                                                                                         \
+        template<>                                                                                 \
+        struct make_unsigned<Signed>                                                               \
+        {                                                                                          \
+            using type = Unsigned;                                                                 \
+        };                                                                                         \
+        template<>                                                                                 \
+        struct make_unsigned<Unsigned>                                                             \
+        {                                                                                          \
+            using type = Unsigned;                                                                 \
+        };
+
+        RTL_INTEGRAL_TYPE( signed char, unsigned char )
+        RTL_INTEGRAL_TYPE( short, unsigned short )
+        RTL_INTEGRAL_TYPE( int, unsigned int )
+        RTL_INTEGRAL_TYPE( long, unsigned long )
+        RTL_INTEGRAL_TYPE( long long, unsigned long long )
+
+#undef RTL_INTEGRAL_TYPE
+
+        template<>
+        struct is_integral<char> : true_type
+        {
+        };
+
+        template<>
+        struct is_integral<wchar_t> : true_type
+        {
+        };
+
+        template<>
+        struct is_integral<bool> : true_type
+        {
+        };
+
+        template<>
+        struct make_unsigned<char>
+        {
+            using type = unsigned char;
+        };
+    } // namespace impl
+
+    template<typename T>
+    struct is_integral : impl::is_integral<typename remove_cv<T>::type>
+    {
+    };
+
+    namespace impl
+    {
+        template<typename T, bool Arithmetic>
+        struct is_signed : false_type
+        {
+        };
+
+        template<typename T>
+        struct is_signed<T, true> : integral_constant<bool, T( -1 ) < T( 0 )>
+        {
+        };
+    } // namespace impl
+
+    template<typename T>
+    struct is_signed
+        : impl::is_signed<T, is_integral<T>::value || is_floating_point<T>::value>
+    {
+    };
+
+    template<typename T>
+    struct make_unsigned : impl::make_unsigned<typename remove_cv<T>::type>
+    {
+    };
+
     // Applies conversions to the type T and removes cv-qualifiers:
     // - lvalue-to-rvalue;
     // - array-to-pointer;
@@ -307,4 +423,32 @@ namespace rtl
     {
     };
 
+    template<typename T>
+    struct is_empty : integral_constant<bool, __is_empty( T )>
+    {
+    };
+
+    template<typename T>
+    struct is_trivially_copyable : integral_constant<bool, __is_trivially_copyable( T )>
+    {
+    };
+
+    // NOTE: Clang deprecates __has_trivial_destructor, GCC 12 doesn't have the newer builtin
+#if defined( __GNUC__ ) && !defined( __clang__ )
+    template<typename T>
+    struct is_trivially_destructible : integral_constant<bool, __has_trivial_destructor( T )>
+    {
+    };
+#else
+    template<typename T>
+    struct is_trivially_destructible : integral_constant<bool, __is_trivially_destructible( T )>
+    {
+    };
+#endif
+
+    // NOTE: Lets constexpr functions take the faster non-constexpr path (e.g. memcpy) at runtime
+    [[nodiscard]] constexpr bool is_constant_evaluated() noexcept
+    {
+        return __builtin_is_constant_evaluated();
+    }
 } // namespace rtl
@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/charconv.hpp>
+#include <rtl/int.hpp>
+#include <rtl/type_traits.hpp>
+
+#if defined( _M_IX86 ) || defined( _M_X64 ) || defined( __SSE2__ )
+    #define RTL_UTF_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define RTL_UTF_SSE2 0
+#endif
+
+namespace rtl
+{
+    // NOTE: \in points to the first code unit, that is not converted: the start of a malformed
+    // sequence (invalid_argument) or of a code point, that does not fit the output
+    // (value_too_large).
+    template<typename In, typename Out>
+    struct transcode_result
+    {
+        const In* in;
+        Out*      out;
+        errc      ec;
+    };
+
+    template<typename In>
+    struct transcode_length_result
+    {
+        const In* in;
+        size_t    length;
+        errc      ec;
+    };
+
+    namespace impl
+    {
+        namespace utf
+        {
+            [[nodiscard]] constexpr bool is_continuation( uint32_t byte )
+            {
+                return ( byte & 0xC0 ) == 0x80;
+            }
+
+            // Decodes the UTF-8 sequence at \first. Returns its length or 0, if it is truncated,
+            // overlong, encodes a surrogate or a code point above U+10FFFF.
+            [[nodiscard]] constexpr int
+            decode( const char* first, const char* last, uint32_t* code_point )
+            {
+                const ptrdiff_t available = last - first;
+                const uint32_t  byte0 = static_cast<unsigned char>( first[0] );
+
+                if ( byte0 < 0x80 )
+                {
+                    *code_point = byte0;
+                    return 1;
+                }
+
+                if ( byte0 < 0xC2 )
+                    return 0;
+
+                if ( byte0 < 0xE0 )
+                {
+                    if ( available < 2 )
+                        return 0;
+
+                    const uint32_t byte1 = static_cast<unsigned char>( first[1] );
+                    if ( !is_continuation( byte1 ) )
+                        return 0;
+
+                    *code_point = ( ( byte0 & 0x1F ) << 6 ) | ( byte1 & 0x3F );
+                    return 2;
+                }
+
+                if ( byte0 < 0xF0 )
+                {
+                    if ( available < 3 )
+                        return 0;
+
+                    // NOTE: E0 is overlong below A0, ED encodes the surrogates above 9F
+                    const uint32_t byte1 = static_cast<unsigned char>( first[1] );
+                    const uint32_t byte2 = static_cast<unsigned char>( first[2] );
+                    const uint32_t low = byte0 == 0xE0 ? 0xA0 : 0x80;
+                    const uint32_t high = byte0 == 0xED ? 0x9F : 0xBF;
+
+                    if ( byte1 < low || byte1 > high || !is_continuation( byte2 ) )
+                        return 0;
+
+                    *code_point
+                        = ( ( byte0 & 0x0F ) << 12 ) | ( ( byte1 & 0x3F ) << 6 ) | ( byte2 & 0x3F );
+                    return 3;
+                }
+
+                if ( byte0 < 0xF5 )
+                {
+                    if ( available < 4 )
+                        return 0;
+
+                    // NOTE: F0 is overlong below 90, F4 is above U+10FFFF above 8F
+                    const uint32_t byte1 = static_cast<unsigned char>( first[1] );
+                    const uint32_t byte2 = static_cast<unsigned char>( first[2] );
+                    const uint32_t byte3 = static_cast<unsigned char>( first[3] );
+                    const uint32_t low = byte0 == 0xF0 ? 0x90 : 0x80;
+                    const uint32_t high = byte0 == 0xF4 ? 0x8F : 0xBF;
+
+                    if ( byte1 < low || byte1 > high || !is_continuation( byte2 )
+                         || !is_continuation( byte3 ) )
+                        return 0;
+
+                    *code_point = ( ( byte0 & 0x07 ) << 18 ) | ( ( byte1 & 0x3F ) << 12 )
+                                  | ( ( byte2 & 0x3F ) << 6 ) | ( byte3 & 0x3F );
+                    return 4;
+                }
+
+                return 0;
+            }
+
+            // Copies the ASCII prefix of \str, 16 characters per step, and returns its length.
+            // Without \Write the prefix is only measured.
+            template<bool Write, typename Char16>
+            [[nodiscard]] inline size_t
+            widen_ascii( const char* str, size_t size, Char16* out, size_t capacity )
+            {
+#if RTL_UTF_SSE2
+                const size_t limit = Write && capacity < size ? capacity : size;
+
+                size_t i = 0;
+                for ( ; i + 16 <= limit; i += 16 )
+                {
+                    const __m128i block
+                        = _mm_loadu_si128( reinterpret_cast<const __m128i*>( str + i ) );
+
+                    // NOTE: The non-ASCII bytes are the ones with the sign bit set
+                    unsigned mask = static_cast<unsigned>( _mm_movemask_epi8( block ) );
+                    if ( mask != 0 )
+                    {
+                        for ( ; ( mask & 1 ) == 0; mask >>= 1, ++i )
+                        {
+                            if constexpr ( Write )
+                                out[i] = static_cast<Char16>( str[i] );
+                        }
+
+                        return i;
+                    }
+
+                    if constexpr ( Write && sizeof( Char16 ) == 2 )
+                    {
+                        const __m128i zero = _mm_setzero_si128();
+
+                        _mm_storeu_si128( reinterpret_cast<__m128i*>( out + i ),
+                                          _mm_unpacklo_epi8( block, zero ) );
+                        _mm_storeu_si128( reinterpret_cast<__m128i*>( out + i + 8 ),
+                                          _mm_unpackhi_epi8( block, zero ) );
+                    }
+                    else if constexpr ( Write )
+                    {
+                        for ( size_t j = i; j < i + 16; ++j )
+                            out[j] = static_cast<Char16>( str[j] );
+                    }
+                }
+
+                return i;
+#else
+                (void)str;
+                (void)size;
+                (void)out;
+                (void)capacity;
+                return 0;
+#endif
+            }
+
+            // NOTE: The output of the size-only mode (without \Write) is only counted.
+            template<bool Write, typename Char16>
+            [[nodiscard]] constexpr errc from_utf8(
+                const char*& first, const char* last, Char16* out, size_t capacity, size_t& size )
+            {
+                size_t written = 0;
+
+                while ( first != last )
+                {
+                    // NOTE: Non-ASCII text does not pay for the block test on each code point
+                    if ( static_cast<unsigned char>( *first ) < 0x80
+                         && !rtl::is_constant_evaluated() )
+                    {
+                        const size_t count
+                            = widen_ascii<Write>( first,
+                                                  static_cast<size_t>( last - first ),
+                                                  Write ? out + written : out,
+                                                  capacity - written );
+                        first += count;
+                        written += count;
+
+                        if ( first == last )
+                            break;
+                    }
+
+                    uint32_t  code_point = 0;
+                    const int length = decode( first, last, &code_point );
+                    if ( length == 0 )
+                    {
+                        size = written;
+                        return errc::invalid_argument;
+                    }
+
+                    const size_t units = code_point >= 0x10000 ? 2 : 1;
+
+                    if constexpr ( Write )
+                    {
+                        if ( capacity - written < units )
+                        {
+                            size = written;
+                            return errc::value_too_large;
+                        }
+
+                        if ( units == 1 )
+                        {
+                            out[written] = static_cast<Char16>( code_point );
+                        }
+                        else
+                        {
+                            code_point -= 0x10000;
+                            out[written] = static_cast<Char16>( 0xD800 + ( code_point >> 10 ) );
+                            out[written + 1]
+                                = static_cast<Char16>( 0xDC00 + ( code_point & 0x3FF ) );
+                        }
+                    }
+
+                    written += units;
+                    first += length;
+                }
+
+                size = written;
+                return errc::ok;
+            }
+
+            // Copies the ASCII prefix of \str, 16 code units per step, and returns its length.
+            // Without \Write the prefix is only measured.
+            template<bool Write, typename Char16>
+            [[nodiscard]] inline size_t
+            narrow_ascii( const Char16* str, size_t size, char* out, size_t capacity )
+            {
+#if RTL_UTF_SSE2
+                if constexpr ( sizeof( Char16 ) == 2 )
+                {
+                    const size_t  limit = Write && capacity < size ? capacity : size;
+                    const __m128i zero = _mm_setzero_si128();
+                    const __m128i non_ascii = _mm_set1_epi16( static_cast<short>( 0xFF80 ) );
+
+                    size_t i = 0;
+                    for ( ; i + 16 <= limit; i += 16 )
+                    {
+                        const __m128i low
+                            = _mm_loadu_si128( reinterpret_cast<const __m128i*>( str + i ) );
+                        const __m128i high
+                            = _mm_loadu_si128( reinterpret_cast<const __m128i*>( str + i + 8 ) );
+
+                        const __m128i bits = _mm_and_si128( _mm_or_si128( low, high ), non_ascii );
+                        if ( _mm_movemask_epi8( _mm_cmpeq_epi16( bits, zero ) ) != 0xFFFF )
+                            break;
+
+                        if constexpr ( Write )
+                            _mm_storeu_si128( reinterpret_cast<__m128i*>( out + i ),
+                                              _mm_packus_epi16( low, high ) );
+                    }
+
+                    return i;
+                }
+                else
+#endif
+                {
+                    (void)str;
+                    (void)size;
+                    (void)out;
+                    (void)capacity;
+                    return 0;
+                }
+            }
+
+            // NOTE: The output of the size-only mode (without \Write) is only counted.
+            template<bool Write, typename Char16>
+            [[nodiscard]] constexpr errc to_utf8(
+                const Char16*& first, const Char16* last, char* out, size_t capacity, size_t& size )
+            {
+                size_t written = 0;
+
+                while ( first != last )
+                {
+                    if ( static_cast<uint32_t>( *first ) < 0x80 && !rtl::is_constant_evaluated() )
+                    {
+                        const size_t count
+                            = narrow_ascii<Write>( first,
+                                                   static_cast<size_t>( last - first ),
+                                                   Write ? out + written : out,
+                                                   capacity - written );
+                        first += count;
+                        written += count;
+
+                        if ( first == last )
+                            break;
+                    }
+
+                    uint32_t code_point = static_cast<uint32_t>( first[0] );
+                    int      length = 1;
+
+                    if ( code_point >= 0xD800 && code_point < 0xDC00 && last - first >= 2 )
+                    {
+                        const auto low = static_cast<uint32_t>( first[1] );
+                        if ( low >= 0xDC00 && low < 0xE000 )
+                        {
+                            code_point = 0x10000 + ( ( code_point - 0xD800 ) << 10 )
+                                         + ( low - 0xDC00 );
+                            length = 2;
+                        }
+                    }
+
+                    // NOTE: Unpaired surrogates and, for a 32-bit \Char16, values beyond 16 bits
+                    if ( ( length == 1 && code_point >= 0xD800 && code_point < 0xE000 )
+                         || code_point > 0x10FFFF )
+                    {
+                        size = written;
+                        return errc::invalid_argument;
+                    }
+
+                    size_t units = 4;
+                    if ( code_point < 0x80 )
+                        units = 1;
+                    else if ( code_point < 0x800 )
+                        units = 2;
+                    else if ( code_point < 0x10000 )
+                        units = 3;
+
+                    if constexpr ( Write )
+                    {
+                        if ( capacity - written < units )
+                        {
+                            size = written;
+                            return errc::value_too_large;
+                        }
+
+                        char* ptr = out + written;
+
+                        if ( units == 1 )
+                        {
+                            ptr[0] = static_cast<char>( code_point );
+                        }
+                        else if ( units == 2 )
+                        {
+                            ptr[0] = static_cast<char>( 0xC0 | ( code_point >> 6 ) );
+                            ptr[1] = static_cast<char>( 0x80 | ( code_point & 0x3F ) );
+                        }
+                        else if ( units == 3 )
+                        {
+                            ptr[0] = static_cast<char>( 0xE0 | ( code_point >> 12 ) );
+                            ptr[1] = static_cast<char>( 0x80 | ( ( code_point >> 6 ) & 0x3F ) );
+                            ptr[2] = static_cast<char>( 0x80 | ( code_point & 0x3F ) );
+                        }
+                        else
+                        {
+                            ptr[0] = static_cast<char>( 0xF0 | ( code_point >> 18 ) );
+                            ptr[1] = static_cast<char>( 0x80 | ( ( code_point >> 12 ) & 0x3F ) );
+                            ptr[2] = static_cast<char>( 0x80 | ( ( code_point >> 6 ) & 0x3F ) );
+                            ptr[3] = static_cast<char>( 0x80 | ( code_point & 0x3F ) );
+                        }
+                    }
+
+                    written += units;
+                    first += length;
+                }
+
+                size = written;
+                return errc::ok;
+            }
+        } // namespace utf
+    }     // namespace impl
+
+    // Converts UTF-8 into UTF-16 without a terminating null character. \Char16 is a 16-bit
+    // wchar_t on Windows, or char16_t. Malformed input is rejected, not replaced.
+    template<typename Char16>
+    [[nodiscard]] constexpr transcode_result<char, Char16>
+    utf8_to_utf16( const char* first, const char* last, Char16* out, Char16* out_last )
+    {
+        size_t     size = 0;
+        const errc ec = impl::utf::from_utf8<true>(
+            first, last, out, static_cast<size_t>( out_last - out ), size );
+
+        return { first, out + size, ec };
+    }
+
+    // Converts UTF-16 into UTF-8 without a terminating null character. Unpaired surrogates are
+    // rejected, not replaced.
+    template<typename Char16>
+    [[nodiscard]] constexpr transcode_result<Char16, char>
+    utf16_to_utf8( const Char16* first, const Char16* last, char* out, char* out_last )
+    {
+        size_t     size = 0;
+        const errc ec = impl::utf::to_utf8<true>(
+            first, last, out, static_cast<size_t>( out_last - out ), size );
+
+        return { first, out + size, ec };
+    }
+
+    // Validates UTF-8 and returns the number of UTF-16 code units, that utf8_to_utf16 writes for
+    // it, so that the output can be allocated exactly once.
+    [[nodiscard]] constexpr transcode_length_result<char> utf16_length( const char* first,
+                                                                        const char* last )
+    {
+        size_t     length = 0;
+        const errc ec = impl::utf::from_utf8<false>(
+            first, last, static_cast<char16_t*>( nullptr ), 0, length );
+
+        return { first, length, ec };
+    }
+
+    // Validates UTF-16 and returns the number of bytes, that utf16_to_utf8 writes for it.
+    template<typename Char16>
+    [[nodiscard]] constexpr transcode_length_result<Char16> utf8_length( const Char16* first,
+                                                                         const Char16* last )
+    {
+        size_t     length = 0;
+        const errc ec = impl::utf::to_utf8<false>(
+            first, last, static_cast<char*>( nullptr ), 0, length );
+
+        return { first, length, ec };
+    }
+} // namespace rtl
@@ -11,85 +11,113 @@
 #pragma once
 
 #include <rtl/algorithm.hpp>
+#include <rtl/allocator.hpp>
+#include <rtl/limits.hpp>
 #include <rtl/memory.hpp>
 
 namespace rtl
 {
-    template<typename T>
-    class vector final
+    template<typename T, typename Allocator = rtl::allocator<T>>
+    class vector final : private impl::allocator_holder<Allocator>
     {
     public:
-        typedef T element_type;
+        typedef T         element_type;
+        typedef Allocator allocator_type;
+
+        static_assert( is_same<typename Allocator::value_type, T>::value,
+                       "allocator value type mismatch" );
 
         constexpr vector()
-            : m_size( 0 )
+            : vector( Allocator() )
+        {
+        }
+
+        constexpr explicit vector( const Allocator& allocator )
+            : impl::allocator_holder<Allocator>( allocator )
+            , m_size( 0 )
             , m_capacity( default_capacity )
-            // TODO: just allocate, do not construct?
-            , m_data( new element_type[default_capacity] )
+            , m_data( allocate( default_capacity ) )
+        {
+        }
+
+        constexpr vector( size_t size, element_type&& value, const Allocator& allocator = Allocator() )
+            : impl::allocator_holder<Allocator>( allocator )
+            , m_size( size )
+            , m_capacity( rtl::max( size, default_capacity ) ) // TODO: do align?
+            , m_data( allocate( m_capacity ) )
         {
+            rtl::uninitialized_fill_n( m_data, m_size, value );
         }
 
-        constexpr vector( size_t size, element_type&& value )
-            : m_size( size )
+        constexpr explicit vector( size_t size, const Allocator& allocator = Allocator() )
+            : impl::allocator_holder<Allocator>( allocator )
+            , m_size( size )
             , m_capacity( rtl::max( size, default_capacity ) ) // TODO: do align?
-            // TODO: just allocate, do not construct?
-            , m_data( new element_type[m_capacity] )
+            , m_data( allocate( m_capacity ) )
         {
-            rtl::fill_n( m_data, m_size, value );
+            rtl::uninitialized_value_construct_n( m_data, m_size );
         }
 
-        constexpr explicit vector( size_t size )
-            : m_size( size )
+        // NOTE: Elements of trivial types are left uninitialized
+        constexpr vector( size_t size, default_init_t, const Allocator& allocator = Allocator() )
+            : impl::allocator_holder<Allocator>( allocator )
+            , m_size( size )
             , m_capacity( rtl::max( size, default_capacity ) ) // TODO: do align?
-            // TODO: just allocate, do not construct?
-            , m_data( new element_type[m_capacity] )
+            , m_data( allocate( m_capacity ) )
         {
-            rtl::fill_n( m_data, m_size, element_type() );
+            rtl::uninitialized_default_construct_n( m_data, m_size );
         }
 
         ~vector()
         {
-            delete[] m_data;
+            rtl::destroy_n( m_data, m_size );
+            deallocate( m_data, m_capacity );
         }
 
         constexpr vector( const vector& that )
-            : vector()
+            : impl::allocator_holder<Allocator>( that )
+            , m_size( that.m_size )
+            , m_capacity( rtl::max( that.m_size, default_capacity ) )
+            , m_data( allocate( m_capacity ) )
         {
-            *this = that;
+            rtl::uninitialized_copy_n( that.m_data, that.m_size, m_data );
         }
 
         constexpr vector& operator=( const vector& that )
         {
             if ( this != &that )
             {
-                if ( m_size != that.m_size )
-                {
-                    m_size = that.m_size;
-                    m_capacity = that.m_capacity;
-
-                    // TODO: just allocate, do not construct?
-                    element_type* new_data = new element_type[that.m_capacity];
-                    delete[] m_data;
-                    m_data = new_data;
-                }
-
-                rtl::copy_n( that.m_data, that.m_size, m_data );
+                clear();
+
+                if ( m_capacity < that.m_size )
+                    reallocate( that.m_size );
+
+                rtl::uninitialized_copy_n( that.m_data, that.m_size, m_data );
+                m_size = that.m_size;
             }
 
             return *this;
         }
 
         constexpr vector( vector&& that )
-            : vector()
+            : impl::allocator_holder<Allocator>( that )
+            , m_size( that.m_size )
+            , m_capacity( that.m_capacity )
+            , m_data( that.m_data )
         {
-            *this = rtl::move( that );
+            that.m_capacity = 0;
+            that.m_size = 0;
+            that.m_data = nullptr;
         }
 
         constexpr vector& operator=( vector&& that )
         {
             if ( this != &that )
             {
-                delete[] m_data;
+                rtl::destroy_n( m_data, m_size );
+                deallocate( m_data, m_capacity );
+
+                this->replace_allocator( that );
 
                 m_size = that.m_size;
                 m_capacity = that.m_capacity;
@@ -178,70 +206,131 @@ namespace rtl
             return m_size == 0;
         }
 
-        // TODO: add const reference overload
+        [[nodiscard]] constexpr allocator_type get_allocator() const
+        {
+            return this->allocator_ref();
+        }
+
         constexpr void push_back( element_type&& element )
         {
-            if ( m_size + 1 > m_capacity )
-            {
-                if ( rtl::numeric_limits<size_t>::max() - m_capacity < m_capacity )
-                    m_capacity = rtl::numeric_limits<size_t>::max(); // TODO: do align?
-                else
-                    m_capacity = m_capacity * 2;
+            emplace_back( rtl::move( element ) );
+        }
+
+        constexpr void push_back( const element_type& element )
+        {
+            emplace_back( element );
+        }
+
+        template<typename... Args>
+        constexpr element_type& emplace_back( Args&&... args )
+        {
+            if ( m_size < m_capacity )
+                return *rtl::construct_at( m_data + m_size++, rtl::forward<Args>( args )... );
 
-                // TODO: just allocate, do not construct?
-                element_type* new_data = new element_type[m_capacity];
+            // NOTE: The new element is constructed before relocation, because \args may refer
+            // to the elements of this vector
+            const size_t  capacity = grown_capacity();
+            element_type* new_data = allocate( capacity );
+            element_type* element
+                = rtl::construct_at( new_data + m_size, rtl::forward<Args>( args )... );
 
-                rtl::move_n( m_data, m_size, new_data );
-                delete[] m_data;
+            impl::relocate_n( m_data, m_size, new_data );
+            deallocate( m_data, m_capacity );
 
-                m_data = new_data;
-            }
+            m_data = new_data;
+            m_capacity = capacity;
+            ++m_size;
 
-            m_data[m_size++] = rtl::move( element );
+            return *element;
+        }
+
+        constexpr void pop_back()
+        {
+            rtl::destroy_at( m_data + --m_size );
+        }
+
+        constexpr void clear()
+        {
+            rtl::destroy_n( m_data, m_size );
+            m_size = 0;
         }
 
         constexpr void resize( size_t size )
         {
-            if ( m_size != size )
+            if ( size > m_size )
             {
                 if ( size > m_capacity )
-                {
-                    m_capacity = size; // TODO: do align?
-
-                    // TODO: just allocate, do not construct?
-                    element_type* extended = new element_type[size];
+                    reallocate( size ); // TODO: do align?
 
-                    rtl::move_n( m_data, m_size, extended );
-                    delete[] m_data;
+                rtl::uninitialized_value_construct_n( m_data + m_size, size - m_size );
+            }
+            else
+            {
+                rtl::destroy_n( m_data + size, m_size - size );
+            }
 
-                    m_data = extended;
-                }
+            m_size = size;
+        }
 
-                if ( size > m_size )
-                    rtl::fill_n( m_data + m_size, size - m_size, element_type() );
+        // NOTE: New elements of trivial types are left uninitialized
+        constexpr void resize( size_t size, default_init_t )
+        {
+            if ( size > m_size )
+            {
+                if ( size > m_capacity )
+                    reallocate( size ); // TODO: do align?
 
-                m_size = size;
+                rtl::uninitialized_default_construct_n( m_data + m_size, size - m_size );
             }
+            else
+            {
+                rtl::destroy_n( m_data + size, m_size - size );
+            }
+
+            m_size = size;
         }
 
         constexpr void reserve( size_t capacity )
         {
             if ( m_capacity < capacity )
-            {
-                m_capacity = capacity; // TODO: do align?
+                reallocate( capacity ); // TODO: do align?
+        }
 
-                // TODO: just allocate, do not construct?
-                element_type* extended = new element_type[capacity];
+    private:
+        static constexpr size_t default_capacity = 8;
 
-                rtl::move_n( m_data, m_size, extended );
-                delete[] m_data;
+        [[nodiscard]] constexpr element_type* allocate( size_t count ) const
+        {
+            return this->allocator_ref().allocate( count );
+        }
 
-                m_data = extended;
-            }
+        constexpr void deallocate( element_type* data, size_t count ) const
+        {
+            if ( data )
+                this->allocator_ref().deallocate( data, count );
         }
 
-    private:
-        static constexpr size_t default_capacity = 8;
+        [[nodiscard]] constexpr size_t grown_capacity() const
+        {
+            if ( m_capacity == 0 )
+                return default_capacity;
+
+            if ( rtl::numeric_limits<size_t>::max() - m_capacity < m_capacity )
+                return rtl::numeric_limits<size_t>::max(); // TODO: do align?
+
+            return m_capacity * 2;
+        }
+
+        constexpr void reallocate( size_t capacity )
+        {
+            element_type* new_data = allocate( capacity );
+
+            impl::relocate_n( m_data, m_size, new_data );
+            deallocate( m_data, m_capacity );
+
+            m_data = new_data;
+            m_capacity = capacity;
+        }
 
         size_t        m_size{ 0 };
         size_t        m_capacity{ 0 };
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2016-2023 Konstantin Polevik
+ * All rights reserved
+ *
+ * This file is part of the RTL library. Redistribution and use in source and
+ * binary forms, with or without modification, are permitted exclusively
+ * under the terms of the MIT license. You should have received a copy of the
+ * license with this file. If not, please visit:
+ * https://github.com/out61h/rtl/blob/main/LICENSE.
+ */
+#pragma once
+
+#include <rtl/int.hpp>
+#include <rtl/memory.hpp>
+
+namespace rtl
+{
+    // Encoder of the RIFF WAVE files with a single data chunk.
+    //
+    // NOTE: PCM uses the canonical 44-byte header. The float format is not PCM, so its format
+    // chunk has the 18-byte layout with an empty extension, followed by a fact chunk with the
+    // number of sample frames.
+    namespace wav
+    {
+        enum class format
+        {
+            pcm16,
+            float32
+        };
+
+        constexpr size_t max_header_size = 58;
+
+        [[nodiscard]] constexpr size_t header_size( format fmt )
+        {
+            return fmt == format::float32 ? max_header_size : 44;
+        }
+
+        [[nodiscard]] constexpr size_t sample_size( format fmt )
+        {
+            return fmt == format::float32 ? 4 : 2;
+        }
+
+        namespace impl
+        {
+            inline uint8_t* put_tag( uint8_t* out, const char* tag )
+            {
+                for ( size_t i = 0; i < 4; ++i )
+                    *out++ = static_cast<uint8_t>( tag[i] );
+
+                return out;
+            }
+
+            inline uint8_t* put_u16( uint8_t* out, uint32_t value )
+            {
+                *out++ = static_cast<uint8_t>( value );
+                *out++ = static_cast<uint8_t>( value >> 8u );
+                return out;
+            }
+
+            inline uint8_t* put_u32( uint8_t* out, uint32_t value )
+            {
+                out = put_u16( out, value & 0xffffu );
+                return put_u16( out, value >> 16u );
+            }
+        } // namespace impl
+
+        // Writes \header_size bytes of the header for \data_size bytes of the samples
+        inline void write_header( uint8_t* out,
+                                  format   fmt,
+                                  unsigned channels,
+                                  unsigned samples_per_second,
+                                  uint32_t data_size )
+        {
+            constexpr uint32_t format_pcm = 1;
+            constexpr uint32_t format_ieee_float = 3;
+
+            const bool     extended = fmt != format::pcm16;
+            const uint32_t block_align = static_cast<uint32_t>( channels * sample_size( fmt ) );
+
+            out = impl::put_tag( out, "RIFF" );
+            out = impl::put_u32( out, static_cast<uint32_t>( header_size( fmt ) - 8 ) + data_size );
+            out = impl::put_tag( out, "WAVE" );
+
+            out = impl::put_tag( out, "fmt " );
+            out = impl::put_u32( out, extended ? 18 : 16 );
+            out = impl::put_u16( out, extended ? format_ieee_float : format_pcm );
+            out = impl::put_u16( out, channels );
+            out = impl::put_u32( out, samples_per_second );
+            out = impl::put_u32( out, samples_per_second * block_align );
+            out = impl::put_u16( out, block_align );
+            out = impl::put_u16( out, static_cast<uint32_t>( sample_size( fmt ) * 8 ) );
+
+            if ( extended )
+            {
+                // NOTE: No extension bytes
+                out = impl::put_u16( out, 0 );
+
+                out = impl::put_tag( out, "fact" );
+                out = impl::put_u32( out, 4 );
+                out = impl::put_u32( out, data_size / block_align );
+            }
+
+            out = impl::put_tag( out, "data" );
+            impl::put_u32( out, data_size );
+        }
+
+        // Converts \count samples, writes \count * \sample_size bytes
+        inline void encode( const int16_t* samples, size_t count, format fmt, uint8_t* out )
+        {
+            if ( fmt == format::float32 )
+            {
+                for ( size_t i = 0; i < count; ++i )
+                {
+                    const float value = static_cast<float>( samples[i] ) * ( 1.f / 32768.f );
+
+                    uint32_t bits = 0;
+                    memcpy( &bits, &value, sizeof( bits ) );
+
+                    out = impl::put_u32( out, bits );
+                }
+            }
+            else
+            {
+                for ( size_t i = 0; i < count; ++i )
+                    out = impl::put_u16( out, static_cast<uint16_t>( samples[i] ) );
+            }
+        }
+    } // namespace wav
+} // namespace rtl